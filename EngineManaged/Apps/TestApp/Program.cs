@@ -1 +1,46 @@
-﻿Console.WriteLine("Hello World!");
\ No newline at end of file
+﻿using System.Diagnostics;
+using Lumi.Sys;
+
+var windowManager = new WindowManager();
+var window = windowManager.CreateWindow(new WindowProperties
+{
+    title = "Test Window",
+    icon = "Assets/icon.bmp",
+    x = Window.GetWindowPosCentered(),
+    y = Window.GetWindowPosCentered(),
+    w = 800,
+    h = 600,
+    wMin = 800,
+    wMax = 1600,
+    hMin = 600,
+    hMax = 1200,
+    mode = WindowMode.Windowed,
+    resizable = true,
+    bordered = true
+});
+
+var frameStats = new FrameStats([120, 1000]);
+var frameTimer = Stopwatch.StartNew();
+ulong frame = 0;
+
+while (!window.Closing())
+{
+    windowManager.Update();
+
+    frameStats.Record(new FrameSample { frame = (float)frameTimer.Elapsed.TotalMilliseconds });
+    frameTimer.Restart();
+
+    // Report every couple of seconds at 60fps
+    if (++frame % 120 == 0)
+    {
+        foreach (var snapshot in frameStats.GetSnapshots())
+        {
+            var times = snapshot.Get(FrameMetric.Frame);
+            Console.WriteLine($"Last {times.count} frames: p50 {times.p50:F2}ms p95 {times.p95:F2}ms p99 {times.p99:F2}ms max {times.max:F2}ms");
+        }
+    }
+}
+
+frameStats.Delete();
+window.Delete();
+windowManager.Delete();
\ No newline at end of file
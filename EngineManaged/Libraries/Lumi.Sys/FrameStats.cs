@@ -0,0 +1,98 @@
+namespace Lumi.Sys;
+
+/// <summary>
+/// Rolling frame time percentiles kept by the engine.
+/// Samples are buffered and handed to the engine in batches, and one call reads the percentiles of every window.
+/// </summary>
+public class FrameStats
+{
+    private IntPtr _nativeHandle;
+    private readonly FrameSample[] _pending;
+    private int _pendingCount;
+
+    public FrameStats(uint[]? windows = null, int batchSize = 64)
+    {
+        unsafe
+        {
+            fixed (uint* ptr = windows)
+            {
+                _nativeHandle = FrameStatsNative.Create(ptr, (uint)(windows?.Length ?? 0));
+            }
+        }
+        _pending = new FrameSample[Math.Max(batchSize, 1)];
+    }
+
+    public void Record(FrameSample sample)
+    {
+        if (_nativeHandle == IntPtr.Zero)
+        {
+            return;
+        }
+
+        _pending[_pendingCount++] = sample;
+        if (_pendingCount == _pending.Length)
+        {
+            Flush();
+        }
+    }
+
+    /// <summary>Hands every buffered sample to the engine.</summary>
+    public void Flush()
+    {
+        if (_pendingCount == 0 || _nativeHandle == IntPtr.Zero)
+        {
+            return;
+        }
+
+        unsafe
+        {
+            fixed (FrameSample* ptr = _pending)
+            {
+                FrameStatsNative.Record(_nativeHandle, ptr, (uint)_pendingCount);
+            }
+        }
+        _pendingCount = 0;
+    }
+
+    /// <summary>Flushes buffered samples and returns the percentiles of every window, none once deleted.</summary>
+    public FrameStatsSnapshot[] GetSnapshots()
+    {
+        if (_nativeHandle == IntPtr.Zero)
+        {
+            return Array.Empty<FrameStatsSnapshot>();
+        }
+
+        Flush();
+
+        Span<FrameStatsSnapshot> snapshots = stackalloc FrameStatsSnapshot[FrameStatsNative.MaxWindows];
+        uint count;
+        unsafe
+        {
+            fixed (FrameStatsSnapshot* ptr = snapshots)
+            {
+                count = FrameStatsNative.Snapshot(_nativeHandle, ptr, (uint)snapshots.Length);
+            }
+        }
+        return snapshots[..(int)count].ToArray();
+    }
+
+    /// <summary>Counts the samples recorded so far, including buffered ones, 0 once deleted.</summary>
+    public ulong GetRecordedCount()
+    {
+        if (_nativeHandle == IntPtr.Zero)
+        {
+            return 0;
+        }
+        return FrameStatsNative.RecordedCount(_nativeHandle) + (ulong)_pendingCount;
+    }
+
+    public void Delete()
+    {
+        if (_nativeHandle != IntPtr.Zero)
+        {
+            FrameStatsNative.Destroy(_nativeHandle);
+            _nativeHandle = IntPtr.Zero;
+        }
+        _pendingCount = 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace Lumi.Sys;
+
+/// <summary>Timings of one frame in milliseconds.</summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct FrameSample
+{
+    public float frame;
+    public float cpuRecord;
+    public float submit;
+    public float presentWait;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct FramePercentiles
+{
+    public float p50, p95, p99, max;
+    public uint count;
+}
+
+public enum FrameMetric
+{
+    Frame,
+    CpuRecord,
+    Submit,
+    PresentWait
+}
+
+[InlineArray(4)]
+public struct FrameMetricPercentiles
+{
+    private FramePercentiles _element;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct FrameStatsSnapshot
+{
+    public uint window;
+    public FrameMetricPercentiles metrics;
+
+    public readonly FramePercentiles Get(FrameMetric metric) => metrics[(int)metric];
+}
+
+internal static unsafe partial class FrameStatsNative
+{
+    internal const int MaxWindows = 4;
+
+    [LibraryImport("sysclib", EntryPoint = "frame_stats_create")]
+    internal static partial IntPtr Create(uint* windows, uint windowCount);
+
+    [LibraryImport("sysclib", EntryPoint = "frame_stats_record")]
+    internal static partial void Record(IntPtr stats, FrameSample* samples, uint count);
+
+    [LibraryImport("sysclib", EntryPoint = "frame_stats_snapshot")]
+    internal static partial uint Snapshot(IntPtr stats, FrameStatsSnapshot* snapshots, uint maxCount);
+
+    [LibraryImport("sysclib", EntryPoint = "frame_stats_recorded_count")]
+    internal static partial ulong RecordedCount(IntPtr stats);
+
+    [LibraryImport("sysclib", EntryPoint = "frame_stats_destroy")]
+    internal static partial void Destroy(IntPtr stats);
+}
\ No newline at end of file
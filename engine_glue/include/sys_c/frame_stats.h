@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdint.h>
+#include <utils/c_macros.h>
+#include "export.h"
+
+C_API_BEGIN
+
+C_API_OPAQUE_STRUCT(FrameStats);
+
+/* Timings of one frame in milliseconds */
+C_API_STRUCT FrameStatsSample {
+    float frame;
+    float cpuRecord;
+    float submit;
+    float presentWait;
+} FrameStatsSample;
+
+C_API_STRUCT FrameStatsPercentiles {
+    float p50, p95, p99, max;
+    uint32_t count;
+} FrameStatsPercentiles;
+
+/* Percentiles of every metric over one window, in the order of FrameStatsSample's fields */
+C_API_STRUCT FrameStatsSnapshot {
+    uint32_t window;
+    FrameStatsPercentiles metrics[4];
+} FrameStatsSnapshot;
+
+/* The functions taking stats do nothing, or return 0, when it's null */
+C_API_FUNC(SYS_C_API, FrameStats*, frame_stats_create, const uint32_t* windows, uint32_t windowCount);
+C_API_FUNC(SYS_C_API, void, frame_stats_record, FrameStats* stats, const FrameStatsSample* samples, uint32_t count);
+C_API_FUNC(SYS_C_API, uint32_t, frame_stats_snapshot, FrameStats* stats, FrameStatsSnapshot* out, uint32_t maxCount);
+C_API_FUNC(SYS_C_API, uint64_t, frame_stats_recorded_count, FrameStats* stats);
+C_API_FUNC(SYS_C_API, void, frame_stats_destroy, FrameStats* stats);
+
+C_API_END
\ No newline at end of file
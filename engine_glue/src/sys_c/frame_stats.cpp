@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <span>
+#include <sys_c/frame_stats.h>
+#include <sys/frame_stats.h>
+
+static_assert(sizeof(FrameStatsPercentiles) == sizeof(lumi::sys::FramePercentiles));
+static_assert(sizeof(FrameStatsSnapshot::metrics) / sizeof(FrameStatsPercentiles) == lumi::sys::kFrameMetricCount);
+
+namespace
+{
+    std::chrono::nanoseconds FromMilliseconds(const float ms)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<float, std::milli>(ms));
+    }
+}
+
+C_API_FUNC(SYS_C_API, FrameStats*, frame_stats_create, const uint32_t* windows, uint32_t windowCount)
+{
+    lumi::sys::FrameStats* stats = windows && windowCount > 0
+        ? new lumi::sys::FrameStats(std::span<const uint32_t>(windows, windowCount))
+        : new lumi::sys::FrameStats();
+    return reinterpret_cast<FrameStats*>(stats);
+}
+
+C_API_FUNC(SYS_C_API, void, frame_stats_record, FrameStats* stats, const FrameStatsSample* samples, uint32_t count)
+{
+    if (!stats || !samples)
+    {
+        return;
+    }
+
+    auto frameStats = reinterpret_cast<lumi::sys::FrameStats*>(stats);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        lumi::sys::FrameTimings timings;
+        timings.frame = FromMilliseconds(samples[i].frame);
+        timings.cpuRecord = FromMilliseconds(samples[i].cpuRecord);
+        timings.submit = FromMilliseconds(samples[i].submit);
+        timings.presentWait = FromMilliseconds(samples[i].presentWait);
+        frameStats->Record(timings);
+    }
+}
+
+C_API_FUNC(SYS_C_API, uint32_t, frame_stats_snapshot, FrameStats* stats, FrameStatsSnapshot* out, uint32_t maxCount)
+{
+    if (!stats || !out)
+    {
+        return 0;
+    }
+
+    auto frameStats = reinterpret_cast<lumi::sys::FrameStats*>(stats);
+
+    std::array<lumi::sys::FrameStatsSnapshot, lumi::sys::kMaxFrameStatsWindows> snapshots;
+    size_t count = frameStats->Snapshot(std::span(snapshots.data(), std::min<size_t>(maxCount, snapshots.size())));
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i].window = snapshots[i].window;
+        for (size_t metric = 0; metric < lumi::sys::kFrameMetricCount; ++metric)
+        {
+            const auto& percentiles = snapshots[i].metrics[metric];
+            out[i].metrics[metric] = { percentiles.p50, percentiles.p95, percentiles.p99, percentiles.max, percentiles.count };
+        }
+    }
+    return static_cast<uint32_t>(count);
+}
+
+C_API_FUNC(SYS_C_API, uint64_t, frame_stats_recorded_count, FrameStats* stats)
+{
+    if (!stats)
+    {
+        return 0;
+    }
+    return reinterpret_cast<lumi::sys::FrameStats*>(stats)->GetRecordedCount();
+}
+
+C_API_FUNC(SYS_C_API, void, frame_stats_destroy, FrameStats* stats)
+{
+    delete reinterpret_cast<lumi::sys::FrameStats*>(stats);
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <iostream>
+#include <debugging/binary_log.h>
+
+using namespace lumi;
+
+/* Converts a binary log written by debugging::BinaryLogFileSink back into text */
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: log_decoder <file> [--timestamps]" << std::endl;
+        return 1;
+    }
+
+    bool timestamps = argc > 2 && std::strcmp(argv[2], "--timestamps") == 0;
+
+    debugging::BinaryLogReader reader;
+    if (!reader.Open(argv[1]))
+    {
+        std::cerr << "Failed to open binary log " << argv[1] << std::endl;
+        return 1;
+    }
+
+    debugging::LogMessage message;
+    std::string text;
+    while (reader.Next(message, text))
+    {
+        if (timestamps)
+        {
+            auto time = std::chrono::sys_time<std::chrono::nanoseconds>(std::chrono::nanoseconds(message.timestamp));
+            std::cout << std::format("{:%F %T} [{:08x}] ", std::chrono::floor<std::chrono::microseconds>(time), message.threadId);
+        }
+        std::cout << "[" << debugging::LogTypeName(message.type) << "]";
+        if (!reader.GetCategory().empty())
+        {
+            std::cout << "[" << reader.GetCategory() << "]";
+        }
+        std::cout << ": " << message.text << '\n';
+    }
+    return 0;
+}
\ No newline at end of file
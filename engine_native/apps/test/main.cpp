@@ -2,7 +2,13 @@
 #undef CreateWindowExW
 #undef CreateWindowEx
 
+#include <core/job_system.h>
+#include <debugging/alloc_tracker.h>
 #include <debugging/logger.h>
+#include <debugging/mapped_file_log_sink.h>
+#include <debugging/profiler.h>
+#include <gfx/render/render_graph.h>
+#include <sys/frame_stats.h>
 #include <sys/window_manager.h>
 #include <gfx/backends/d3d12/d3d12_device.h>
 #include <gfx/backends/d3d12/d3d12_render_target.h>
@@ -13,6 +19,17 @@ using namespace gfx;
 
 int main()
 {
+    // Keep console I/O and formatting off the render loop
+    debugging::Logger::Instance().SetDeferredFormatting(true);
+    debugging::Logger::Instance().StartAsync();
+
+    // Everything goes to the log file, the console only shows warnings and errors
+    auto consoleSink = std::make_shared<debugging::ConsoleLogSink>();
+    consoleSink->SetLevel(debugging::LogType::Warn);
+    debugging::Logger::Instance().ClearSinks();
+    debugging::Logger::Instance().AddSink(consoleSink);
+    debugging::Logger::Instance().AddSink(std::make_shared<debugging::MappedFileLogSink>(debugging::MappedFileLogConfig{}));
+
     sys::WindowManager windowManager;
     if (!windowManager.Init())
     {
@@ -37,14 +54,14 @@ int main()
     sys::WinPtr window = windowManager.NewWindow(winProps);
     if (!window)
     { 
-        debugging::Logger::Instance().LogError("Window failure!");
+        LUMI_LOG_ERROR(debugging::LogCore, "Window failure!");
         return -1;
     }
     
     d3d12::D3D12Device device;
     if (!device.Init())
     {
-        debugging::Logger::Instance().LogError("Device failure!");
+        LUMI_LOG_ERROR(debugging::LogCore, "Device failure!");
         return -1;
     }
 
@@ -53,15 +70,20 @@ int main()
     std::shared_ptr<d3d12::D3D12RenderTarget> renderTarget = std::make_shared<d3d12::D3D12RenderTarget>(device, window);
     if (!renderTarget->Init(maxFramesInFlight))
     {
-        debugging::Logger::Instance().LogError("Render Target failure!");
+        LUMI_LOG_ERROR(debugging::LogCore, "Render Target failure!");
         return -1;
     }
 
-    render::RenderOrchestrator renderOrchestrator;
+    render::RenderGraph renderGraph;
     d3d12::render::D3D12RenderContext renderContext;
 
-    render::RenderPass pass;
+    // The back buffer is presented after the graph runs, so it's left in the present state
+    render::RenderGraphImage backBuffer = renderGraph.ImportImage("backbuffer",
+        render::RenderGraph::ColorBuffer, resources::ImageState::Present);
+
+    render::RenderGraphPass pass;
     pass.targets = { renderTarget.get() };
+    pass.writes = { { backBuffer, resources::ImageState::Color } };
     pass.execute = [&](render::IRenderContext& ctx, IRenderTarget* target)
     {
         render::Viewport viewport;
@@ -74,7 +96,7 @@ int main()
 
         render::Scissor scissor;
         scissor.height = static_cast<int>(viewport.height);
-        scissor.width = static_cast<int>(viewport.height);
+        scissor.width = static_cast<int>(viewport.width);
         scissor.x = static_cast<int>(viewport.x);
         scissor.y = static_cast<int>(viewport.y);
 
@@ -97,31 +119,95 @@ int main()
         ctx.EndRecording(info);
     };
 
-    renderOrchestrator.NewPass("main", pass);
+    renderGraph.NewPass("main", std::move(pass));
     
+    // Capture the first few frames so startup hitches show up in the trace
+    debugging::Profiler::Instance().SetThreadName("Main");
+    debugging::Profiler::Instance().StartCapture(120);
+
+    core::JobSystem::Instance().Start();
+
+    sys::FrameStats frameStats;
+    auto frameStart = std::chrono::steady_clock::now();
+
+    // Once startup is over, allocations that keep happening every frame are worth finding
+    constexpr uint64_t allocWarmupFrames = 300;
+    debugging::AllocTracker& allocTracker = debugging::AllocTracker::Instance();
+
     uint32_t frameIndex = 0;
+    uint64_t frameCount = 0;
     while (true)
     {
+        LUMI_PROFILE_FRAME();
+        allocTracker.MarkFrame();
+        if (++frameCount == allocWarmupFrames && debugging::AllocTracker::IsHooked())
+        {
+            allocTracker.SetCallSiteCapture(true);
+        }
+
         if (window->Closing())
         {
             break;
         }
         
         windowManager.Update();
+        core::JobSystem::Instance().RunMainThreadJobs();
+
+        sys::FrameTimings timings;
+        auto recordStart = std::chrono::steady_clock::now();
 
         renderTarget->StartRendering(frameIndex);
 
         renderContext.SetFrameNumber(frameIndex);
         renderContext.SetRenderTarget(*renderTarget.get());
-        renderOrchestrator.Execute(renderContext);
+        renderGraph.Execute(renderContext);
 
         renderTarget->EndRendering(frameIndex);
 
+        // StartRendering may wait for the GPU to free the frame's index, that's counted as present wait instead
+        auto submitStart = std::chrono::steady_clock::now();
+        timings.cpuRecord = submitStart - recordStart - renderTarget->GetFrameWaitTime();
+
+        renderTarget->SubmitRendering(frameIndex);
+
+        auto frameEnd = std::chrono::steady_clock::now();
+        timings.presentWait = renderTarget->GetPresentWaitTime();
+        timings.submit = frameEnd - submitStart - timings.presentWait;
+        timings.frame = frameEnd - frameStart;
+        frameStart = frameEnd;
+        frameStats.Record(timings);
+
         frameIndex = (frameIndex + 1) % maxFramesInFlight;
     }
+
+    for (const auto& pass : renderTarget->GetTimings().GetResults())
+    {
+        LUMI_LOG_INFO(debugging::LogCore, "Pass {} took {:.3f}ms on the GPU",
+            pass.name, std::chrono::duration<float, std::milli>(pass.duration).count());
+    }
+
+    for (const auto& snapshot : frameStats.Snapshot())
+    {
+        const auto& frame = snapshot.Get(sys::FrameMetric::Frame);
+        LUMI_LOG_INFO(debugging::LogCore, "Last {} frames: p50 {:.2f}ms p95 {:.2f}ms p99 {:.2f}ms max {:.2f}ms",
+            frame.count, frame.p50, frame.p95, frame.p99, frame.max);
+    }
     
+    if (debugging::AllocTracker::IsHooked())
+    {
+        allocTracker.SetCallSiteCapture(false);
+        LUMI_LOG_WARN(debugging::LogCore, "Last frame made {} allocations ({} bytes), steady-state call sites:",
+            allocTracker.GetLastFrame().allocations, allocTracker.GetLastFrame().bytes);
+        allocTracker.LogCallSites();
+    }
+
+    debugging::Profiler::Instance().StopCapture();
+    debugging::Profiler::Instance().ExportChromeTrace("lumi_trace.json");
+
+    core::JobSystem::Instance().Stop();
     renderTarget.reset();
     device.Cleanup();
     windowManager.Cleanup();
+    debugging::Logger::Instance().StopAsync();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+
+namespace lumi::core
+{
+    /* Logs items dropped past a fixed vector's capacity, rate limited so a per-frame overflow doesn't flood the log */
+    void ReportFixedVectorOverflow(size_t capacity, size_t count);
+
+    /**
+     * \brief A vector with its storage inline and a fixed capacity, it never allocates
+     * \note Items past the capacity are dropped and logged as errors,
+     *       Push returns false and initializer lists are cut short
+     */
+    template<typename T, size_t Capacity>
+    class FixedVector
+    {
+    public:
+        FixedVector() = default;
+
+        FixedVector(std::initializer_list<T> items)
+        {
+            Assign(items);
+        }
+
+        FixedVector& operator=(std::initializer_list<T> items)
+        {
+            Assign(items);
+            return *this;
+        }
+
+        /* Adds an item at the end, false if the vector is full */
+        bool Push(const T& item)
+        {
+            if (_size == Capacity)
+            {
+                ReportFixedVectorOverflow(Capacity, Capacity + 1);
+                return false;
+            }
+            _items[_size++] = item;
+            return true;
+        }
+
+        void Pop() { if (_size > 0) --_size; }
+        void Clear() { _size = 0; }
+
+        [[nodiscard]] T& operator[](const size_t index) { return _items[index]; }
+        [[nodiscard]] const T& operator[](const size_t index) const { return _items[index]; }
+
+        [[nodiscard]] T* data() { return _items.data(); }
+        [[nodiscard]] const T* data() const { return _items.data(); }
+        [[nodiscard]] size_t size() const { return _size; }
+        [[nodiscard]] bool empty() const { return _size == 0; }
+        [[nodiscard]] static constexpr size_t capacity() { return Capacity; }
+
+        [[nodiscard]] T* begin() { return _items.data(); }
+        [[nodiscard]] T* end() { return _items.data() + _size; }
+        [[nodiscard]] const T* begin() const { return _items.data(); }
+        [[nodiscard]] const T* end() const { return _items.data() + _size; }
+
+        [[nodiscard]] std::span<T> AsSpan() { return { _items.data(), _size }; }
+        [[nodiscard]] std::span<const T> AsSpan() const { return { _items.data(), _size }; }
+    private:
+        std::array<T, Capacity> _items{};
+        uint32_t _size = 0;
+
+        void Assign(std::initializer_list<T> items)
+        {
+            if (items.size() > Capacity)
+            {
+                ReportFixedVectorOverflow(Capacity, items.size());
+            }
+
+            _size = 0;
+            for (const T& item : items)
+            {
+                if (_size == Capacity)
+                {
+                    break;
+                }
+                _items[_size++] = item;
+            }
+        }
+    };
+}
\ No newline at end of file
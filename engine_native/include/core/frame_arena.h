@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lumi::core
+{
+    /**
+     * \brief Hands out memory by bumping an offset and frees all of it at once on Reset
+     * \details When a block runs out another one is chained on. Reset merges the blocks into one big enough for
+     *          everything allocated since the last reset, so a workload that repeats stops allocating after a frame.
+     * \note Destructors of objects in the arena are never called, only trivially destructible types can be allocated
+     * \warning Not thread safe, give each recording thread or render target its own arena
+     */
+    class LinearArena
+    {
+    public:
+        static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+        explicit LinearArena(size_t blockSize = kDefaultBlockSize);
+        ~LinearArena() = default;
+
+        LinearArena(const LinearArena&) = delete;
+        LinearArena& operator=(const LinearArena&) = delete;
+        LinearArena(LinearArena&&) noexcept = default;
+        LinearArena& operator=(LinearArena&&) noexcept = default;
+
+        /**
+         * \brief Gets uninitialized memory that stays valid until the next Reset
+         *
+         * \param size The number of bytes
+         * \param alignment A power of two the address is aligned to
+         */
+        [[nodiscard]] void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        /* Gets count value-initialized objects */
+        template<typename T>
+        [[nodiscard]] std::span<T> AllocateSpan(const size_t count)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "The arena never calls destructors");
+            T* items = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+            std::uninitialized_value_construct_n(items, count);
+            return { items, count };
+        }
+
+        /* Constructs one object in the arena */
+        template<typename T, typename... Args>
+        [[nodiscard]] T* New(Args&&... args)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "The arena never calls destructors");
+            return ::new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        /* Frees everything allocated from the arena */
+        void Reset();
+
+        /* Bytes handed out since the last reset, including alignment padding */
+        [[nodiscard]] size_t GetUsed() const { return _used; }
+        [[nodiscard]] size_t GetCapacity() const;
+    private:
+        struct Block
+        {
+            std::unique_ptr<std::byte[]> data;
+            size_t size = 0;
+        };
+
+        size_t _blockSize;
+        std::vector<Block> _blocks;
+        size_t _block = 0;
+        size_t _offset = 0;
+        size_t _used = 0;
+
+        void AddBlock(size_t minSize);
+    };
+
+    /**
+     * \brief One linear arena per frame in flight
+     * \details A frame's arena is reset when the frame starts again, once the GPU is done with its last use,
+     *          so memory written while recording a frame can be read until that frame finishes on the GPU
+     */
+    class FrameArena
+    {
+    public:
+        /* Sets the number of frames in flight, dropping every arena */
+        void SetFrameCount(uint32_t count);
+
+        /* Resets the arena of a frame, call once the frame's previous use has retired */
+        void BeginFrame(uint32_t frame);
+
+        [[nodiscard]] LinearArena& Get(const uint32_t frame) { return _arenas[frame]; }
+        [[nodiscard]] uint32_t GetFrameCount() const { return static_cast<uint32_t>(_arenas.size()); }
+    private:
+        std::vector<LinearArena> _arenas;
+    };
+
+    /**
+     * \brief A memory resource over a linear arena, for standard containers that should allocate from it
+     * \note Freeing does nothing, the memory comes back when the arena resets
+     */
+    class ArenaResource : public std::pmr::memory_resource
+    {
+    public:
+        explicit ArenaResource(LinearArena& arena) : _arena(&arena) {}
+    private:
+        LinearArena* _arena;
+
+        void* do_allocate(const size_t bytes, const size_t alignment) override { return _arena->Allocate(bytes, alignment); }
+        void do_deallocate(void*, size_t, size_t) override {}
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+}
\ No newline at end of file
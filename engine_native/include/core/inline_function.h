@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace lumi::core
+{
+    template<typename Signature, size_t Capacity>
+    class InlineFunction;
+
+    /**
+     * \brief A move-only callable stored inside the object, it never allocates
+     * \details Callables whose captures don't fit in Capacity bytes fail to compile instead of falling back to the heap.
+     *          Calling costs one indirect call, moving a trivially copyable callable is a plain copy of the buffer.
+     * \warning Calling an empty InlineFunction is undefined, check it first when it may be empty
+     */
+    template<typename R, typename... Args, size_t Capacity>
+    class InlineFunction<R(Args...), Capacity>
+    {
+    public:
+        InlineFunction() = default;
+        InlineFunction(std::nullptr_t) {}
+
+        template<typename F>
+            requires (!std::is_same_v<std::remove_cvref_t<F>, InlineFunction> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+        InlineFunction(F&& function)
+        {
+            using Stored = std::decay_t<F>;
+            static_assert(sizeof(Stored) <= Capacity, "The callable's captures don't fit, capture less or raise the capacity");
+            static_assert(alignof(Stored) <= alignof(std::max_align_t), "The callable is over-aligned");
+            static_assert(std::is_nothrow_move_constructible_v<Stored>, "The callable must be nothrow movable");
+
+            ::new (static_cast<void*>(_storage)) Stored(std::forward<F>(function));
+            _invoke = &Invoke<Stored>;
+            if constexpr (!std::is_trivially_copyable_v<Stored>)
+            {
+                _manage = &Manage<Stored>;
+            }
+            else if constexpr (!std::is_empty_v<Stored>)
+            {
+                _size = sizeof(Stored);
+            }
+        }
+
+        InlineFunction(InlineFunction&& other) noexcept
+        {
+            MoveFrom(other);
+        }
+
+        InlineFunction& operator=(InlineFunction&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                MoveFrom(other);
+            }
+            return *this;
+        }
+
+        InlineFunction& operator=(std::nullptr_t) noexcept
+        {
+            Reset();
+            return *this;
+        }
+
+        InlineFunction(const InlineFunction&) = delete;
+        InlineFunction& operator=(const InlineFunction&) = delete;
+
+        ~InlineFunction()
+        {
+            Reset();
+        }
+
+        R operator()(Args... args) const
+        {
+            return _invoke(_storage, std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const { return _invoke != nullptr; }
+    private:
+        enum class Operation : uint8_t
+        {
+            Move,
+            Destroy
+        };
+
+        using InvokeFunction = R(*)(void* storage, Args&&... args);
+        /* Null for trivially copyable callables, they're copied with the buffer and need no destructor */
+        using ManageFunction = void(*)(Operation operation, void* storage, void* other);
+
+        alignas(std::max_align_t) mutable std::byte _storage[Capacity];
+        InvokeFunction _invoke = nullptr;
+        ManageFunction _manage = nullptr;
+        /* Bytes a trivially copyable callable uses, moves copy only these, none for a captureless lambda */
+        uint32_t _size = 0;
+
+        template<typename Stored>
+        static R Invoke(void* storage, Args&&... args)
+        {
+            return (*std::launder(static_cast<Stored*>(storage)))(std::forward<Args>(args)...);
+        }
+
+        template<typename Stored>
+        static void Manage(const Operation operation, void* storage, void* other)
+        {
+            auto* stored = std::launder(static_cast<Stored*>(storage));
+            if (operation == Operation::Move)
+            {
+                ::new (other) Stored(std::move(*stored));
+            }
+            stored->~Stored();
+        }
+
+        void MoveFrom(InlineFunction& other) noexcept
+        {
+            if (other._manage)
+            {
+                other._manage(Operation::Move, other._storage, _storage);
+            }
+            else if (other._invoke)
+            {
+                std::memcpy(_storage, other._storage, other._size);
+            }
+            _invoke = std::exchange(other._invoke, nullptr);
+            _manage = std::exchange(other._manage, nullptr);
+            _size = std::exchange(other._size, 0);
+        }
+
+        void Reset() noexcept
+        {
+            if (_manage)
+            {
+                _manage(Operation::Destroy, _storage, nullptr);
+            }
+            _invoke = nullptr;
+            _manage = nullptr;
+            _size = 0;
+        }
+    };
+}
\ No newline at end of file
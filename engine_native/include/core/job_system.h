@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "work_stealing_deque.h"
+
+namespace lumi::core
+{
+    using JobFunction = std::function<void()>;
+
+    /* Where a job is allowed to run */
+    enum class JobAffinity : uint8_t
+    {
+        Any,
+        MainThread /* For work that has to stay on the main thread, like SDL window calls */
+    };
+
+    struct Job;
+
+    /**
+     * \brief Counts jobs that haven't finished yet
+     * \details Every job run with a counter adds one to it and removes one when it finishes. Wait on a counter to join
+     *          its jobs, or run jobs after it so they only start once the counter reaches zero.
+     * \warning A counter has to outlive the jobs counted on it and the jobs waiting on it
+     */
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        [[nodiscard]] bool IsDone() const { return _pending.load(std::memory_order_acquire) == 0; }
+        [[nodiscard]] uint32_t GetPending() const { return _pending.load(std::memory_order_acquire); }
+    private:
+        friend class JobSystem;
+
+        std::atomic<uint32_t> _pending = 0;
+        /* Jobs waiting for this counter to reach zero, linked through the jobs */
+        std::mutex _mutex;
+        Job* _waiting = nullptr;
+    };
+
+    /**
+     * \brief Runs jobs on a pool of worker threads that steal work from each other
+     * \details Each thread pushes the jobs it creates to its own deque and pops them newest first, idle threads steal the
+     *          oldest jobs from others. Jobs for the main thread go to a separate queue that only the main thread runs,
+     *          from Wait or RunMainThreadJobs.
+     * \note Until Start is called, or after Stop, jobs run immediately on the thread that adds them
+     */
+    class JobSystem
+    {
+    public:
+        static constexpr size_t kJobsPerThread = 4096;
+        static constexpr uint32_t kNoThreadIndex = ~0u;
+
+        static JobSystem& Instance()
+        {
+            static JobSystem inst;
+            return inst;
+        }
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /**
+         * \brief Starts the worker threads, the calling thread becomes the main thread
+         *
+         * \param workerCount Threads started besides the main thread
+         */
+        void Start(uint32_t workerCount = DefaultWorkerCount());
+
+        /**
+         * \brief Stops and joins the worker threads
+         * \warning Wait for every job first, jobs still queued are dropped
+         */
+        void Stop();
+
+        [[nodiscard]] bool IsRunning() const { return _running.load(std::memory_order_acquire); }
+        [[nodiscard]] uint32_t GetWorkerCount() const { return _workerCount; }
+        /* Threads that run jobs, the workers and the main thread */
+        [[nodiscard]] uint32_t GetThreadCount() const { return _workerCount + 1; }
+
+        /**
+         * \brief Queues a job
+         * \note Jobs come from a fixed set of slots per thread, they're only allocated on threads outside of the pool
+         *       or when every slot is in use
+         *
+         * \param function The work to run
+         * \param counter Counts the job until it finishes, can be null
+         * \param affinity Which threads may run the job
+         */
+        void Run(JobFunction function, JobCounter* counter = nullptr, JobAffinity affinity = JobAffinity::Any);
+
+        /**
+         * \brief Queues a job that starts once a counter's jobs have all finished
+         *
+         * \param dependency The counter to wait for
+         * \param function The work to run
+         * \param counter Counts the job until it finishes, can be null
+         * \param affinity Which threads may run the job
+         */
+        void RunAfter(JobCounter& dependency, JobFunction function, JobCounter* counter = nullptr,
+            JobAffinity affinity = JobAffinity::Any);
+
+        /**
+         * \brief Runs other jobs until a counter reaches zero
+         * \note On the main thread this also runs main thread jobs
+         */
+        void Wait(JobCounter& counter);
+
+        /* Runs queued main thread jobs, call this from the main loop if jobs may be queued for it */
+        void RunMainThreadJobs();
+
+        /**
+         * \brief Splits [0, count) into chunks of grainSize and runs body(begin, end) for each chunk, then waits
+         * \note The calling thread runs chunks too, chunks are handed out in order but may finish in any order
+         */
+        template<typename Body>
+        void ParallelFor(size_t count, size_t grainSize, Body&& body);
+
+        /* Index of the calling thread, 0 for the main thread and 1 to GetWorkerCount() for workers */
+        [[nodiscard]] static uint32_t GetThreadIndex();
+        [[nodiscard]] static bool IsMainThread() { return GetThreadIndex() == 0; }
+
+        [[nodiscard]] static uint32_t DefaultWorkerCount()
+        {
+            return std::max(std::thread::hardware_concurrency(), 2u) - 1;
+        }
+    private:
+        struct ThreadData;
+
+        JobSystem();
+        ~JobSystem();
+
+        std::vector<std::unique_ptr<ThreadData>> _threads;
+        std::vector<std::thread> _workers;
+        uint32_t _workerCount = 0;
+        std::atomic<bool> _running = false;
+
+        /* Jobs added by threads outside of the pool */
+        std::mutex _sharedMutex;
+        std::vector<Job*> _sharedJobs;
+        std::vector<Job*> _mainThreadJobs;
+        std::atomic<uint32_t> _mainThreadJobCount = 0;
+
+        /* Idle workers sleep until the epoch changes */
+        std::mutex _sleepMutex;
+        std::condition_variable _wake;
+        std::atomic<uint64_t> _epoch = 0;
+        std::atomic<uint32_t> _sleeping = 0;
+
+        Job* AllocateJob(JobFunction& function, JobCounter* counter, JobAffinity affinity);
+        void Submit(Job* job);
+        bool TryRunJob(uint32_t threadIndex);
+        bool TryRunMainThreadJob();
+        void Execute(Job* job);
+        void Finish(JobCounter& counter);
+        void WakeWorkers();
+        void WorkerLoop(uint32_t threadIndex);
+
+        template<typename Body>
+        struct ParallelForState
+        {
+            Body* body;
+            size_t count;
+            size_t grainSize;
+            std::atomic<size_t> next = 0;
+        };
+    };
+
+    template<typename Body>
+    void JobSystem::ParallelFor(const size_t count, size_t grainSize, Body&& body)
+    {
+        grainSize = std::max<size_t>(grainSize, 1);
+        size_t chunks = (count + grainSize - 1) / grainSize;
+        if (chunks <= 1 || !IsRunning())
+        {
+            if (count > 0)
+            {
+                body(size_t(0), count);
+            }
+            return;
+        }
+
+        // One job per thread that keeps taking chunks, so a slow chunk doesn't hold up the others
+        using BodyType = std::remove_reference_t<Body>;
+        ParallelForState<BodyType> state{ &body, count, grainSize };
+        auto runChunks = [&state]
+        {
+            while (true)
+            {
+                size_t begin = state.next.fetch_add(state.grainSize, std::memory_order_relaxed);
+                if (begin >= state.count)
+                {
+                    return;
+                }
+                (*state.body)(begin, std::min(begin + state.grainSize, state.count));
+            }
+        };
+
+        JobCounter counter;
+        size_t jobs = std::min<size_t>(chunks, GetThreadCount()) - 1;
+        for (size_t i = 0; i < jobs; ++i)
+        {
+            Run(runChunks, &counter);
+        }
+        runChunks();
+        Wait(counter);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace lumi::core
+{
+    /* A key and the index of whatever it sorts, sorting moves these instead of the items */
+    struct SortEntry
+    {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    /**
+     * \brief Sorts entries by key with a stable LSD radix sort, 11 bits per pass
+     * \details Digits that are the same in every key are skipped, so keys that leave fields unused sort in fewer passes.
+     *          Large inputs are counted and scattered in parallel on the job system while it's running.
+     * \note The sorted entries end up in entries, scratch only holds them between passes
+     *
+     * \param entries The entries to sort
+     * \param scratch Space for at least as many entries as entries, its contents are overwritten
+     */
+    void RadixSort(std::span<SortEntry> entries, std::span<SortEntry> scratch);
+}
\ No newline at end of file
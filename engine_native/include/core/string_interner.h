@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace lumi::core
+{
+    /* Refers to a string stored in a StringInterner */
+    struct InternedString
+    {
+        static constexpr uint32_t kInvalid = ~0u;
+
+        uint32_t id = kInvalid;
+
+        [[nodiscard]] bool IsValid() const { return id != kInvalid; }
+        bool operator==(const InternedString&) const = default;
+    };
+
+    /**
+     * \brief Stores each distinct string once and gives it a small id
+     * \details Ids are handed out in order starting at zero, so they can index arrays. Only interning and finding hash
+     *          the string, comparing and copying ids never touch it.
+     * \note Interned strings keep their address until the interner is cleared
+     */
+    class StringInterner
+    {
+    public:
+        /* Gets the id of a string, storing it first if it's new */
+        InternedString Intern(std::string_view string);
+
+        /* Gets the id of a string without storing it, invalid if it was never interned */
+        [[nodiscard]] InternedString Find(std::string_view string) const;
+
+        /* Gets the string behind an id, empty for an invalid id */
+        [[nodiscard]] std::string_view GetString(InternedString string) const;
+
+        [[nodiscard]] size_t GetSize() const { return _strings.size(); }
+
+        /* Forgets every string, ids given out before are no longer valid */
+        void Clear();
+    private:
+        /* A deque never moves its elements, so the map's keys can view into it */
+        std::deque<std::string> _strings;
+        std::unordered_map<std::string_view, uint32_t> _ids;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace lumi::core
+{
+    /**
+     * \brief A fixed size Chase-Lev deque, the owner pushes and pops at the bottom while other threads steal from the top
+     * \details Follows "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al.), without growing
+     * \note Push fails when the deque is full, the caller decides what to do with the item instead
+     */
+    template<typename T, size_t Capacity>
+    class WorkStealingDeque
+    {
+        static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+        static_assert(std::is_trivially_copyable_v<T>, "Items are copied between threads without locking");
+    public:
+        /* Adds an item at the bottom, only call from the owning thread */
+        bool Push(const T item)
+        {
+            int64_t bottom = _bottom.load(std::memory_order_relaxed);
+            int64_t top = _top.load(std::memory_order_acquire);
+            if (bottom - top >= static_cast<int64_t>(Capacity))
+            {
+                return false;
+            }
+
+            // A release store rather than the paper's fence, same cost and visible to thread sanitizers
+            _items[static_cast<size_t>(bottom) & kMask].store(item, std::memory_order_relaxed);
+            _bottom.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        /* Takes the newest item, only call from the owning thread */
+        bool Pop(T& item)
+        {
+            int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+            _bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = _top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                _bottom.store(bottom + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            item = _items[static_cast<size_t>(bottom) & kMask].load(std::memory_order_relaxed);
+            if (top != bottom)
+            {
+                return true;
+            }
+
+            // The last item, race the thieves for it
+            bool won = _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+
+        /* Takes the oldest item, safe to call from any thread */
+        bool Steal(T& item)
+        {
+            int64_t top = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = _bottom.load(std::memory_order_acquire);
+            if (top >= bottom)
+            {
+                return false;
+            }
+
+            item = _items[static_cast<size_t>(top) & kMask].load(std::memory_order_relaxed);
+            return _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        }
+
+        /* Items in the deque, only a hint while other threads use it */
+        [[nodiscard]] size_t GetSize() const
+        {
+            int64_t size = _bottom.load(std::memory_order_relaxed) - _top.load(std::memory_order_relaxed);
+            return size > 0 ? static_cast<size_t>(size) : 0;
+        }
+    private:
+        static constexpr size_t kMask = Capacity - 1;
+
+        alignas(64) std::atomic<int64_t> _top = 0;
+        alignas(64) std::atomic<int64_t> _bottom = 0;
+        alignas(64) std::array<std::atomic<T>, Capacity> _items{};
+    };
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lumi::debugging
+{
+    /* Heap activity counted by the allocation hooks */
+    struct AllocStats
+    {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        uint64_t frees = 0;
+    };
+
+    /* Allocations a single frame may make before it counts as over budget */
+    struct AllocBudget
+    {
+        uint64_t allocations = UINT64_MAX;
+        uint64_t bytes = UINT64_MAX;
+        /* Logs the frame's call sites and aborts on the first frame over budget, for tests */
+        bool abortOnExceed = false;
+    };
+
+    /* Where allocations came from while call sites were being captured */
+    struct AllocCallSite
+    {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        std::vector<std::string> frames;
+    };
+
+    /**
+     * \brief Counts heap allocations per frame, per thread and per call site
+     * \details Counting is opt-in: it only happens in executables that link the debugalloc object library,
+     *          which replaces the global operator new and delete. Without it every count stays at zero.
+     * \note The counts include allocations from every thread, per-thread counts are used by profiler zones
+     */
+    class AllocTracker
+    {
+    public:
+        /* Frames captured per allocation, including the few inside the hooks */
+        static constexpr size_t kCallSiteDepth = 12;
+        static constexpr size_t kMaxCallSites = 1024;
+
+        static AllocTracker& Instance()
+        {
+            static AllocTracker inst;
+            return inst;
+        }
+
+        AllocTracker(const AllocTracker&) = delete;
+        AllocTracker& operator=(const AllocTracker&) = delete;
+
+        /* Allocations made by the calling thread since it started */
+        [[nodiscard]] static AllocStats& GetThreadStats()
+        {
+            static thread_local AllocStats stats;
+            return stats;
+        }
+
+        /* Whether the allocation hooks are linked in, only true after their first allocation */
+        [[nodiscard]] static bool IsHooked() { return s_hooked.load(std::memory_order_relaxed); }
+
+        /**
+         * \brief Counts an allocation, called by the hooks
+         * \warning This must not allocate
+         */
+        static void OnAllocate(size_t size);
+
+        /* Counts a free, called by the hooks */
+        static void OnFree();
+
+        /**
+         * \brief Ends the current frame and checks it against the budget
+         * \note Call this once per frame from the main loop
+         *
+         * \return true The frame stayed within the budget
+         * \return false The frame went over the budget
+         */
+        bool MarkFrame();
+
+        /**
+         * \brief Sets the allocations each frame may make
+         * \note Steady-state frames should make none, pass a default budget to stop checking
+         */
+        void SetFrameBudget(const AllocBudget& budget) { _budget = budget; }
+
+        /**
+         * \brief Starts or stops recording the call stack of every allocation
+         * \note Turn this on once the engine reaches steady state, so the report only shows allocations that repeat
+         *       every frame. Capturing a stack is slow, expect frames to take longer while it's on.
+         */
+        void SetCallSiteCapture(bool capture);
+
+        /* Forgets every captured call site */
+        void ClearCallSites();
+
+        /**
+         * \brief Resolves the captured call sites to symbols
+         * \note This allocates, don't call it inside a frame that's being checked
+         *
+         * \param maxSites How many of the call sites with the most allocations to return
+         */
+        [[nodiscard]] std::vector<AllocCallSite> GetCallSites(size_t maxSites = 16) const;
+
+        /* Logs the call sites with the most allocations as warnings */
+        void LogCallSites(size_t maxSites = 16) const;
+
+        /* Allocations from every thread since the process started */
+        [[nodiscard]] AllocStats GetTotals() const;
+
+        /* Allocations made during the last frame ended by MarkFrame */
+        [[nodiscard]] AllocStats GetLastFrame() const { return _lastFrame; }
+
+        /* Frames that went over the budget */
+        [[nodiscard]] uint64_t GetBudgetViolations() const { return _violations; }
+    private:
+        AllocTracker() = default;
+        ~AllocTracker() = default;
+
+        struct CallSiteSlot
+        {
+            std::atomic<uint64_t> hash = 0;
+            std::atomic<bool> ready = false;
+            std::atomic<uint64_t> allocations = 0;
+            std::atomic<uint64_t> bytes = 0;
+            std::array<void*, kCallSiteDepth> frames{};
+            uint32_t depth = 0;
+        };
+
+        static inline std::atomic<bool> s_hooked = false;
+        static inline std::atomic<bool> s_captureCallSites = false;
+        static inline std::atomic<uint64_t> s_allocations = 0;
+        static inline std::atomic<uint64_t> s_bytes = 0;
+        static inline std::atomic<uint64_t> s_frees = 0;
+
+        std::array<CallSiteSlot, kMaxCallSites> _callSites;
+        AllocStats _frameStart;
+        AllocStats _lastFrame;
+        AllocBudget _budget;
+        uint64_t _violations = 0;
+
+        void RecordCallSite(size_t size);
+    };
+}
\ No newline at end of file
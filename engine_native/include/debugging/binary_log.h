@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include "log_sink.h"
+
+namespace lumi::debugging
+{
+    /**
+     * \brief Layout of binary log files
+     * \details A file starts with kMagic followed by entries, each starting with a BinaryLogEntry byte:
+     *          - Format: u32 id, u16 length, format string
+     *          - Category: u16 index, u16 length, category name
+     *          - Record: u64 timestamp, u32 thread id, u16 category, u32 format id, u8 type, u16 length, serialized arguments
+     *          - Text: u64 timestamp, u32 thread id, u16 category, u8 type, u16 length, message
+     *          Every format and category is written once before the first entry that uses it, so files are self-describing.
+     */
+    namespace binary_log
+    {
+        inline constexpr char kMagic[8] = { 'L', 'U', 'M', 'I', 'L', 'O', 'G', '1' };
+
+        enum class BinaryLogEntry : uint8_t
+        {
+            Format = 1,
+            Record = 2,
+            Text = 3,
+            Category = 4
+        };
+
+        /* Category index of messages that weren't logged with a category */
+        inline constexpr uint16_t kNoCategory = UINT16_MAX;
+    }
+
+    /**
+     * \brief Writes messages to a file without formatting deferred ones
+     * \note Use BinaryLogReader or the log_decoder app to turn the file back into text
+     */
+    class BinaryLogFileSink : public ILogSink
+    {
+    public:
+        explicit BinaryLogFileSink(const std::string& path);
+
+        void Write(const LogMessage& message) override;
+        void Flush() override;
+        [[nodiscard]] bool NeedsText() const override { return false; }
+
+        [[nodiscard]] bool IsOpen() const { return _file.is_open(); }
+    private:
+        std::ofstream _file;
+        std::unordered_set<uint32_t> _writtenFormats;
+        std::unordered_set<uint16_t> _writtenCategories;
+
+        uint16_t WriteCategory(const LogCategory* category);
+    };
+
+    /* Reads binary log files back into formatted messages */
+    class BinaryLogReader
+    {
+    public:
+        /**
+         * \brief Opens a binary log file
+         * 
+         * \return true The file exists and starts with the binary log magic
+         * \return false The file couldn't be read
+         */
+        bool Open(const std::string& path);
+
+        /**
+         * \brief Reads the next message in the file
+         * \note message.text points into text and stays valid until the next call
+         * 
+         * \param message Receives the message's metadata and text
+         * \param text Receives the formatted message
+         * \return true A message was read
+         * \return false The end of the file (or a truncated entry) was reached
+         */
+        bool Next(LogMessage& message, std::string& text);
+
+        /* Name of the category of the last message read, empty if it had none */
+        [[nodiscard]] std::string_view GetCategory() const { return _category; }
+    private:
+        std::ifstream _file;
+        std::unordered_map<uint32_t, std::string> _formats;
+        std::unordered_map<uint16_t, std::string> _categories;
+        std::string _args;
+        std::string_view _category;
+
+        void ReadCategory(uint16_t index);
+    };
+}
\ No newline at end of file
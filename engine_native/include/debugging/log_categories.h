@@ -0,0 +1,21 @@
+#pragma once
+
+#include "log_category.h"
+
+namespace lumi::debugging
+{
+    /* Engine-wide messages and anything logged without a category */
+    LUMI_DECLARE_LOG_CATEGORY(LogCore, "core", LogType::Info);
+
+    /* Window creation, events and the window manager */
+    LUMI_DECLARE_LOG_CATEGORY(LogSysWindow, "sys.window", LogType::Info);
+
+    /* Backend-agnostic rendering such as render orchestrators */
+    LUMI_DECLARE_LOG_CATEGORY(LogGfxRender, "gfx.render", LogType::Info);
+
+    /* The D3D12 backend */
+    LUMI_DECLARE_LOG_CATEGORY(LogGfxD3D12, "gfx.d3d12", LogType::Info);
+
+    /* The headless null backend */
+    LUMI_DECLARE_LOG_CATEGORY(LogGfxNull, "gfx.null", LogType::Info);
+}
\ No newline at end of file
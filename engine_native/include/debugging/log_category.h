@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <string_view>
+#include "log_record.h"
+
+/**
+ * Lowest severity compiled into the engine (0 = Info, 1 = Warn, 2 = Error, 3 = nothing).
+ * Calls below it made through the LUMI_LOG_* macros compile to nothing.
+ */
+#ifndef LUMI_LOG_COMPILE_MIN_LEVEL
+    #ifdef NDEBUG
+        #define LUMI_LOG_COMPILE_MIN_LEVEL 1
+    #else
+        #define LUMI_LOG_COMPILE_MIN_LEVEL 0
+    #endif
+#endif
+
+namespace lumi::debugging
+{
+    inline constexpr int kLogCompileMinLevel = LUMI_LOG_COMPILE_MIN_LEVEL;
+
+    /**
+     * \brief A named group of log messages with its own runtime severity threshold
+     * \note Categories register themselves on construction so tools can look them up by name
+     */
+    class LogCategory
+    {
+    public:
+        explicit LogCategory(std::string_view name, LogType level = LogType::Info)
+            : _name(name), _level(level), _index(s_count.fetch_add(1, std::memory_order_relaxed))
+        {
+            _next = s_head.load(std::memory_order_relaxed);
+            while (!s_head.compare_exchange_weak(_next, this, std::memory_order_release, std::memory_order_relaxed)) {}
+        }
+
+        LogCategory(const LogCategory&) = delete;
+        LogCategory& operator=(const LogCategory&) = delete;
+
+        /**
+         * \brief Finds a registered category by its name (e.g. "gfx.d3d12")
+         * 
+         * \return LogCategory* The category, or nullptr if none has that name
+         */
+        static LogCategory* Find(std::string_view name)
+        {
+            for (LogCategory* category = s_head.load(std::memory_order_acquire); category; category = category->_next)
+            {
+                if (category->_name == name)
+                    return category;
+            }
+            return nullptr;
+        }
+
+        /**
+         * \brief Calls fn with every registered category
+         */
+        template<typename Fn>
+        static void ForEach(Fn&& fn)
+        {
+            for (LogCategory* category = s_head.load(std::memory_order_acquire); category; category = category->_next)
+            {
+                fn(*category);
+            }
+        }
+
+        /**
+         * \brief Changes the lowest severity this category writes
+         * \note Messages below the compile-time minimum stay compiled out regardless of this
+         */
+        void SetLevel(const LogType level) { _level.store(level, std::memory_order_relaxed); }
+
+        [[nodiscard]] bool IsEnabled(const LogType type) const { return type >= _level.load(std::memory_order_relaxed); }
+        [[nodiscard]] LogType GetLevel() const { return _level.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::string_view GetName() const { return _name; }
+
+        /* Registration order of this category, used to refer to it compactly in binary logs */
+        [[nodiscard]] uint16_t GetIndex() const { return _index; }
+    private:
+        std::string_view _name;
+        std::atomic<LogType> _level;
+        uint16_t _index;
+        LogCategory* _next = nullptr;
+
+        static inline std::atomic<LogCategory*> s_head = nullptr;
+        static inline std::atomic<uint16_t> s_count = 0;
+    };
+
+    /**
+     * \brief Checks if a severity is compiled in for a category declared with LUMI_DECLARE_LOG_CATEGORY
+     */
+    template<typename Category>
+    constexpr bool IsLogCompiledIn(const LogType type)
+    {
+        return static_cast<int>(type) >= kLogCompileMinLevel && type >= Category::kCompileMinimum;
+    }
+}
+
+/**
+ * Declares a log category type.
+ * Identifier::instance holds the runtime level, compileMinimum is the lowest severity compiled in for it.
+ */
+#define LUMI_DECLARE_LOG_CATEGORY(Identifier, name, compileMinimum) \
+    struct Identifier \
+    { \
+        static constexpr ::lumi::debugging::LogType kCompileMinimum = compileMinimum; \
+        static inline ::lumi::debugging::LogCategory instance{name}; \
+    }
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace lumi::debugging
+{
+    /**
+     * \brief Hashes a format string into the ID used by deferred log records
+     * \note 0 is reserved for "no format", so it's never returned
+     */
+    constexpr uint32_t HashLogFormat(std::string_view text)
+    {
+        uint32_t hash = 2166136261u;
+        for (char c : text)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 16777619u;
+        }
+        return hash == 0 ? 1 : hash;
+    }
+
+    /**
+     * \brief A format string whose ID is computed at compile time
+     * \note Only string literals can be converted to a LogFormat
+     */
+    struct LogFormat
+    {
+        template<size_t N>
+        consteval LogFormat(const char (&str)[N])
+            : text(str, N - 1), id(HashLogFormat(std::string_view(str, N - 1)))
+        {}
+
+        std::string_view text;
+        uint32_t id;
+    };
+
+    /* Type of a serialized log argument */
+    enum class LogArgTag : uint8_t
+    {
+        Int,
+        UInt,
+        Float,
+        Double,
+        Bool,
+        Char,
+        String,
+        Pointer
+    };
+
+    /**
+     * \brief Serializes raw log arguments into a fixed buffer
+     * \details Each argument is written as a LogArgTag followed by its value, strings are prefixed by a 16-bit length.
+     *          Arguments that don't fit are cut off and show up as missing when decoded.
+     */
+    class LogArgWriter
+    {
+    public:
+        LogArgWriter(char* data, size_t capacity) : _data(data), _capacity(capacity) {}
+
+        template<typename T>
+        void Write(const T& value)
+        {
+            using D = std::decay_t<T>;
+            if constexpr (std::is_same_v<D, bool>)
+            {
+                WriteScalar(LogArgTag::Bool, static_cast<uint8_t>(value));
+            }
+            else if constexpr (std::is_same_v<D, char>)
+            {
+                WriteScalar(LogArgTag::Char, value);
+            }
+            else if constexpr (std::is_integral_v<D> && std::is_signed_v<D>)
+            {
+                WriteScalar(LogArgTag::Int, static_cast<int64_t>(value));
+            }
+            else if constexpr (std::is_integral_v<D>)
+            {
+                WriteScalar(LogArgTag::UInt, static_cast<uint64_t>(value));
+            }
+            else if constexpr (std::is_same_v<D, float>)
+            {
+                WriteScalar(LogArgTag::Float, value);
+            }
+            else if constexpr (std::is_floating_point_v<D>)
+            {
+                WriteScalar(LogArgTag::Double, static_cast<double>(value));
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            {
+                WriteString(std::string_view(value));
+            }
+            else if constexpr (std::is_pointer_v<D> || std::is_null_pointer_v<D>)
+            {
+                WriteScalar(LogArgTag::Pointer, reinterpret_cast<uint64_t>(static_cast<const void*>(value)));
+            }
+            else
+            {
+                // Types without a raw encoding are formatted now and stored as text
+                WriteString(std::format("{}", value));
+            }
+        }
+
+        [[nodiscard]] size_t GetSize() const { return _size; }
+    private:
+        char* _data;
+        size_t _capacity;
+        size_t _size = 0;
+
+        template<typename V>
+        void WriteScalar(LogArgTag tag, const V& value)
+        {
+            if (_size + 1 + sizeof(V) > _capacity)
+            {
+                _size = _capacity;
+                return;
+            }
+            _data[_size++] = static_cast<char>(tag);
+            std::memcpy(_data + _size, &value, sizeof(V));
+            _size += sizeof(V);
+        }
+
+        void WriteString(std::string_view value)
+        {
+            if (_size + 1 + sizeof(uint16_t) > _capacity)
+            {
+                _size = _capacity;
+                return;
+            }
+            auto length = static_cast<uint16_t>(std::min(value.size(), _capacity - _size - 1 - sizeof(uint16_t)));
+            _data[_size++] = static_cast<char>(LogArgTag::String);
+            std::memcpy(_data + _size, &length, sizeof(length));
+            _size += sizeof(length);
+            std::memcpy(_data + _size, value.data(), length);
+            _size += length;
+        }
+    };
+
+    /**
+     * \brief Maps format IDs back to their format strings so deferred records can be formatted later
+     * \note Registration and lookup are lock-free and safe from any thread
+     */
+    class LogFormatRegistry
+    {
+    public:
+        static LogFormatRegistry& Instance()
+        {
+            static LogFormatRegistry inst;
+            return inst;
+        }
+
+        /**
+         * \brief Registers a format string under its ID
+         * 
+         * \return true The format is registered (or already was)
+         * \return false Another format already uses this ID or the registry is full
+         */
+        bool Register(const LogFormat& format);
+
+        /**
+         * \brief Finds the format string registered under an ID
+         * 
+         * \return std::string_view The format string, or empty if the ID is unknown
+         */
+        [[nodiscard]] std::string_view Find(uint32_t id) const;
+    private:
+        static constexpr size_t kCapacity = 4096;
+
+        struct Entry
+        {
+            std::atomic<uint32_t> id = 0;
+            std::atomic<uint32_t> length = 0;
+            std::atomic<const char*> text = nullptr;
+        };
+        Entry _entries[kCapacity];
+    };
+
+    /**
+     * \brief Formats serialized arguments with a format string
+     * \details Each replacement field is formatted on its own with its decoded argument,
+     *          so the result matches what std::vformat would have produced at the call site
+     * 
+     * \param format The format string the arguments were logged with
+     * \param args The bytes written by a LogArgWriter
+     * \param out The string the result is appended to
+     */
+    void FormatLogArgs(std::string_view format, std::string_view args, std::string& out);
+}
\ No newline at end of file
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include "log_record.h"
+
+namespace lumi::debugging
+{
+    class LogCategory;
+
+    /**
+     * \brief Hashes the values of log arguments so repeats of the same message can be recognized
+     * \note Types that aren't numbers, pointers or strings don't contribute to the hash
+     */
+    class LogArgHasher
+    {
+    public:
+        explicit LogArgHasher(uint64_t seed) : _hash(14695981039346656037ull ^ seed) {}
+
+        template<typename T>
+        void Add(const T& value)
+        {
+            using D = std::decay_t<T>;
+            if constexpr (std::is_arithmetic_v<D> || std::is_enum_v<D>)
+            {
+                AddBytes(&value, sizeof(D));
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            {
+                std::string_view str(value);
+                AddBytes(str.data(), str.size());
+            }
+            else if constexpr (std::is_pointer_v<D>)
+            {
+                const void* ptr = value;
+                AddBytes(&ptr, sizeof(ptr));
+            }
+        }
+
+        [[nodiscard]] uint64_t GetHash() const { return _hash; }
+    private:
+        uint64_t _hash;
+
+        void AddBytes(const void* data, size_t size)
+        {
+            auto bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                _hash ^= bytes[i];
+                _hash *= 1099511628211ull;
+            }
+        }
+    };
+
+    /* Repeats of a message that were suppressed and not reported yet */
+    struct LogSuppressed
+    {
+        const LogCategory* category = nullptr;
+        LogType type = LogType::Info;
+        std::string_view text;
+        uint32_t count = 0;
+        /* Time the repeats were counted over, from the last write or report of the message */
+        std::chrono::nanoseconds elapsed{};
+    };
+
+    /**
+     * \brief Suppresses repeats of a message inside a time window
+     * \details A limiter belongs to one call site on one thread, so checking it needs no lookups.
+     *          It remembers the last few distinct argument sets, a repeat of one of them inside the window is suppressed
+     *          and counted, the next one allowed through reports how many were suppressed.
+     *          Counts still pending are reported when their message is evicted by another one, when the limiter's
+     *          thread exits and when the logger is flushed.
+     * \warning A limiter must only be used by one thread, the logger only reads it to flush
+     */
+    class LogRateLimiter
+    {
+    public:
+        LogRateLimiter() = default;
+        /* Reports the counts still pending, defined with the logger it writes them to */
+        ~LogRateLimiter();
+
+        LogRateLimiter(const LogRateLimiter&) = delete;
+        LogRateLimiter& operator=(const LogRateLimiter&) = delete;
+
+        /**
+         * \brief Checks if a message should be written
+         * 
+         * \param key Hash identifying the message (see LogArgHasher)
+         * \param interval Minimum time between two writes of the same message
+         * \param message The message's category, severity and format, kept to report its repeats later
+         * \param repeats Receives the repeats of this message suppressed since it was last written or reported
+         * \param evicted Receives the pending repeats of the message this one replaced, if it had any
+         * \return true The message should be written, after the reports with a count
+         * \return false The message is a repeat and was suppressed
+         */
+        bool Allow(const uint64_t key, const std::chrono::nanoseconds interval, const LogSuppressed& message,
+            LogSuppressed& repeats, LogSuppressed& evicted)
+        {
+            int64_t now = Now();
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            Slot* oldest = &_slots[0];
+            for (Slot& slot : _slots)
+            {
+                if (slot.used && slot.key == key)
+                {
+                    if (now - slot.last < interval.count())
+                    {
+                        ++slot.suppressed;
+                        return false;
+                    }
+                    repeats = Take(slot, now);
+                    slot.last = now;
+                    return true;
+                }
+
+                if (!slot.used || (oldest->used && slot.last < oldest->last))
+                    oldest = &slot;
+            }
+
+            // First time (or evicted), replace the least recently written message
+            if (oldest->used)
+            {
+                evicted = Take(*oldest, now);
+            }
+            oldest->used = true;
+            oldest->key = key;
+            oldest->last = now;
+            oldest->since = now;
+            oldest->message = message;
+            oldest->suppressed = 0;
+            return true;
+        }
+
+        /**
+         * \brief Moves every count still pending into out and starts counting again
+         * \note Skips the limiter while its thread is using it, that thread reports the counts later
+         */
+        template<typename Out>
+        void TakeSuppressed(Out& out)
+        {
+            std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                return;
+            }
+
+            int64_t now = Now();
+            for (Slot& slot : _slots)
+            {
+                if (slot.used && slot.suppressed > 0)
+                {
+                    out.push_back(Take(slot, now));
+                }
+            }
+        }
+
+        /* Set by the logger once it tracks this limiter, only read and written by the limiter's thread */
+        bool registered = false;
+    private:
+        static constexpr size_t kSlots = 4;
+
+        struct Slot
+        {
+            uint64_t key = 0;
+            /* When the message was last written */
+            int64_t last = 0;
+            /* When the repeats being counted started */
+            int64_t since = 0;
+            LogSuppressed message;
+            uint32_t suppressed = 0;
+            bool used = false;
+        };
+        Slot _slots[kSlots];
+        /* Only contended while the logger flushes */
+        std::mutex _mutex;
+
+        static int64_t Now()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            ).count();
+        }
+
+        static LogSuppressed Take(Slot& slot, const int64_t now)
+        {
+            LogSuppressed taken = slot.message;
+            taken.count = slot.suppressed;
+            taken.elapsed = std::chrono::nanoseconds(now - slot.since);
+            slot.suppressed = 0;
+            slot.since = now;
+            return taken;
+        }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+namespace lumi::debugging
+{
+    class LogCategory;
+
+    /* Severity of a logged message, ordered from lowest to highest */
+    enum class LogType : uint8_t
+    {
+        Info,
+        Warn,
+        Error
+    };
+
+    /* What the payload of a LogRecord holds */
+    enum class LogRecordKind : uint8_t
+    {
+        Text, /* An already formatted message */
+        Binary /* Serialized arguments for the format registered under formatId */
+    };
+
+    /* Total size in bytes of a single queued record, header included */
+    inline constexpr size_t kLogRecordSize = 256;
+
+    /**
+     * \brief A fixed-size log entry that can be queued without allocating
+     * \note Messages longer than the payload are truncated when queued
+     */
+    struct LogRecord
+    {
+        uint64_t timestamp = 0; /* Nanoseconds since the system clock's epoch */
+        const LogCategory* category = nullptr;
+        uint32_t threadId = 0;
+        uint32_t formatId = 0; /* Only used by binary records */
+        LogType type = LogType::Info;
+        LogRecordKind kind = LogRecordKind::Text;
+        uint16_t length = 0; /* Bytes used in message */
+        char message[kLogRecordSize - 28];
+    };
+    static_assert(sizeof(LogRecord) == kLogRecordSize, "LogRecord must stay a fixed size");
+
+    /* A read-only view of a message handed to sinks */
+    struct LogMessage
+    {
+        uint64_t timestamp = 0;
+        const LogCategory* category = nullptr;
+        uint32_t threadId = 0;
+        LogType type = LogType::Info;
+        std::string_view text;
+
+        /* Set when the message was logged with deferred formatting */
+        bool deferred = false;
+        uint32_t formatId = 0;
+        std::string_view format;
+        std::string_view args; /* Arguments serialized by a LogArgWriter */
+    };
+
+    /**
+     * \brief Gets the display name of a severity
+     * 
+     * \param type The severity to get the name of
+     * \return const char* The upper case name (e.g. "INFO")
+     */
+    inline const char* LogTypeName(const LogType type)
+    {
+        switch (type)
+        {
+            case LogType::Info:
+                return "INFO";
+            case LogType::Warn:
+                return "WARN";
+            case LogType::Error:
+                return "ERROR";
+        }
+        return "UNKNOWN";
+    }
+}
\ No newline at end of file
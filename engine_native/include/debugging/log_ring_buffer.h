@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include "log_record.h"
+
+namespace lumi::debugging
+{
+    /**
+     * \brief Bounded lock-free multi-producer multi-consumer queue of log records
+     * \details Each cell carries a sequence number that tells producers and consumers whose turn it is,
+     *          so pushing and popping only needs a single compare-exchange on the shared position.
+     * \note Capacity is always rounded down to a power of two
+     */
+    class LogRingBuffer
+    {
+    public:
+        /**
+         * \brief Creates a ring buffer that fits inside a memory budget
+         * 
+         * \param memoryBudget The maximum amount of bytes the records may use
+         */
+        explicit LogRingBuffer(const size_t memoryBudget)
+        {
+            size_t capacity = 2;
+            while (capacity * 2 * sizeof(Cell) <= memoryBudget)
+            {
+                capacity *= 2;
+            }
+
+            _mask = capacity - 1;
+            _cells = std::make_unique<Cell[]>(capacity);
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * \brief Attempts to claim a cell and fill it in place
+         * 
+         * \param fill Callable that receives the LogRecord& to write into
+         * \return true The record was queued
+         * \return false The buffer is full
+         */
+        template<typename Fill>
+        bool TryPush(Fill&& fill)
+        {
+            size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+            Cell* cell = nullptr;
+            for (;;)
+            {
+                cell = &_cells[pos & _mask];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = _enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            fill(cell->record);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * \brief Attempts to take the oldest record out of the buffer
+         * 
+         * \param out Where the record is copied to
+         * \return true A record was taken
+         * \return false The buffer is empty
+         */
+        bool TryPop(LogRecord& out)
+        {
+            size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+            Cell* cell = nullptr;
+            for (;;)
+            {
+                cell = &_cells[pos & _mask];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+                if (diff == 0)
+                {
+                    if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = _dequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            out = cell->record;
+            cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        [[nodiscard]] size_t GetCapacity() const { return _mask + 1; }
+    private:
+        struct alignas(64) Cell
+        {
+            std::atomic<size_t> sequence;
+            LogRecord record;
+        };
+
+        std::unique_ptr<Cell[]> _cells;
+        size_t _mask = 0;
+
+        alignas(64) std::atomic<size_t> _enqueuePos = 0;
+        alignas(64) std::atomic<size_t> _dequeuePos = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include "log_record.h"
+
+namespace lumi::debugging
+{
+    /* Destination that formatted log messages are written to */
+    class ILogSink
+    {
+    public:
+        virtual ~ILogSink() = default;
+
+        /**
+         * \brief Writes a single message to this sink
+         * \note Sinks may buffer the message until Flush() is called
+         */
+        virtual void Write(const LogMessage& message) = 0;
+
+        /* Pushes any buffered messages to their final destination */
+        virtual void Flush() = 0;
+
+        /**
+         * \brief Checks if this sink reads LogMessage::text
+         * \note Deferred messages are only formatted when at least one sink needs their text
+         */
+        [[nodiscard]] virtual bool NeedsText() const { return true; }
+
+        /**
+         * \brief Changes the lowest severity this sink receives
+         * \note This is applied after the category's level, so a sink can't receive messages its category filtered out
+         */
+        void SetLevel(const LogType level) { _level.store(level, std::memory_order_relaxed); }
+
+        [[nodiscard]] LogType GetLevel() const { return _level.load(std::memory_order_relaxed); }
+        [[nodiscard]] bool Accepts(const LogType type) const { return type >= GetLevel(); }
+    protected:
+        std::atomic<LogType> _level = LogType::Info;
+    };
+
+    /* Prints messages to the console */
+    class ConsoleLogSink : public ILogSink
+    {
+    public:
+        void Write(const LogMessage& message) override;
+        void Flush() override;
+    };
+}
\ No newline at end of file
@@ -2,6 +2,21 @@
 
 #include <iostream>
 #include <format>
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "log_categories.h"
+#include "log_format.h"
+#include "log_rate_limiter.h"
+#include "log_record.h"
+#include "log_ring_buffer.h"
+#include "log_sink.h"
 
 #ifdef _WIN32
     #include <windows.h>
@@ -10,16 +25,28 @@
 
 namespace lumi::debugging
 {
-    /* Prints messages to console */
-    class Logger
+    /* Describes what a producer does when the async buffer has no free records */
+    enum class LogOverflowPolicy
     {
-        enum class LogType
-        {
-            Info,
-            Warn,
-            Error
-        };
+        Drop, /* Discards the new message */
+        Block, /* Waits until the background thread frees a record */
+        Overwrite /* Discards the oldest queued message to make room */
+    };
+
+    struct AsyncLogConfig
+    {
+        /* Maximum bytes the queued records may use */
+        size_t memoryBudget = 1024 * 1024;
+        LogOverflowPolicy overflowPolicy = LogOverflowPolicy::Drop;
+        /* Maximum records written to the sinks before they're flushed */
+        uint32_t batchSize = 128;
+        /* How long the background thread sleeps when there's nothing to write */
+        std::chrono::milliseconds idleInterval = std::chrono::milliseconds(5);
+    };
 
+    /* Formats messages and hands them to sinks, either immediately or through a background thread */
+    class Logger
+    {
     public:
         static Logger& Instance()
         {
@@ -27,6 +54,9 @@ namespace lumi::debugging
             return inst;
         }
 
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+
         #ifdef _WIN32
         /**
          * \brief Checks if a HRESULT failed and logs an error if failed
@@ -56,52 +86,319 @@ namespace lumi::debugging
         /**
          * \brief Logs a message to the console with the info severity
          * \note Info is the lowest severity
+         * \note Messages go to the "core" category and are only formatted when it's enabled, but the arguments are
+         *       evaluated before the check, prefer LUMI_LOG_INFO so filtered calls cost nothing
          */
         template<typename ...Args>
-        void LogInfo(const std::string& msg, Args&&... args)
+        void LogInfo(const LogFormat& msg, Args&&... args)
         {
-            std::string formatted = std::vformat(msg, std::make_format_args(args...));
-            Write(LogType::Info, formatted);
+            if constexpr (IsLogCompiledIn<LogCore>(LogType::Info))
+            {
+                if (LogCore::instance.IsEnabled(LogType::Info))
+                    Log(LogCore::instance, LogType::Info, msg, args...);
+            }
         }
 
         /**
          * \brief Logs a message to the console with the warn severity
+         * \note Messages go to the "core" category
          */
         template<typename ...Args>
-        void LogWarn(const std::string& msg, Args&&... args)
+        void LogWarn(const LogFormat& msg, Args&&... args)
         {
-            std::string formatted = std::vformat(msg, std::make_format_args(args...));
-            Write(LogType::Warn, formatted);
+            if constexpr (IsLogCompiledIn<LogCore>(LogType::Warn))
+            {
+                if (LogCore::instance.IsEnabled(LogType::Warn))
+                    Log(LogCore::instance, LogType::Warn, msg, args...);
+            }
         }
 
         /**
          * \brief Logs a message to the console with the error severity
          * \note Error is the highest severity
+         * \note Messages go to the "core" category
+         */
+        template<typename ...Args>
+        void LogError(const LogFormat& msg, Args&&... args)
+        {
+            if constexpr (IsLogCompiledIn<LogCore>(LogType::Error))
+            {
+                if (LogCore::instance.IsEnabled(LogType::Error))
+                    Log(LogCore::instance, LogType::Error, msg, args...);
+            }
+        }
+
+        /**
+         * \brief Logs a message with the given category and severity
+         * \note With deferred formatting enabled only the raw arguments are copied here, formatting happens on the consumer
+         * \warning This doesn't check the category's level, use the LUMI_LOG_* macros instead of calling this directly
+         */
+        template<typename ...Args>
+        void Log(const LogCategory& category, const LogType& logType, const LogFormat& msg, const Args&... args)
+        {
+            if (IsDeferredFormatting() && LogFormatRegistry::Instance().Register(msg))
+            {
+                WriteDeferred(category, logType, msg, args...);
+                return;
+            }
+
+            std::string formatted = std::vformat(msg.text, std::make_format_args(args...));
+            Write(category, logType, formatted);
+        }
+
+        /**
+         * \brief Logs a message unless the same message was written by this call site within interval
+         * \note When a message gets through after repeats were suppressed, a summary line with the count is written first.
+         *       Repeats of messages the limiter forgot, and those still pending on Flush, are summarized as well.
+         * \warning Use LUMI_LOG_*_RATE_LIMITED instead of calling this directly, they give each call site and thread its own limiter
          */
         template<typename ...Args>
-        void LogError(const std::string& msg, Args&&... args)
+        void LogRateLimited(LogRateLimiter& limiter, std::chrono::nanoseconds interval,
+            const LogCategory& category, const LogType& logType, const LogFormat& msg, const Args&... args)
+        {
+            if (!limiter.registered)
+            {
+                RegisterRateLimiter(limiter);
+            }
+
+            LogArgHasher hasher(msg.id);
+            (hasher.Add(args), ...);
+
+            LogSuppressed repeats;
+            LogSuppressed evicted;
+            if (!limiter.Allow(hasher.GetHash(), interval, { &category, logType, msg.text }, repeats, evicted))
+            {
+                return;
+            }
+
+            WriteSuppressed(evicted);
+            WriteSuppressed(repeats);
+            Log(category, logType, msg, args...);
+        }
+
+        /**
+         * \brief Changes the runtime level of a category by name
+         * 
+         * \return true The category exists and was changed
+         * \return false No category has that name
+         */
+        bool SetCategoryLevel(std::string_view name, const LogType level)
         {
-            std::string formatted = std::vformat(msg, std::make_format_args(args...));
-            Write(LogType::Error, formatted);
+            LogCategory* category = LogCategory::Find(name);
+            if (!category)
+                return false;
+            category->SetLevel(level);
+            return true;
         }
+
+        /**
+         * \brief Moves console/sink output onto a background thread
+         * \details Messages are copied into a bounded lock-free ring buffer and written to the sinks in batches,
+         *          so logging threads never wait on console or file I/O
+         * \note Calling this while already asynchronous restarts the background thread with the new config
+         * \warning Start and stop asynchronous logging while no other threads are logging
+         *
+         * \param config How much memory the queue may use and what to do when it's full
+         */
+        void StartAsync(const AsyncLogConfig& config = {});
+
+        /**
+         * \brief Writes everything still queued and returns to synchronous logging
+         */
+        void StopAsync();
+
+        /**
+         * \brief Writes every queued message to the sinks and flushes them
+         * \note The queue is drained on the calling thread, so this is safe to use on shutdown and crash paths.
+         *       Repeats still pending in rate limiters are summarized first.
+         */
+        void Flush();
+
+        /**
+         * \brief Changes whether messages are formatted where they're logged or later by the consumer
+         * \details Deferred messages only serialize their arguments into a compact binary record tagged with the
+         *          compile-time ID of their format string. Text sinks format them on the logging thread when
+         *          synchronous and on the background thread when asynchronous, binary sinks never format them.
+         */
+        void SetDeferredFormatting(const bool deferred) { _deferred.store(deferred, std::memory_order_release); }
+
+        /**
+         * \brief Adds a sink that will receive every message
+         */
+        void AddSink(std::shared_ptr<ILogSink> sink);
+
+        /**
+         * \brief Removes a sink added with AddSink, flushing it first
+         */
+        void RemoveSink(const std::shared_ptr<ILogSink>& sink);
+
+        /**
+         * \brief Removes every sink, including the default console sink
+         */
+        void ClearSinks();
+
+        [[nodiscard]] bool IsAsync() const { return _async.load(std::memory_order_acquire); }
+        [[nodiscard]] bool IsDeferredFormatting() const { return _deferred.load(std::memory_order_acquire); }
+
+        /* Number of messages discarded because the async buffer was full */
+        [[nodiscard]] uint64_t GetDroppedCount() const { return _dropped.load(std::memory_order_relaxed); }
     private:
-        void Write(const LogType& logType, const std::string& msg)
+        friend class LogRateLimiter;
+
+        Logger();
+        ~Logger();
+
+        std::vector<std::shared_ptr<ILogSink>> _sinks;
+        std::mutex _sinkMutex;
+
+        std::unique_ptr<LogRingBuffer> _ring;
+        AsyncLogConfig _config;
+        std::atomic<bool> _async = false;
+        std::atomic<bool> _deferred = false;
+        std::atomic<bool> _running = false;
+        std::atomic<uint64_t> _dropped = 0;
+        std::thread _worker;
+        std::mutex _wakeMutex;
+        std::condition_variable _wake;
+
+        /* Reused by the consumer when formatting deferred records */
+        std::string _scratch;
+
+        /* Every rate limiter that was used, so their pending repeats can be summarized on Flush */
+        std::vector<LogRateLimiter*> _rateLimiters;
+        std::mutex _rateLimiterMutex;
+
+        template<typename ...Args>
+        void WriteDeferred(const LogCategory& category, const LogType& logType, const LogFormat& msg, const Args&... args)
+        {
+            auto fill = [&](LogRecord& record)
+            {
+                StampRecord(record, category, logType);
+                record.kind = LogRecordKind::Binary;
+                record.formatId = msg.id;
+
+                LogArgWriter writer(record.message, sizeof(record.message));
+                (writer.Write(args), ...);
+                record.length = static_cast<uint16_t>(writer.GetSize());
+            };
+
+            if (IsAsync())
+            {
+                Enqueue(fill);
+                return;
+            }
+
+            LogRecord record;
+            fill(record);
+            WriteRecord(record);
+        }
+
+        template<typename Fill>
+        void Enqueue(Fill&& fill)
         {
-            // TODO: Add traits to severities
-            std::string prefix;
-            switch (logType)
+            if (_ring->TryPush(fill))
             {
-                case LogType::Info:
-                    prefix = "INFO";
+                return;
+            }
+
+            switch (_config.overflowPolicy)
+            {
+                case LogOverflowPolicy::Drop:
+                {
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
                     break;
-                case LogType::Warn:
-                    prefix = "WARN";
+                }
+                case LogOverflowPolicy::Block:
+                {
+                    _wake.notify_one();
+                    while (!_ring->TryPush(fill))
+                    {
+                        std::this_thread::yield();
+                    }
                     break;
-                case LogType::Error:
-                    prefix = "ERROR";
+                }
+                case LogOverflowPolicy::Overwrite:
+                {
+                    // Evict the oldest record, another producer may take the freed record first so keep trying
+                    LogRecord evicted;
+                    do
+                    {
+                        if (_ring->TryPop(evicted))
+                        {
+                            _dropped.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    } while (!_ring->TryPush(fill));
                     break;
+                }
             }
-            std::cout << "[" << prefix << "]: " << msg << std::endl;
         }
+
+        void Write(const LogCategory& category, const LogType& logType, const std::string& msg);
+
+        void RegisterRateLimiter(LogRateLimiter& limiter);
+        void UnregisterRateLimiter(LogRateLimiter& limiter);
+        /* Writes the summary line of suppressed repeats, nothing if none were suppressed */
+        void WriteSuppressed(const LogSuppressed& suppressed);
+        /* Summarizes the repeats every rate limiter still has pending */
+        void FlushRateLimiters();
+        void StampRecord(LogRecord& record, const LogCategory& category, const LogType& logType);
+
+        /* Writes a record to the sinks immediately */
+        void WriteRecord(const LogRecord& record);
+
+        /* Converts a record to a message and writes it to the sinks, the sink mutex must be held */
+        void DispatchRecord(const LogRecord& record);
+        void WriteToSinks(const LogMessage& message);
+        void FlushSinks();
+
+        /* Writes up to batchSize queued records, the sink mutex must be held */
+        size_t DrainBatch();
+        void WorkerLoop();
     };
-}
\ No newline at end of file
+}
+
+/**
+ * Logs through a category declared with LUMI_DECLARE_LOG_CATEGORY.
+ * Severities below the compile-time minimum compile to nothing, severities below the category's
+ * runtime level return before the arguments are evaluated, copied or formatted.
+ */
+#define LUMI_LOG(category, logType, ...) \
+    do \
+    { \
+        if constexpr (::lumi::debugging::IsLogCompiledIn<category>(logType)) \
+        { \
+            if (category::instance.IsEnabled(logType)) \
+            { \
+                ::lumi::debugging::Logger::Instance().Log(category::instance, logType, __VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+#define LUMI_LOG_INFO(category, ...) LUMI_LOG(category, ::lumi::debugging::LogType::Info, __VA_ARGS__)
+#define LUMI_LOG_WARN(category, ...) LUMI_LOG(category, ::lumi::debugging::LogType::Warn, __VA_ARGS__)
+#define LUMI_LOG_ERROR(category, ...) LUMI_LOG(category, ::lumi::debugging::LogType::Error, __VA_ARGS__)
+
+/**
+ * Like LUMI_LOG, but repeats of the same message (same call site, thread and arguments) within interval are
+ * suppressed and summarized by the next one written. Use these on paths that run every frame.
+ */
+#define LUMI_LOG_RATE_LIMITED(category, logType, interval, ...) \
+    do \
+    { \
+        if constexpr (::lumi::debugging::IsLogCompiledIn<category>(logType)) \
+        { \
+            if (category::instance.IsEnabled(logType)) \
+            { \
+                static thread_local ::lumi::debugging::LogRateLimiter lumiRateLimiter; \
+                ::lumi::debugging::Logger::Instance().LogRateLimited( \
+                    lumiRateLimiter, interval, category::instance, logType, __VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+#define LUMI_LOG_INFO_RATE_LIMITED(category, interval, ...) \
+    LUMI_LOG_RATE_LIMITED(category, ::lumi::debugging::LogType::Info, interval, __VA_ARGS__)
+#define LUMI_LOG_WARN_RATE_LIMITED(category, interval, ...) \
+    LUMI_LOG_RATE_LIMITED(category, ::lumi::debugging::LogType::Warn, interval, __VA_ARGS__)
+#define LUMI_LOG_ERROR_RATE_LIMITED(category, interval, ...) \
+    LUMI_LOG_RATE_LIMITED(category, ::lumi::debugging::LogType::Error, interval, __VA_ARGS__)
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include "log_sink.h"
+
+namespace lumi::debugging
+{
+    struct MappedFileLogConfig
+    {
+        /* Path of the active log file, rotated files get ".1", ".2"... appended */
+        std::string path = "lumi.log";
+        /* Bytes preallocated and mapped for each file */
+        size_t fileSize = 16 * 1024 * 1024;
+        /* Total files kept, including the active one */
+        uint32_t maxFiles = 4;
+    };
+
+    /**
+     * \brief Writes text lines into a preallocated, memory-mapped file
+     * \details Writing a line is a format into mapped memory, no system calls are made until the file is full and rotated.
+     *          The first byte of every line is stored last, so after a crash the file is recovered up to the last
+     *          complete line when it's reopened.
+     * \note Flush() does nothing, the mapped pages already belong to the OS and survive the process crashing
+     */
+    class MappedFileLogSink : public ILogSink
+    {
+    public:
+        explicit MappedFileLogSink(const MappedFileLogConfig& config);
+        ~MappedFileLogSink() override;
+
+        MappedFileLogSink(const MappedFileLogSink&) = delete;
+        MappedFileLogSink& operator=(const MappedFileLogSink&) = delete;
+
+        void Write(const LogMessage& message) override;
+        void Flush() override {}
+
+        [[nodiscard]] bool IsOpen() const { return _view != nullptr; }
+
+        /* Bytes of the active file used by complete lines */
+        [[nodiscard]] size_t GetWrittenSize() const { return _offset; }
+    private:
+        MappedFileLogConfig _config;
+        char* _view = nullptr;
+        size_t _capacity = 0;
+        size_t _offset = 0;
+
+        #ifdef _WIN32
+        void* _file = nullptr;
+        void* _mapping = nullptr;
+        #else
+        int _file = -1;
+        #endif
+
+        /**
+         * \brief Opens and maps the active file, recovering any lines left by a previous run
+         */
+        bool Open();
+
+        /**
+         * \brief Unmaps the active file and trims it to the lines written
+         */
+        void Close();
+
+        /**
+         * \brief Closes the active file, shifts the rotated files and opens a new active file
+         */
+        bool Rotate();
+
+        /* Finds the end of the last complete line and clears anything after it */
+        void Recover(size_t usedSize);
+    };
+}
\ No newline at end of file
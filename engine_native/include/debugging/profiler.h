@@ -0,0 +1,195 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <debugging/alloc_tracker.h>
+
+/**
+ * Whether profiler zones are compiled into the engine.
+ * When 0 the LUMI_PROFILE_* macros compile to nothing and captures stay empty.
+ */
+#ifndef LUMI_PROFILER_ENABLED
+    #ifdef NDEBUG
+        #define LUMI_PROFILER_ENABLED 0
+    #else
+        #define LUMI_PROFILER_ENABLED 1
+    #endif
+#endif
+
+namespace lumi::debugging
+{
+    /* Profiler timestamps in nanoseconds from a monotonic clock */
+    inline uint64_t ProfilerNow()
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            ).count()
+        );
+    }
+
+    /* One finished zone, sized to a cache line */
+    struct ProfileEvent
+    {
+        uint64_t start;
+        uint64_t end;
+        uint32_t index;
+        /* Heap activity on the recording thread inside the zone, zero unless the allocation hooks are linked */
+        uint32_t allocations;
+        uint32_t allocBytes;
+        char name[36];
+    };
+    static_assert(sizeof(ProfileEvent) == 64);
+
+    inline constexpr uint32_t kProfileNoIndex = ~0u;
+    inline constexpr size_t kProfileEventsPerThread = 16384;
+
+    /* Events recorded by one thread, only that thread writes to it */
+    struct ProfilerThreadBuffer
+    {
+        std::unique_ptr<ProfileEvent[]> events = std::make_unique<ProfileEvent[]>(kProfileEventsPerThread);
+        /* Total events ever recorded, the slot written next is head % kProfileEventsPerThread */
+        std::atomic<uint64_t> head = 0;
+        /* Value of head when the current capture started */
+        uint64_t captureStart = 0;
+        uint32_t threadIndex = 0;
+        std::string threadName;
+    };
+
+    /**
+     * \brief Collects timed zones from every thread over a number of frames
+     * \details Zones are written to a ring buffer owned by the thread that recorded them, so recording never locks.
+     *          A capture starts on the frame marker after StartCapture and ends after the requested number of frames.
+     */
+    class Profiler
+    {
+    public:
+        static Profiler& Instance()
+        {
+            static Profiler inst;
+            return inst;
+        }
+
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+
+        /* Checked by every zone, kept static so it's a single load */
+        [[nodiscard]] static bool IsCapturing() { return s_capturing.load(std::memory_order_relaxed); }
+
+        /**
+         * \brief Captures the next frameCount frames, starting at the next frame marker
+         * \note Starting a new capture discards the previous one
+         */
+        void StartCapture(uint32_t frameCount);
+
+        /**
+         * \brief Ends the current capture early
+         */
+        void StopCapture();
+
+        /**
+         * \brief Marks the boundary between two frames
+         * \note Call this once per frame from the thread running the main loop, use LUMI_PROFILE_FRAME
+         */
+        void MarkFrame();
+
+        /**
+         * \brief Names the calling thread in exported traces
+         */
+        void SetThreadName(std::string_view name);
+
+        /**
+         * \brief Records a finished zone on the calling thread
+         * \note Names longer than the event's buffer are cut off
+         */
+        void Record(std::string_view name, uint64_t start, uint64_t end, uint32_t index = kProfileNoIndex,
+            uint64_t allocations = 0, uint64_t allocBytes = 0);
+
+        /**
+         * \brief Writes the last capture as Chrome trace event JSON, viewable in chrome://tracing or Perfetto
+         * \warning Call this after the capture has finished
+         *
+         * \return true The trace was written
+         * \return false The file couldn't be opened or nothing was captured
+         */
+        bool ExportChromeTrace(const std::string& path);
+
+        /* Number of frames completed by the current or last capture */
+        [[nodiscard]] size_t GetCapturedFrameCount();
+
+        /* Events lost because a thread recorded more than its buffer holds during a capture */
+        [[nodiscard]] uint64_t GetOverwrittenCount();
+    private:
+        Profiler() = default;
+        ~Profiler() = default;
+
+        static inline std::atomic<bool> s_capturing = false;
+
+        std::mutex _mutex;
+        std::vector<std::unique_ptr<ProfilerThreadBuffer>> _threads;
+        /* Timestamps of the frame markers in the capture, the first one starts it */
+        std::vector<uint64_t> _frames;
+        uint32_t _pendingFrames = 0;
+        uint32_t _remainingFrames = 0;
+
+        ProfilerThreadBuffer& GetThreadBuffer();
+        void BeginCapture(uint64_t now);
+    };
+
+    /* Times its scope and records it when capturing, use LUMI_PROFILE_ZONE */
+    class ProfileZone
+    {
+    public:
+        explicit ProfileZone(std::string_view name, uint32_t index = kProfileNoIndex)
+        {
+            if (Profiler::IsCapturing())
+            {
+                _name = name;
+                _index = index;
+                _allocs = AllocTracker::GetThreadStats();
+                _start = ProfilerNow();
+            }
+        }
+
+        ~ProfileZone()
+        {
+            if (_start != 0)
+            {
+                uint64_t end = ProfilerNow();
+                const AllocStats& allocs = AllocTracker::GetThreadStats();
+                Profiler::Instance().Record(_name, _start, end, _index,
+                    allocs.allocations - _allocs.allocations, allocs.bytes - _allocs.bytes);
+            }
+        }
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+    private:
+        std::string_view _name;
+        uint64_t _start = 0;
+        uint32_t _index = kProfileNoIndex;
+        AllocStats _allocs;
+    };
+}
+
+#define LUMI_PROFILE_CONCAT_INNER(a, b) a##b
+#define LUMI_PROFILE_CONCAT(a, b) LUMI_PROFILE_CONCAT_INNER(a, b)
+
+#if LUMI_PROFILER_ENABLED
+    /* Times the rest of the enclosing scope, name only has to live until the scope ends */
+    #define LUMI_PROFILE_ZONE(name) \
+        ::lumi::debugging::ProfileZone LUMI_PROFILE_CONCAT(lumiProfileZone, __LINE__)(name)
+    /* Like LUMI_PROFILE_ZONE, with an index (frame, target...) shown in the trace's arguments */
+    #define LUMI_PROFILE_ZONE_INDEX(name, index) \
+        ::lumi::debugging::ProfileZone LUMI_PROFILE_CONCAT(lumiProfileZone, __LINE__)(name, static_cast<uint32_t>(index))
+    #define LUMI_PROFILE_FRAME() ::lumi::debugging::Profiler::Instance().MarkFrame()
+#else
+    #define LUMI_PROFILE_ZONE(name) ((void)0)
+    #define LUMI_PROFILE_ZONE_INDEX(name, index) ((void)0)
+    #define LUMI_PROFILE_FRAME() ((void)0)
+#endif
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+namespace lumi::gfx
+{
+    /* The graphics API behind a device and everything it creates */
+    enum class Backend : uint8_t
+    {
+        Null,
+        D3D12
+    };
+
+    /**
+     * \brief Casts an interface to the backend class behind it by checking its backend tag, without RTTI
+     * \note To declares `static constexpr Backend kBackend` and is the only class of its backend implementing From
+     *
+     * \return The backend object, or nullptr if object is null or belongs to another backend
+     */
+    template<typename To, typename From>
+    [[nodiscard]] To* BackendCast(From* object)
+    {
+        if (!object || object->GetBackend() != To::kBackend)
+        {
+            return nullptr;
+        }
+        return static_cast<To*>(object);
+    }
+}
\ No newline at end of file
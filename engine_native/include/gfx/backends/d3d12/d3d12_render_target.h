@@ -1,9 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <gfx/backends/d3d12/resources/d3d12_image_buffer.h>
 #include <gfx/render_target.h>
 #include <sys/window_manager.h>
 #include <gfx/backends/d3d12/resources/d3d12_sync.h>
+#include <gfx/backends/d3d12/resources/d3d12_timing_queries.h>
 #include "d3d12_device.h"
 
 namespace lumi::gfx::d3d12
@@ -12,10 +15,13 @@ namespace lumi::gfx::d3d12
     using resources::D3D12ImageBuffer;
     using resources::ImageState;
     using resources::D3D12Sync;
+    using resources::D3D12TimingQueries;
 
-    class D3D12RenderTarget : public IRenderTarget
+    class D3D12RenderTarget final : public IRenderTarget
     {
     public:
+        static constexpr Backend kBackend = Backend::D3D12;
+
         D3D12RenderTarget(D3D12Device& device, sys::WinPtr& window);
         ~D3D12RenderTarget();
 
@@ -27,15 +33,23 @@ namespace lumi::gfx::d3d12
         bool OutOfDate() const override;
         void Cleanup() override;
 
-        int GetWidth() override { return _window->GetWidth(); }
-        int GetHeight() override { return _window->GetHeight(); }
+        /* The area frames render into, the swap chain buffers can be larger while a shrink waits for the policy */
+        int GetWidth() override { return _resizePolicy.GetRenderWidth(); }
+        int GetHeight() override { return _resizePolicy.GetRenderHeight(); }
 
-        [[nodiscard]] ComPtr<ID3D12CommandAllocator> GetCommandAllocator(const uint32_t index) { return _commandAllocators[index]; }
-        [[nodiscard]] ComPtr<ID3D12GraphicsCommandList> GetCommandList(const uint32_t index) { return _commandLists[index]; }
+        [[nodiscard]] const ComPtr<ID3D12CommandAllocator>& GetCommandAllocator(const uint32_t index) { return _commandAllocators[index]; }
+        [[nodiscard]] const ComPtr<ID3D12GraphicsCommandList>& GetCommandList(const uint32_t index) { return _commandLists[index]; }
         [[nodiscard]] std::shared_ptr<IImageBuffer> GetColorBuffer(const uint32_t index) override { return _colorBuffers[index]; }
         [[nodiscard]] D3D12_CPU_DESCRIPTOR_HANDLE GetRTVColorHandle(const uint32_t index) { return _colorBuffers[index]->GetRTVHandle(); }
         [[nodiscard]] std::shared_ptr<IImageBuffer> GetDepthBuffer(const uint32_t index) override { return _depthBuffers[index]; }
         [[nodiscard]] D3D12_CPU_DESCRIPTOR_HANDLE GetRTVDepthHandle(const uint32_t index) { return _depthBuffers[index]->GetRTVHandle(); }
+        [[nodiscard]] D3D12TimingQueries& GetTimings() override { return _timings; }
+        [[nodiscard]] D3D12Sync& GetSync() override { return *_sync; }
+
+        /* Time the last frame spent presenting and waiting in StartRendering for its index to be free */
+        [[nodiscard]] std::chrono::nanoseconds GetPresentWaitTime() const { return _presentWaitTime; }
+        /* Time the last StartRendering waited for the GPU to finish the frame that used its index before */
+        [[nodiscard]] std::chrono::nanoseconds GetFrameWaitTime() const { return _frameWaitTime; }
     private:
         D3D12Device& _device;
         sys::WinPtr& _window;
@@ -45,8 +59,21 @@ namespace lumi::gfx::d3d12
         std::vector<std::shared_ptr<D3D12ImageBuffer>> _colorBuffers;
         std::vector<std::shared_ptr<D3D12ImageBuffer>> _depthBuffers;
         std::shared_ptr<D3D12Sync> _sync;
+        /* The fence value the last frame submitted with each index signals */
+        std::vector<uint64_t> _frameValues;
+        D3D12TimingQueries _timings{_device};
+
+        /* Written by the window's change callback, StartRendering compares it against the generation it last applied */
+        std::atomic<uint64_t> _windowGeneration{0};
+        std::atomic<uint32_t> _windowChanges{0};
+        uint64_t _appliedGeneration = 0;
+        sys::WindowSubscription _windowSubscription = sys::kInvalidWindowSubscription;
 
         uint32_t _maxFramesInFlight = 0;
+        std::chrono::nanoseconds _presentWaitTime{};
+        std::chrono::nanoseconds _frameWaitTime{};
+
+        void OnWindowChanged(const sys::WindowChangeEvent& event);
 
         bool CreateSync();
         bool CreateSwapChain();
@@ -1,11 +1,19 @@
+#include <array>
+#include <span>
 #include <gfx/render/render_context.h>
 #include <d3d12.h>
 
+namespace lumi::gfx::d3d12
+{
+    class D3D12RenderTarget;
+}
+
 #include <wrl/client.h>
 using Microsoft::WRL::ComPtr;
 
 namespace lumi::gfx::d3d12::render
 {
+    using gfx::render::CommandBuffer;
     using gfx::render::IRenderContext;
     using gfx::render::RenderInfo;
     using gfx::render::RenderColorInfo;
@@ -14,16 +22,35 @@ namespace lumi::gfx::d3d12::render
     using gfx::render::RenderStoreOp;
     using gfx::render::Viewport;
     using gfx::render::Scissor;
+    using gfx::render::kMaxColorAttachments;
+    using gfx::resources::IImageBuffer;
+    using gfx::resources::ImageState;
     
 
-    class D3D12RenderContext : public IRenderContext
+    class D3D12RenderContext final : public IRenderContext
     {
     public:
         void SetRenderTarget(IRenderTarget& window) override;
         void BeginRecording(const RenderInfo& info) override;
         void EndRecording(const RenderInfo& info) override;
+        void Transition(IImageBuffer& image, const ImageState& state) override;
+        void Alias(IImageBuffer& image, const ImageState& state) override;
+        /* Replays straight into the command list of the target the buffer sets */
+        void Execute(const CommandBuffer& commands) override;
+        /* Writes timestamp queries into the current target's command list */
+        void BeginTiming(std::string_view name) override;
+        void EndTiming() override;
     private:
+        D3D12RenderTarget* _renderTarget = nullptr;
         ComPtr<ID3D12CommandAllocator> _commandAllocator;
         ComPtr<ID3D12GraphicsCommandList> _commandList;
+
+        /* The pieces begin and end recording are made of, shared with command replay */
+        void BindAttachments(std::span<IImageBuffer* const> color);
+        void SetViewport(const Viewport& viewport);
+        void SetScissor(const Scissor& scissor);
+        void ClearColor(IImageBuffer* image, const std::array<float, 4>& color);
+        void ClearDepthStencil(IImageBuffer* image, float depth, UINT8 stencil);
+        void Discard(IImageBuffer* image);
     };
 }
\ No newline at end of file
@@ -18,22 +18,40 @@ namespace lumi::gfx::d3d12::resources
     using gfx::resources::ImageUsage;
     using gfx::resources::ImageDesc;
 
-    class D3D12ImageBuffer : public IImageBuffer
+    class D3D12ImageBuffer final : public IImageBuffer
     {
     public:
+        static constexpr Backend kBackend = Backend::D3D12;
+
         D3D12ImageBuffer(D3D12Device& device);
         D3D12ImageBuffer(D3D12Device& device, ComPtr<ID3D12Resource> buffer);
         ~D3D12ImageBuffer() override;
 
         bool Create() override;
 
+        /**
+         * \brief Creates the image inside a heap instead of giving it its own memory
+         *
+         * \param heap The heap to place the image in
+         * \param offset Where the image starts in the heap, aligned to the image's placement alignment
+         */
+        bool CreatePlaced(ComPtr<ID3D12Heap> heap, UINT64 offset);
+
         void SetCommandList(ComPtr<ID3D12GraphicsCommandList> commandList) { _commandList = commandList; }
 
         void Transition(const ImageState& toState) override;
+        /**
+         * \brief Records an aliasing barrier into this image, then discards it in its first state
+         * \note The transition still starts from the state the image was left in, D3D12 tracks placed resources' states
+         *       across aliasing
+         */
+        void Alias(const ImageState& toState) override;
 
         void Destroy() override;
         
-        [[nodiscard]] void* Get() { return _res.Get(); }
+        [[nodiscard]] void* Get() override { return _res.Get(); }
+        /* Get without the virtual call, for the recording path */
+        [[nodiscard]] ID3D12Resource* GetResource() const { return _res.Get(); }
         [[nodiscard]] D3D12_CPU_DESCRIPTOR_HANDLE GetRTVHandle() { return _handle; }
     private:
         D3D12Device& _device;
@@ -42,5 +60,7 @@ namespace lumi::gfx::d3d12::resources
         ComPtr<ID3D12GraphicsCommandList> _commandList;
         
         int _rtvIndex = 0;
+
+        bool CreateResource(ComPtr<ID3D12Heap> heap, UINT64 offset);
     };
 }
\ No newline at end of file
@@ -1,26 +1,32 @@
 #pragma once
 
 #include <gfx/backends/d3d12/d3d12_device.h>
+#include <gfx/resources/sync.h>
 
 namespace lumi::gfx::d3d12::resources
 {
-    class D3D12Sync
+    using gfx::resources::ISync;
+
+    /**
+     * \brief A fence the device's command queue signals, the values are the fence's
+     * \note A signal the queue rejects is logged and returns the last value that was queued instead of a new one
+     */
+    class D3D12Sync final : public ISync
     {
     public:
-        ~D3D12Sync();
+        ~D3D12Sync() override;
 
-        bool Init(D3D12Device& device, int frameCount);
-        void Signal(ID3D12CommandQueue* queue, int frameIndex);
-        void WaitForFrame(int frameIndex);
-        void AdvanceFrame();
+        bool Init(D3D12Device& device);
         void Destroy();
 
-        UINT64 GetFenceValue(int frameIndex) const;
+        uint64_t Signal() override;
+        bool Wait(uint64_t value, std::chrono::nanoseconds timeout = kWaitForever) override;
+        [[nodiscard]] uint64_t GetCompletedValue() const override;
+        [[nodiscard]] uint64_t GetSignaledValue() const override { return _signaledValue; }
     private:
         ComPtr<ID3D12Fence> _fence;
-        std::vector<UINT64> _fenceValues;
+        ComPtr<ID3D12CommandQueue> _queue;
         HANDLE _fenceEvent = nullptr;
-        int _frameCount = 0;
-        int _currentFrame = 0;
+        UINT64 _signaledValue = 0;
     };
 }
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+#include <gfx/backends/d3d12/d3d12_device.h>
+#include <gfx/render/timing_queries.h>
+
+namespace lumi::gfx::d3d12::resources
+{
+    using gfx::render::TimingQueries;
+
+    /* Timestamp query heaps and readback buffers, one of each per frame in flight */
+    class D3D12TimingQueries final : public TimingQueries
+    {
+    public:
+        explicit D3D12TimingQueries(D3D12Device& device) : _device(device) {}
+        ~D3D12TimingQueries() override;
+
+        bool Create(uint32_t frameCount);
+        void Destroy();
+
+        /* Records a timestamp into a query, does nothing for kInvalidQuery */
+        void Write(ID3D12GraphicsCommandList* commandList, uint32_t frame, uint32_t query);
+
+        /* Copies the frame's timestamps to its readback buffer, record it last before closing the command list */
+        void Resolve(ID3D12GraphicsCommandList* commandList, uint32_t frame);
+    protected:
+        bool ReadTimestamps(uint32_t frame, std::span<uint64_t> nanoseconds) override;
+    private:
+        D3D12Device& _device;
+        std::vector<ComPtr<ID3D12QueryHeap>> _heaps;
+        std::vector<ComPtr<ID3D12Resource>> _readback;
+        /* Ticks per second of the command queue's timestamps */
+        UINT64 _frequency = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <gfx/resources/transient_allocator.h>
+
+namespace lumi::gfx::d3d12
+{
+    class D3D12Device;
+}
+
+namespace lumi::gfx::d3d12::resources
+{
+    using Microsoft::WRL::ComPtr;
+    using gfx::resources::IImageBuffer;
+    using gfx::resources::ImageDesc;
+    using gfx::resources::ImageMemoryRequirements;
+    using gfx::resources::ITransientAllocator;
+
+    /**
+     * \brief Places render and depth targets in one ID3D12Heap
+     * \note The heap only allows render target and depth stencil textures, so it works on resource heap tier 1
+     */
+    class D3D12TransientAllocator : public ITransientAllocator
+    {
+    public:
+        explicit D3D12TransientAllocator(D3D12Device& device) : _device(device) {}
+        ~D3D12TransientAllocator() override { Release(); }
+
+        [[nodiscard]] ImageMemoryRequirements GetRequirements(const ImageDesc& desc) override;
+        bool Reserve(uint64_t size) override;
+        [[nodiscard]] std::unique_ptr<IImageBuffer> CreateImage(const ImageDesc& desc, uint64_t offset) override;
+        void Release() override;
+
+        [[nodiscard]] uint64_t GetHeapSize() const override { return _heapSize; }
+    private:
+        D3D12Device& _device;
+        ComPtr<ID3D12Heap> _heap;
+        uint64_t _heapSize = 0;
+    };
+}
\ No newline at end of file
@@ -13,4 +13,5 @@ namespace lumi::gfx::d3d12::utils
     ImageFormat FromD3D12Format(DXGI_FORMAT format);
     D3D12_RESOURCE_FLAGS ChooseD3D12Flags(const ImageUsage& usage);
     D3D12_RESOURCE_STATES ChooseD3D12State(const ImageState& state);
+    D3D12_RESOURCE_DESC ChooseD3D12ResourceDesc(const ImageDesc& desc);
 }
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <gfx/device.h>
+
+namespace lumi::gfx::null
+{
+    /* Operations counted by the null backend */
+    enum class NullOp : uint8_t
+    {
+        FramesStarted,
+        FramesEnded,
+        FramesSubmitted,
+        GpuWaits, /* A NullSync wait had to block for simulated GPU work */
+        Resizes,
+        RenderTargetsSet,
+        RecordingsBegun,
+        RecordingsEnded,
+        Transitions,
+        Aliases, /* Transient images aliased before their first use */
+        InvalidTransitions, /* Transitions rejected by validation */
+        InvalidRecordings, /* Recordings with attachments in the wrong state */
+        ImagesCreated,
+        ImagesDestroyed,
+        HeapsReserved, /* Transient heaps created */
+        Count
+    };
+
+    struct NullDeviceConfig
+    {
+        /* How long the simulated GPU takes to finish a submitted frame */
+        std::chrono::nanoseconds gpuLatency = std::chrono::nanoseconds(0);
+        /* Logs invalid transitions and recordings as errors, they're always counted */
+        bool logValidationErrors = true;
+    };
+
+    /**
+     * \brief A device that renders nothing, used to run and time the frame loop without a GPU
+     * \note Every operation made through the null backend is counted on its device
+     */
+    class NullDevice : public IDevice
+    {
+    public:
+        NullDevice() = default;
+        explicit NullDevice(const NullDeviceConfig& config) : _config(config) {}
+
+        bool Init() override;
+        void Cleanup() override;
+
+        void SetConfig(const NullDeviceConfig& config) { _config = config; }
+        [[nodiscard]] const NullDeviceConfig& GetConfig() const { return _config; }
+
+        void Count(const NullOp op) { _counts[static_cast<size_t>(op)].fetch_add(1, std::memory_order_relaxed); }
+        [[nodiscard]] uint64_t GetCount(const NullOp op) const { return _counts[static_cast<size_t>(op)].load(std::memory_order_relaxed); }
+        void ResetCounts();
+
+        [[nodiscard]] bool IsInitialized() const { return _initialized; }
+    private:
+        NullDeviceConfig _config;
+        std::array<std::atomic<uint64_t>, static_cast<size_t>(NullOp::Count)> _counts{};
+        bool _initialized = false;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <vector>
+#include <gfx/backends/null/render/null_timing_queries.h>
+#include <gfx/backends/null/resources/null_image_buffer.h>
+#include <gfx/backends/null/resources/null_sync.h>
+#include <gfx/render_target.h>
+#include "null_device.h"
+
+namespace lumi::gfx::null
+{
+    using resources::NullImageBuffer;
+    using resources::NullSync;
+    using resources::ImageState;
+    using render::NullTimingQueries;
+
+    /**
+     * \brief A render target with no window or swap chain
+     * \details Submitting a frame schedules its simulated GPU work to finish after the device's latency,
+     *          starting that frame index again waits for it like a real frame in flight would
+     */
+    class NullRenderTarget final : public IRenderTarget
+    {
+    public:
+        static constexpr Backend kBackend = Backend::Null;
+
+        NullRenderTarget(NullDevice& device, int width, int height);
+        ~NullRenderTarget();
+
+        bool Init(const uint32_t maxInFlight) override;
+        void Resize(const int width, const int height) override;
+        void StartRendering(const uint32_t index) override;
+        void EndRendering(const uint32_t index) override;
+        void SubmitRendering(const uint32_t index) override;
+        bool OutOfDate() const override;
+        void Cleanup() override;
+
+        /* The area frames render into, smaller than the images while a shrink waits for the policy */
+        int GetWidth() override { return _resizePolicy.GetRenderWidth(); }
+        int GetHeight() override { return _resizePolicy.GetRenderHeight(); }
+        [[nodiscard]] std::shared_ptr<IImageBuffer> GetColorBuffer(const uint32_t index) override { return _colorBuffers[index]; }
+        [[nodiscard]] std::shared_ptr<IImageBuffer> GetDepthBuffer(const uint32_t index) override { return _depthBuffers[index]; }
+        [[nodiscard]] NullTimingQueries& GetTimings() override { return _timings; }
+        [[nodiscard]] NullSync& GetSync() override { return _sync; }
+
+        /**
+         * \brief Simulates the window publishing a resize, the target is out of date until it starts rendering again
+         * \note The images are rebuilt when the resize policy allows it, not necessarily on the next frame
+         */
+        void SetRequestedSize(const int width, const int height)
+        {
+            _requestedWidth = width;
+            _requestedHeight = height;
+            ++_requestedGeneration;
+        }
+
+        /* Simulates the window's output format changing, like HDR being toggled, which rebuilds the images right away */
+        void SetFormatChanged()
+        {
+            _formatChanged = true;
+            ++_requestedGeneration;
+        }
+
+        /**
+         * \brief Makes the resize policy see time stand still at a fixed point instead of the steady clock
+         * \note Only resize decisions use it, frames still wait for the simulated GPU on the real clock
+         */
+        void PinTime(const std::chrono::steady_clock::time_point time) { _pinnedTime = time; }
+
+        [[nodiscard]] uint32_t GetMaxFramesInFlight() const { return _maxFramesInFlight; }
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        NullDevice& _device;
+        int _requestedWidth = 0;
+        int _requestedHeight = 0;
+        /* Like a window's generation, OutOfDate only compares it against the last one applied */
+        uint64_t _requestedGeneration = 0;
+        uint64_t _appliedGeneration = 0;
+        bool _formatChanged = false;
+        std::optional<Clock::time_point> _pinnedTime;
+        uint32_t _maxFramesInFlight = 0;
+
+        std::vector<std::shared_ptr<NullImageBuffer>> _colorBuffers;
+        std::vector<std::shared_ptr<NullImageBuffer>> _depthBuffers;
+        NullSync _sync{_device};
+        /* The value the last frame submitted with each index signals */
+        std::vector<uint64_t> _frameValues;
+        NullTimingQueries _timings;
+
+        [[nodiscard]] Clock::time_point Now() const { return _pinnedTime.value_or(Clock::now()); }
+        bool CreateImages();
+        void DestroyImages();
+
+        /* Blocks until the simulated GPU finishes the frame using index */
+        void WaitForFrame(uint32_t index);
+    };
+}
\ No newline at end of file
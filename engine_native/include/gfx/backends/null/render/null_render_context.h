@@ -0,0 +1,45 @@
+#pragma once
+
+#include <gfx/render/render_context.h>
+
+namespace lumi::gfx::null
+{
+    class NullDevice;
+    class NullRenderTarget;
+}
+
+namespace lumi::gfx::null::render
+{
+    using gfx::render::CommandBuffer;
+    using gfx::render::IRenderContext;
+    using gfx::render::RenderInfo;
+    using gfx::resources::IImageBuffer;
+    using gfx::resources::ImageState;
+
+    /* Records nothing, but checks that every attachment is in the state it's rendered in */
+    class NullRenderContext final : public IRenderContext
+    {
+    public:
+        explicit NullRenderContext(NullDevice& device) : _device(device) {}
+
+        void SetRenderTarget(IRenderTarget& window) override;
+        void BeginRecording(const RenderInfo& info) override;
+        void EndRecording(const RenderInfo& info) override;
+        void Transition(IImageBuffer& image, const ImageState& state) override;
+        void Alias(IImageBuffer& image, const ImageState& state) override;
+        void Execute(const CommandBuffer& commands) override;
+        /* Times with the CPU clock, so scopes measure how long recording took */
+        void BeginTiming(std::string_view name) override;
+        void EndTiming() override;
+
+        [[nodiscard]] NullRenderTarget* GetRenderTarget() const { return _renderTarget; }
+    private:
+        NullDevice& _device;
+        NullRenderTarget* _renderTarget = nullptr;
+        bool _recording = false;
+
+        static bool IsInState(const IImageBuffer* image, ImageState state) { return image && image->GetState() == state; }
+        void BeginPass(bool attachmentsValid);
+        void EndPass();
+    };
+}
\ No newline at end of file
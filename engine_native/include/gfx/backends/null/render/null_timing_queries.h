@@ -0,0 +1,47 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <gfx/render/timing_queries.h>
+
+namespace lumi::gfx::null::render
+{
+    using gfx::render::TimingQueries;
+
+    /* Timestamps from the CPU clock at the moment they're recorded, so scopes time recording instead of a GPU */
+    class NullTimingQueries final : public TimingQueries
+    {
+    public:
+        /* Writes the current time to a query, does nothing for kInvalidQuery */
+        void Write(const uint32_t frame, const uint32_t query)
+        {
+            if (query == kInvalidQuery)
+            {
+                return;
+            }
+
+            size_t slot = static_cast<size_t>(frame) * kMaxQueriesPerFrame + query;
+            if (slot >= _written.size())
+            {
+                _written.resize((static_cast<size_t>(frame) + 1) * kMaxQueriesPerFrame);
+            }
+            auto now = std::chrono::steady_clock::now().time_since_epoch();
+            _written[slot] = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+        }
+    protected:
+        bool ReadTimestamps(const uint32_t frame, const std::span<uint64_t> nanoseconds) override
+        {
+            size_t first = static_cast<size_t>(frame) * kMaxQueriesPerFrame;
+            if (first + nanoseconds.size() > _written.size())
+            {
+                return false;
+            }
+            std::copy_n(_written.begin() + static_cast<ptrdiff_t>(first), nanoseconds.size(), nanoseconds.begin());
+            return true;
+        }
+    private:
+        /* kMaxQueriesPerFrame timestamps per frame, grown to the highest frame written */
+        std::vector<uint64_t> _written;
+    };
+}
\ No newline at end of file
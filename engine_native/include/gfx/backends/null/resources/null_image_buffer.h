@@ -0,0 +1,52 @@
+#pragma once
+
+#include <gfx/resources/image_buffer.h>
+
+namespace lumi::gfx::null
+{
+    class NullDevice;
+}
+
+namespace lumi::gfx::null::resources
+{
+    using gfx::resources::IImageBuffer;
+    using gfx::resources::ImageFormat;
+    using gfx::resources::ImageState;
+    using gfx::resources::ImageUsage;
+    using gfx::resources::ImageDesc;
+
+    /**
+     * \brief An image with no memory behind it that validates its state transitions
+     * \note Transitions into a state the image's usage doesn't allow are rejected and leave the state unchanged
+     */
+    class NullImageBuffer final : public IImageBuffer
+    {
+    public:
+        static constexpr Backend kBackend = Backend::Null;
+
+        explicit NullImageBuffer(NullDevice& device);
+        ~NullImageBuffer() override;
+
+        bool Create() override;
+        void Transition(const ImageState& toState) override;
+        /* Moves straight into the state whatever the image was left in, the usage still has to allow it */
+        void Alias(const ImageState& toState) override;
+        void Destroy() override;
+
+        [[nodiscard]] void* Get() override { return _created ? this : nullptr; }
+
+        /**
+         * \brief Checks if an image with the given usage can be moved into a state
+         * 
+         * \return true The transition is allowed
+         * \return false The state is Undefined or isn't allowed by the usage
+         */
+        static bool IsTransitionValid(const ImageUsage& usage, const ImageState& toState);
+    private:
+        NullDevice& _device;
+        bool _created = false;
+
+        /* Counts and logs a transition validation rejected */
+        void RejectTransition(const ImageState& toState);
+    };
+}
\ No newline at end of file
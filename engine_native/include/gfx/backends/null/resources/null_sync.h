@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <gfx/resources/sync.h>
+
+namespace lumi::gfx::null
+{
+    class NullDevice;
+}
+
+namespace lumi::gfx::null::resources
+{
+    using gfx::resources::ISync;
+
+    /**
+     * \brief A timeline the simulated GPU reaches on the CPU clock
+     * \details Each signal completes the device's gpuLatency after the previous one did, or after it was signaled if
+     *          the simulated GPU was idle, so frames queue up behind each other like they would on a real queue.
+     * \note Safe to use from any thread
+     */
+    class NullSync final : public ISync
+    {
+    public:
+        explicit NullSync(NullDevice& device) : _device(device) {}
+
+        uint64_t Signal() override;
+        /* Counts a GPU wait on the device when it has to sleep */
+        bool Wait(uint64_t value, std::chrono::nanoseconds timeout = kWaitForever) override;
+        [[nodiscard]] uint64_t GetCompletedValue() const override;
+        [[nodiscard]] uint64_t GetSignaledValue() const override;
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        /* Drops signals that completed by now, the caller holds the lock */
+        void Retire(Clock::time_point now) const;
+
+        NullDevice& _device;
+        mutable std::mutex _mutex;
+        /* When each signal after _completedValue finishes, in order */
+        mutable std::vector<Clock::time_point> _pending;
+        mutable uint64_t _completedValue = 0;
+        uint64_t _signaledValue = 0;
+    };
+}
\ No newline at end of file
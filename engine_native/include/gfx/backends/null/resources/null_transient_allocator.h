@@ -0,0 +1,38 @@
+#pragma once
+
+#include <gfx/resources/transient_allocator.h>
+
+namespace lumi::gfx::null
+{
+    class NullDevice;
+}
+
+namespace lumi::gfx::null::resources
+{
+    using gfx::resources::IImageBuffer;
+    using gfx::resources::ImageDesc;
+    using gfx::resources::ImageMemoryRequirements;
+    using gfx::resources::ITransientAllocator;
+
+    /**
+     * \brief Places null images in a heap with no memory behind it
+     * \note Sizes and alignment follow D3D12's default 64KiB placement, so the planned heap size is realistic
+     */
+    class NullTransientAllocator : public ITransientAllocator
+    {
+    public:
+        static constexpr uint64_t kPlacementAlignment = 64 * 1024;
+
+        explicit NullTransientAllocator(NullDevice& device) : _device(device) {}
+
+        [[nodiscard]] ImageMemoryRequirements GetRequirements(const ImageDesc& desc) override;
+        bool Reserve(uint64_t size) override;
+        [[nodiscard]] std::unique_ptr<IImageBuffer> CreateImage(const ImageDesc& desc, uint64_t offset) override;
+        void Release() override { _heapSize = 0; }
+
+        [[nodiscard]] uint64_t GetHeapSize() const override { return _heapSize; }
+    private:
+        NullDevice& _device;
+        uint64_t _heapSize = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <core/frame_arena.h>
+#include <gfx/resources/image_buffer.h>
+#include "render_view.h"
+
+namespace lumi::gfx
+{
+    class IRenderTarget;
+}
+
+namespace lumi::gfx::render
+{
+    using resources::IImageBuffer;
+    using resources::ImageState;
+
+    enum class CommandType : uint8_t
+    {
+        SetRenderTarget,
+        BeginPass, /* Binds the attachments the following commands render to */
+        EndPass,
+        SetViewport,
+        SetScissor,
+        ClearColor,
+        ClearDepthStencil,
+        Discard, /* The image's contents aren't needed anymore */
+        Transition,
+        Alias, /* The image takes over memory it shares with other images */
+        BeginTiming,
+        EndTiming
+    };
+
+    /* Starts every command, size covers the whole command so the next one can be found without knowing the type */
+    struct CommandHeader
+    {
+        CommandType type;
+        uint16_t size;
+
+        template<typename Command>
+        [[nodiscard]] const Command& As() const { return static_cast<const Command&>(*this); }
+    };
+
+    struct SetRenderTargetCommand : CommandHeader
+    {
+        static constexpr CommandType kType = CommandType::SetRenderTarget;
+        IRenderTarget* target;
+    };
+
+    struct BeginPassCommand : CommandHeader
+    {
+        static constexpr CommandType kType = CommandType::BeginPass;
+        uint8_t colorCount;
+        IImageBuffer* depth;
+
+        /* The color images are stored right after the command */
+        [[nodiscard]] std::span<IImageBuffer* const> GetColor() const
+        {
+            return { reinterpret_cast<IImageBuffer* const*>(this + 1), colorCount };
+        }
+    };
+
+    struct EndPassCommand : CommandHeader
+    {
+        static constexpr CommandType kType = CommandType::EndPass;
+    };
+
+    struct SetViewportCommand : CommandHeader
+    {
+        static constexpr CommandType kType = CommandType::SetViewport;
+        Viewport viewport;
+    };
+
+    struct SetScissorCommand : CommandHeader
+    {
+        static constexpr CommandType kType = CommandType::SetScissor;
+        Scissor scissor;
+    };
+
+    struct ClearColorCommand : CommandHeader
+    {
+        static constexpr CommandType kType = CommandType::ClearColor;
+        IImageBuffer* image;
+        std::array<float, 4> color;
+    };
+
+    struct ClearDepthStencilCommand : CommandHeader
+    {
+        static constexpr CommandType kType = CommandType::ClearDepthStencil;
+        IImageBuffer* image;
+        float depth;
+        uint8_t stencil;
+    };
+
+    struct DiscardCommand : CommandHeader
+    {
+        static constexpr CommandType kType = CommandType::Discard;
+        IImageBuffer* image;
+    };
+
+    struct TransitionCommand : CommandHeader
+    {
+        static constexpr CommandType kType = CommandType::Transition;
+        IImageBuffer* image;
+        ImageState state;
+    };
+
+    struct AliasCommand : CommandHeader
+    {
+        static constexpr CommandType kType = CommandType::Alias;
+        IImageBuffer* image;
+        ImageState state;
+    };
+
+    struct BeginTimingCommand : CommandHeader
+    {
+        static constexpr CommandType kType = CommandType::BeginTiming;
+        std::string_view name;
+    };
+
+    struct EndTimingCommand : CommandHeader
+    {
+        static constexpr CommandType kType = CommandType::EndTiming;
+    };
+
+    /**
+     * \brief A packed stream of plain commands, recorded without touching any backend and replayed later
+     * \details Commands are written back to back into chunks taken from a linear arena, replaying walks them in order.
+     *          Nothing is tied to a thread, so any thread can record a buffer that a backend context executes later.
+     * \note Buffers recorded for a frame usually take a render target's frame arena, which is only reset once the GPU
+     *       is done with the frame (see RecordingRenderContext::RecordFrame)
+     * \warning The commands live in the arena, Clear the buffer whenever its arena is reset
+     */
+    class CommandBuffer
+    {
+        struct Chunk
+        {
+            Chunk* next;
+            uint32_t used;
+            uint32_t capacity;
+        };
+    public:
+        static constexpr size_t kDefaultChunkSize = 4096;
+        /* Every command starts at this alignment, enough for the pointers inside them */
+        static constexpr size_t kCommandAlignment = alignof(void*);
+
+        class Iterator
+        {
+        public:
+            Iterator(const Chunk* chunk, const uint32_t offset) : _chunk(chunk), _offset(offset) {}
+
+            [[nodiscard]] const CommandHeader& operator*() const
+            {
+                return *reinterpret_cast<const CommandHeader*>(reinterpret_cast<const std::byte*>(_chunk + 1) + _offset);
+            }
+
+            Iterator& operator++()
+            {
+                _offset += (**this).size;
+                if (_offset == _chunk->used)
+                {
+                    _chunk = _chunk->next;
+                    _offset = 0;
+                }
+                return *this;
+            }
+
+            bool operator!=(const Iterator& other) const { return _chunk != other._chunk || _offset != other._offset; }
+        private:
+            const Chunk* _chunk;
+            uint32_t _offset;
+        };
+
+        explicit CommandBuffer(core::LinearArena& arena, size_t chunkSize = kDefaultChunkSize);
+
+        void SetRenderTarget(IRenderTarget& target);
+        /**
+         * \brief Starts rendering to a set of attachments
+         *
+         * \param color The color images, the ones past kMaxColorAttachments are dropped and logged
+         * \param depth The depth image, can be null
+         */
+        void BeginPass(std::span<IImageBuffer* const> color, IImageBuffer* depth);
+        void EndPass();
+        void SetViewport(const Viewport& viewport);
+        void SetScissor(const Scissor& scissor);
+        void ClearColor(IImageBuffer& image, const std::array<float, 4>& color);
+        void ClearDepthStencil(IImageBuffer& image, float depth, uint8_t stencil);
+        void Discard(IImageBuffer& image);
+        void Transition(IImageBuffer& image, ImageState state);
+        void Alias(IImageBuffer& image, ImageState state);
+        /* name isn't copied, it must stay alive until the buffer is replayed */
+        void BeginTiming(std::string_view name);
+        void EndTiming();
+
+        /* Copies the commands of another buffer to the end of this one */
+        void Append(const CommandBuffer& other);
+
+        /* Forgets every command, the memory comes back when the arena resets */
+        void Clear();
+
+        [[nodiscard]] Iterator begin() const { return { _first, 0 }; }
+        [[nodiscard]] Iterator end() const { return { nullptr, 0 }; }
+
+        [[nodiscard]] size_t GetCommandCount() const { return _commandCount; }
+        /* Bytes taken by the commands, not counting the chunk headers */
+        [[nodiscard]] size_t GetSize() const { return _size; }
+        [[nodiscard]] bool IsEmpty() const { return _commandCount == 0; }
+    private:
+        core::LinearArena* _arena;
+        size_t _chunkSize;
+        Chunk* _first = nullptr;
+        Chunk* _last = nullptr;
+        size_t _commandCount = 0;
+        size_t _size = 0;
+
+        /* Gets aligned space at the end of the last chunk, chaining on a new chunk when it's full */
+        void* Reserve(size_t size);
+
+        template<typename Command>
+        Command& Push(const size_t trailingSize = 0)
+        {
+            static_assert(std::is_trivially_copyable_v<Command>, "Commands are copied and dropped as plain memory");
+
+            size_t size = (sizeof(Command) + trailingSize + kCommandAlignment - 1) & ~(kCommandAlignment - 1);
+            auto* command = ::new (Reserve(size)) Command{};
+            command->type = Command::kType;
+            command->size = static_cast<uint16_t>(size);
+            return *command;
+        }
+    };
+}
\ No newline at end of file
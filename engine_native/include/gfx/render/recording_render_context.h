@@ -0,0 +1,47 @@
+#pragma once
+
+#include <optional>
+#include "command_buffer.h"
+#include "render_context.h"
+
+namespace lumi::gfx::render
+{
+    /**
+     * \brief Writes every call into a command buffer instead of a backend's command list
+     * \details Safe to use on any thread, replay the buffer on a backend context with Execute afterwards.
+     *          Begin and end recording become separate attachment, view, clear and discard commands.
+     * \warning Nothing happens to the images until the buffer is replayed, so their states don't change while recording
+     */
+    class RecordingRenderContext final : public IRenderContext
+    {
+    public:
+        explicit RecordingRenderContext(CommandBuffer& commands) : _commands(&commands) {}
+
+        /* Records into the frame arena of target, see RecordFrame */
+        RecordingRenderContext(IRenderTarget& target, const uint32_t frame) { RecordFrame(target, frame); }
+
+        void SetRenderTarget(IRenderTarget& window) override;
+        void BeginRecording(const RenderInfo& info) override;
+        void EndRecording(const RenderInfo& info) override;
+        void Transition(IImageBuffer& image, const ImageState& state) override;
+        void Alias(IImageBuffer& image, const ImageState& state) override;
+        /* Appends the commands, they're replayed with the rest of this context's buffer */
+        void Execute(const CommandBuffer& commands) override;
+        void BeginTiming(std::string_view name) override;
+        void EndTiming() override;
+
+        /**
+         * \brief Starts recording a frame into a new command buffer taken from the target's frame arena
+         * \note The commands stay valid until the target starts rendering frame again, once the GPU is done with them,
+         *       call this again for every frame instead of reusing the buffer
+         */
+        void RecordFrame(IRenderTarget& target, uint32_t frame);
+
+        void SetCommandBuffer(CommandBuffer& commands) { _commands = &commands; }
+        [[nodiscard]] CommandBuffer& GetCommandBuffer() const { return *_commands; }
+    private:
+        CommandBuffer* _commands = nullptr;
+        /* The buffer RecordFrame records into, its commands live in a frame arena */
+        std::optional<CommandBuffer> _frameCommands;
+    };
+}
\ No newline at end of file
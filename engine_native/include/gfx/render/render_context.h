@@ -1,12 +1,16 @@
 #pragma once
 
+#include <string_view>
 #include "render_info.h"
 #include <gfx/render_target.h>
 #include <gfx/resources/image_buffer.h>
 
 namespace lumi::gfx::render
 {
+    class CommandBuffer;
+
     using resources::IImageBuffer;
+    using resources::ImageState;
 
     class IRenderContext
     {
@@ -17,7 +21,52 @@ namespace lumi::gfx::render
         virtual void BeginRecording(const RenderInfo& info) = 0;
         virtual void EndRecording(const RenderInfo& info) = 0;
 
+        /**
+         * \brief Records a transition of an image into a new state
+         * \note The transition is recorded with the commands of the current render target, set one first
+         *
+         * \param image The image to transition
+         * \param state The new state that the image should transition to
+         */
+        virtual void Transition(IImageBuffer& image, const ImageState& state) = 0;
+
+        /**
+         * \brief Records making an image the active one in memory it shares with other images, see IImageBuffer::Alias
+         * \note The image's contents are discarded, only alias an image before it's written
+         *
+         * \param image The image to alias
+         * \param state The state the image is first used in
+         */
+        virtual void Alias(IImageBuffer& image, const ImageState& state) = 0;
+
+        /**
+         * \brief Replays recorded commands in order, as if their calls were made on this context
+         * \note The buffer sets its own render targets, the current one may be changed by it
+         *
+         * \param commands The commands to replay
+         */
+        virtual void Execute(const CommandBuffer& commands) = 0;
+
+        /**
+         * \brief Starts timing the commands recorded on the current render target until the matching EndTiming
+         * \note Scopes nest, results come back from the target's GetTimings a few frames later
+         *
+         * \param name The name of the scope, copied by the target's queries
+         */
+        virtual void BeginTiming(std::string_view name) = 0;
+        virtual void EndTiming() = 0;
+
         [[nodiscard]] uint32_t GetFrameNumber() { return _frameNum; }
+
+        /**
+         * \brief Scratch memory for what a pass records on target this frame, like lists it builds for its draws
+         * \note It's the target's arena for this context's frame, valid until the target starts that frame again
+         * \warning Only use it for the target being recorded, under parallel recording each target has one writer
+         */
+        [[nodiscard]] core::LinearArena& GetFrameArena(IRenderTarget& target)
+        {
+            return target.GetFrameArena(_frameNum);
+        }
     protected:
         uint32_t _frameNum = 0;
     };
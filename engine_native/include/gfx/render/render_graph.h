@@ -0,0 +1,252 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <gfx/resources/image_buffer.h>
+#include <gfx/resources/transient_allocator.h>
+#include "render_orchestrator.h"
+#include "transient_planner.h"
+
+namespace lumi::gfx::render
+{
+    using resources::IImageBuffer;
+    using resources::ImageDesc;
+    using resources::ImageState;
+    using resources::ITransientAllocator;
+
+    /* Refers to an image declared in a RenderGraph */
+    struct RenderGraphImage
+    {
+        static constexpr uint32_t kInvalid = ~0u;
+
+        uint32_t index = kInvalid;
+
+        [[nodiscard]] bool IsValid() const { return index != kInvalid; }
+    };
+
+    /* An image a pass uses and the state the pass needs it in */
+    struct RenderGraphAccess
+    {
+        RenderGraphImage image;
+        ImageState state = ImageState::Undefined;
+    };
+
+    /* Finds the image a handle refers to for the target being recorded, called every time the image is transitioned */
+    using RenderGraphImageResolver = std::function<IImageBuffer*(IRenderContext& ctx, IRenderTarget* target)>;
+
+    struct RenderGraphPass
+    {
+        std::vector<IRenderTarget*> targets;
+        std::vector<RenderGraphAccess> reads;
+        std::vector<RenderGraphAccess> writes;
+        RenderPassFunction execute;
+        /* Keeps the pass even if nothing reads what it writes */
+        bool sideEffects = false;
+    };
+
+    /**
+     * \brief Orders passes by the images they read and write and transitions images between them
+     * \details Compiling sorts passes so every read comes after the writes it depends on, culls passes whose writes
+     *          are never read, and plans a transition only where an image's state changes between two uses.
+     *          The compiled passes run through a RenderOrchestrator, passes don't transition images themselves.
+     *          Images created by the graph are transient, they're placed in one heap so images whose passes don't
+     *          overlap share memory. Each one is aliased before its first use every frame, which discards what the
+     *          images sharing its memory left there.
+     * \note Accesses to an image keep the order their passes were added in. A read sees the last write added before it,
+     *       a write waits for the reads of what it overwrites, so passes can ping-pong between two images
+     * \note The compiled graph is cached by a hash of its structure and the size of its targets. A graph cleared and
+     *       rebuilt every frame only compiles again when that hash changes, like when a window resizes. A matching hash
+     *       is confirmed against the compiled structure before it's reused.
+     */
+    class RenderGraph
+    {
+    public:
+        RenderGraph() = default;
+
+        /* Compiled passes refer back to the graph */
+        RenderGraph(const RenderGraph&) = delete;
+        RenderGraph& operator=(const RenderGraph&) = delete;
+
+        /**
+         * \brief Declares an image owned outside of the graph
+         *
+         * \param name The name of the image, used in errors
+         * \param resolver Finds the image for each target
+         * \param finalState The state the image is left in after its last use, an image with a final state is an
+         *                   output of the graph and keeps its writers alive. Undefined leaves it in its last state.
+         */
+        RenderGraphImage ImportImage(const std::string& name, RenderGraphImageResolver resolver,
+            ImageState finalState = ImageState::Undefined);
+
+        /**
+         * \brief Declares an image owned by the graph, created when the graph compiles
+         * \note Transient images share memory, a pass writing one first must clear it or write all of it
+         *
+         * \param name The name of the image, used in errors
+         * \param desc The size, format and usage of the image
+         */
+        RenderGraphImage CreateImage(const std::string& name, const ImageDesc& desc);
+
+        /**
+         * \brief Sets the allocator transient images are placed with
+         * \warning The allocator has to outlive the graph
+         */
+        void SetTransientAllocator(ITransientAllocator* allocator);
+
+        /**
+         * \brief Adds a new pass to this graph
+         * \note Adding a pass makes the graph compile again on its next execution
+         *
+         * \param name The name of the pass
+         * \param pass The pass info to use
+         */
+        void NewPass(const std::string& name, RenderGraphPass pass);
+
+        /**
+         * \brief Orders, culls and plans transitions for all passes
+         *
+         * \return true The graph compiled
+         * \return false A pass uses an invalid image or the passes depend on each other in a cycle
+         */
+        bool Compile();
+
+        /**
+         * \brief Executes all passes still in the graph after compiling
+         * \note The graph only compiles again when its passes, images or target sizes changed since the last compile,
+         *       a graph that failed to compile stays empty until one of them changes
+         */
+        void Execute(IRenderContext& ctx);
+
+        /**
+         * \brief Removes every pass and image
+         * \note The compiled graph and its transient images are kept until the next execution, so a graph rebuilt the
+         *       same way reuses them
+         */
+        void Clear();
+
+        /* Removes every pass and image and drops the compiled graph */
+        void Reset();
+
+        [[nodiscard]] size_t GetCompiledPassCount() const { return _dirty ? 0 : _order.size(); }
+        [[nodiscard]] size_t GetCulledPassCount() const { return _dirty ? 0 : _passes.size() - _order.size(); }
+        /* Times the graph compiled, and times a changed graph matched the compiled one and reused it */
+        [[nodiscard]] uint64_t GetCompileCount() const { return _compileCount; }
+        [[nodiscard]] uint64_t GetCacheHitCount() const { return _cacheHits; }
+        /* Transitions planned for each target of a frame, the ones an image is already in are skipped when executing */
+        [[nodiscard]] size_t GetPlannedTransitionCount() const { return _plannedTransitions; }
+        /* Names of the compiled passes in the order they execute, empty while the graph has changes to compile */
+        [[nodiscard]] std::vector<std::string> GetCompiledOrder() const;
+        /* Where transient images were placed by the last compile and how much memory aliasing saved */
+        [[nodiscard]] const TransientPlan& GetTransientPlan() const { return _transientPlan; }
+
+        /**
+         * \brief Gets the image behind a transient image handle
+         * \return The image, or nullptr if the handle isn't a transient image or it was culled
+         */
+        [[nodiscard]] IImageBuffer* GetTransientImage(RenderGraphImage image) const;
+
+        /* Resolves to the target's color buffer for the context's frame */
+        static IImageBuffer* ColorBuffer(IRenderContext& ctx, IRenderTarget* target);
+        /* Resolves to the target's depth buffer for the context's frame */
+        static IImageBuffer* DepthBuffer(IRenderContext& ctx, IRenderTarget* target);
+    private:
+        struct Image
+        {
+            std::string name;
+            RenderGraphImageResolver resolver;
+            ImageState finalState = ImageState::Undefined;
+            bool transient = false;
+            ImageDesc desc = {};
+            std::unique_ptr<IImageBuffer> buffer;
+        };
+
+        struct Pass
+        {
+            /* Views into _passNames */
+            std::string_view name;
+            RenderGraphPass info;
+        };
+
+        struct CompiledPass
+        {
+            size_t pass = 0;
+            /* Transient images first used by the pass, aliased into their first state instead of transitioned */
+            std::vector<RenderGraphAccess> aliases;
+            /* Transitions before the pass executes */
+            std::vector<RenderGraphAccess> before;
+            /* Transitions into final states after the image's last use */
+            std::vector<RenderGraphAccess> after;
+        };
+
+        struct TargetSize
+        {
+            IRenderTarget* target = nullptr;
+            int width = 0;
+            int height = 0;
+        };
+
+        /* An image and pass as the last compile saw them, compared in full so a hash collision can't reuse it */
+        struct CompiledImage
+        {
+            bool transient = false;
+            ImageState finalState = ImageState::Undefined;
+            ImageDesc desc = {};
+        };
+
+        struct CompiledPassInfo
+        {
+            std::string name;
+            bool sideEffects = false;
+            std::vector<IRenderTarget*> targets;
+            std::vector<RenderGraphAccess> reads;
+            std::vector<RenderGraphAccess> writes;
+        };
+
+        std::vector<Image> _images;
+        core::StringInterner _passNames;
+        std::vector<Pass> _passes;
+        std::vector<CompiledPass> _order;
+        RenderOrchestrator _orchestrator;
+        ITransientAllocator* _transientAllocator = nullptr;
+        TransientPlan _transientPlan;
+        size_t _plannedTransitions = 0;
+        bool _dirty = true;
+        bool _valid = false;
+        /* The last compile failed, the graph doesn't compile again until its structure changes */
+        bool _compileFailed = false;
+
+        /* What the last compile was for, a rebuilt graph with the same hash reuses it */
+        uint64_t _compiledHash = 0;
+        std::vector<CompiledImage> _compiledImages;
+        std::vector<CompiledPassInfo> _compiledPasses;
+        std::vector<TargetSize> _targetSizes;
+        /* Images the last compile placed in the transient heap */
+        std::vector<uint32_t> _placedTransients;
+        /* Transient images of a cleared graph by image index, handed back if the rebuilt graph matches */
+        std::vector<std::unique_ptr<IImageBuffer>> _retainedTransients;
+        uint64_t _compileCount = 0;
+        uint64_t _cacheHits = 0;
+
+        bool Validate() const;
+        bool SortPasses(std::vector<size_t>& order) const;
+        /* Checks if a pass the sort couldn't place depends on itself through other unplaced passes */
+        static bool ReachesItself(size_t pass, const std::vector<std::vector<size_t>>& dependents,
+            const std::vector<uint32_t>& dependencies);
+        void CullPasses(std::vector<size_t>& order) const;
+        bool PlanTransitions(const std::vector<size_t>& order);
+        bool AllocateTransients();
+        void BuildOrchestrator();
+        uint64_t HashStructure() const;
+        void SnapshotStructure();
+        bool MatchesCompiled() const;
+        void SnapshotTargets();
+        bool TargetsResized() const;
+        bool ReuseCompiled();
+        void Transition(IRenderContext& ctx, IRenderTarget* target, const RenderGraphAccess& access) const;
+        void Alias(IRenderContext& ctx, IRenderTarget* target, const RenderGraphAccess& access) const;
+    };
+}
\ No newline at end of file
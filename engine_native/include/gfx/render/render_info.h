@@ -1,8 +1,8 @@
 #pragma once
 
 #include <array>
-#include <vector>
 #include <string>
+#include <core/fixed_vector.h>
 #include <gfx/resources/image_buffer.h>
 #include "render_view.h"
 
@@ -10,6 +10,9 @@ namespace lumi::gfx::render
 {
     using resources::IImageBuffer;
 
+    /* Color images a single recording can render to, the most D3D12 can bind at once */
+    constexpr size_t kMaxColorAttachments = 8;
+
     /* Describes how info should be loaded */
     enum class RenderLoadOp
     {
@@ -49,7 +52,7 @@ namespace lumi::gfx::render
     {
         /* Describes how info should be transformed */
         RenderView view;
-        std::vector<RenderColorInfo> color;
+        core::FixedVector<RenderColorInfo, kMaxColorAttachments> color;
         RenderDepthInfo* depth = nullptr;
     };
 }
\ No newline at end of file
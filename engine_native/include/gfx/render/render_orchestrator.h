@@ -1,31 +1,120 @@
 #pragma once
 
-#include <string>
-#include <utility>
+#include <cstdint>
+#include <string_view>
 #include <vector>
 #include <functional>
+#include <memory>
+#include <core/string_interner.h>
 #include "render_pass.h"
 
 namespace lumi::gfx::render
 {
+    /* Creates the render context a worker thread records with */
+    using RenderContextFactory = std::function<std::unique_ptr<IRenderContext>()>;
+
+    /**
+     * \brief Refers to a pass added to a RenderOrchestrator
+     * \note The generation is the orchestrator's count of Clear calls, a handle from before a Clear no longer resolves
+     */
+    struct PassHandle
+    {
+        static constexpr uint32_t kInvalid = ~0u;
+
+        uint32_t index = kInvalid;
+        uint32_t generation = 0;
+
+        [[nodiscard]] bool IsValid() const { return index != kInvalid; }
+    };
+
     class RenderOrchestrator
     {
-    using Pass = std::pair<std::string, RenderPass>;
+    struct Pass
+    {
+        std::string_view name;
+        RenderPass info;
+    };
     public:
+        RenderOrchestrator();
+        ~RenderOrchestrator();
+        RenderOrchestrator(RenderOrchestrator&&) noexcept;
+        RenderOrchestrator& operator=(RenderOrchestrator&&) noexcept;
+
         /**
          * \brief Adds a new render pass to this orchestrator
          * 
          * \param name The name of the render pass
          * \param info The render pass info to use
+         * \return A handle to the pass, invalid if a pass with the same name was already added
          */
-        void NewPass(const std::string& name, RenderPass& info);
+        PassHandle NewPass(std::string_view name, RenderPass info);
 
-        /* Executes all passes in this orchestrator */
+        /**
+         * \brief Adds a new render pass, storing the callback in the pass without going through a RenderPass
+         *
+         * \param name The name of the render pass
+         * \param targets The targets the pass renders to
+         * \param execute Called for each target, its captures must fit in kRenderPassCaptureSize bytes
+         * \return A handle to the pass, invalid if a pass with the same name was already added
+         */
+        template<typename Execute>
+        PassHandle NewPass(std::string_view name, std::vector<IRenderTarget*> targets, Execute&& execute)
+        {
+            RenderPass info;
+            info.targets = std::move(targets);
+            info.execute = RenderPassFunction(std::forward<Execute>(execute));
+            return NewPass(name, std::move(info));
+        }
+
+        /**
+         * \brief Executes all passes in this orchestrator
+         * \note With parallel recording each target is recorded by one job, passes still run in order per target.
+         *       The calling thread records with ctx and the job workers with their own contexts, all on ctx's frame.
+         *       Every pass is timed on each of its targets, the results come back from the target's GetTimings.
+         */
         void Execute(IRenderContext& ctx);
 
-        [[nodiscard]] RenderPass* GetPass(const std::string& name);
+        /**
+         * \brief Records different targets as jobs on the job system during Execute
+         * \note Targets are recorded on the calling thread alone while the job system isn't running
+         * \warning Passes recorded in parallel must not touch images shared with other targets,
+         *          and execute callbacks must be safe to call from several threads at once
+         *
+         * \param contextFactory Creates the render context of each job thread, null records everything on the calling thread
+         */
+        void SetParallelRecording(RenderContextFactory contextFactory);
+
+        /* Removes every pass from this orchestrator, handles given out before are no longer valid */
+        void Clear();
+
+        /* Gets a pass by its handle, nullptr if the handle is invalid or from before the last Clear */
+        [[nodiscard]] RenderPass* GetPass(PassHandle handle);
+
+        /**
+         * \brief Finds a pass by name, for tools and debugging
+         * \note This hashes the name, keep the handle from NewPass for anything that runs every frame
+         */
+        [[nodiscard]] PassHandle FindPass(std::string_view name) const;
+
+        /* Gets the name of a pass, empty if the handle is invalid or from before the last Clear */
+        [[nodiscard]] std::string_view GetPassName(PassHandle handle) const;
+
+        [[nodiscard]] size_t GetPassCount() const { return _renderPasses.size(); }
     private:
+        class ParallelRecorder;
+
+        /* Pass handles are the ids of the interned pass names */
+        core::StringInterner _passNames;
         std::vector<Pass> _renderPasses;
-        
+        /* Bumped by Clear, the interned ids start over so handles from before it would alias new passes */
+        uint32_t _generation = 0;
+        std::unique_ptr<ParallelRecorder> _parallel;
+
+        void ExecuteSequential(IRenderContext& ctx);
+
+        [[nodiscard]] bool IsCurrent(const PassHandle handle) const
+        {
+            return handle.generation == _generation && handle.index < _renderPasses.size();
+        }
     };
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 
-#include <functional>
 #include <vector>
+#include <core/inline_function.h>
 #include <gfx/resources/gpu_resource.h>
 
 #include "render_info.h"
@@ -20,9 +20,15 @@ namespace lumi::gfx::render
 {
     using resources::IGpuResource;
 
+    /* Bytes a pass callback may capture, capture a pointer to anything bigger */
+    constexpr size_t kRenderPassCaptureSize = 64;
+
+    /* Records a pass for one target, stored inline so registering and calling it never allocates */
+    using RenderPassFunction = core::InlineFunction<void(IRenderContext& ctx, IRenderTarget* target), kRenderPassCaptureSize>;
+
     struct RenderPass
     {
         std::vector<IRenderTarget*> targets;
-        std::function<void(IRenderContext& ctx, IRenderTarget* target)> execute;
+        RenderPassFunction execute;
     };
 }
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <core/inline_function.h>
+#include <core/radix_sort.h>
+
+namespace lumi::gfx::render
+{
+    class CommandBuffer;
+    class IRenderContext;
+
+    /**
+     * \brief The fields a submission is ordered by, packed from most to least significant
+     * \note Fields are cut to their bit counts, so give passes, targets, pipelines and materials small dense ids
+     */
+    struct SubmissionKey
+    {
+        static constexpr uint32_t kPassBits = 8;
+        static constexpr uint32_t kTargetBits = 8;
+        static constexpr uint32_t kPipelineBits = 12;
+        static constexpr uint32_t kMaterialBits = 16;
+        static constexpr uint32_t kDepthBits = 20;
+
+        uint32_t pass = 0;
+        uint32_t target = 0;
+        uint32_t pipeline = 0;
+        uint32_t material = 0;
+        /* Depth in the view from 0 to 1, nearer items go first, pass 1 - depth to draw back to front */
+        float depth = 0.0f;
+
+        [[nodiscard]] uint64_t Pack() const
+        {
+            constexpr auto kDepthMax = static_cast<float>((1u << kDepthBits) - 1);
+            // Written so NaN depths become 0 instead of an undefined conversion
+            const float clamped = depth > 0.0f ? std::min(depth, 1.0f) : 0.0f;
+
+            uint64_t key = Field(pass, kPassBits);
+            key = (key << kTargetBits) | Field(target, kTargetBits);
+            key = (key << kPipelineBits) | Field(pipeline, kPipelineBits);
+            key = (key << kMaterialBits) | Field(material, kMaterialBits);
+            key = (key << kDepthBits) | static_cast<uint64_t>(clamped * kDepthMax);
+            return key;
+        }
+    private:
+        static uint64_t Field(const uint32_t value, const uint32_t bits) { return value & ((1u << bits) - 1); }
+    };
+
+    static_assert(SubmissionKey::kPassBits + SubmissionKey::kTargetBits + SubmissionKey::kPipelineBits
+                  + SubmissionKey::kMaterialBits + SubmissionKey::kDepthBits == 64, "Submission keys fill 64 bits");
+
+    /* Bytes a submission may capture, capture a pointer to anything bigger */
+    constexpr size_t kSubmissionCaptureSize = 32;
+
+    using SubmissionFunction = core::InlineFunction<void(IRenderContext& ctx), kSubmissionCaptureSize>;
+
+    /**
+     * \brief Collects draws and dispatches with sort keys and replays them in key order
+     * \details Submissions are sorted with a radix sort on their packed keys, only the keys and indices move.
+     *          Submissions with equal keys keep the order they were submitted in.
+     * \warning Not thread safe, give each recording thread its own queue
+     */
+    class SubmissionQueue
+    {
+    public:
+        void Reserve(size_t count);
+
+        /**
+         * \brief Adds a submission, it's called with the context when the queue executes
+         *
+         * \param key A packed SubmissionKey, or any key where lower sorts first
+         * \param function Records the submission, its captures must fit in kSubmissionCaptureSize bytes
+         */
+        void Submit(uint64_t key, SubmissionFunction function);
+
+        /* Adds a recorded command buffer, it must stay alive until the queue executes */
+        void Submit(uint64_t key, const CommandBuffer& commands);
+
+        /* Sorts the submissions by key, Execute does this too when needed */
+        void Sort();
+
+        /* Replays every submission in key order, the queue keeps them until Clear */
+        void Execute(IRenderContext& ctx);
+
+        /* Removes every submission, keeping the memory for the next frame */
+        void Clear();
+
+        [[nodiscard]] size_t GetSize() const { return _functions.size(); }
+        /* The submissions' keys and indices, in key order once sorted */
+        [[nodiscard]] std::span<const core::SortEntry> GetOrder() const { return _entries; }
+    private:
+        std::vector<core::SortEntry> _entries;
+        std::vector<core::SortEntry> _scratch;
+        std::vector<SubmissionFunction> _functions;
+        bool _sorted = true;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace lumi::gfx::render
+{
+    /* How long one scope of a finished frame took */
+    struct TimingResult
+    {
+        std::string_view name;
+        /* How many scopes were open around it */
+        uint32_t depth;
+        std::chrono::nanoseconds duration;
+    };
+
+    /**
+     * \brief Timestamp queries of one render target, a pool per frame in flight
+     * \details Contexts open scopes while recording a frame and write the timestamps the scope hands them.
+     *          The frame's timestamps are read once the target starts the frame again, after its fence,
+     *          so results never stall the CPU and lag behind by the number of frames in flight.
+     * \note Each target is recorded by one thread at a time, so its queries only ever see one writer
+     */
+    class TimingQueries
+    {
+    public:
+        static constexpr uint32_t kMaxScopesPerFrame = 256;
+        static constexpr uint32_t kMaxQueriesPerFrame = kMaxScopesPerFrame * 2;
+        static constexpr uint32_t kInvalidQuery = ~0u;
+        /* Name bytes per scope reserved up front, longer names still work but may allocate */
+        static constexpr uint32_t kReservedNameLength = 32;
+
+        virtual ~TimingQueries() = default;
+
+        /* Sets the number of frames in flight, dropping every scope and result */
+        void SetFrameCount(const uint32_t count)
+        {
+            _frames.assign(count, {});
+            for (auto& frame : _frames)
+            {
+                frame.scopes.reserve(kMaxScopesPerFrame);
+                frame.open.reserve(kMaxScopesPerFrame);
+                frame.names.reserve(kMaxScopesPerFrame * kReservedNameLength);
+            }
+            _results.clear();
+            _results.reserve(kMaxScopesPerFrame);
+        }
+
+        /* Reads the scopes of the frame's last use into the results, call once its GPU work is done */
+        void BeginFrame(const uint32_t frame)
+        {
+            if (frame >= _frames.size())
+            {
+                return;
+            }
+
+            Frame& state = _frames[frame];
+            if (state.queryCount > 0 && ReadTimestamps(frame, std::span(_timestamps.data(), state.queryCount)))
+            {
+                // The results keep their own copy of the names, the frame's buffer is reused right away
+                _resultNames.assign(state.names.begin(), state.names.end());
+                _results.clear();
+                for (const Scope& scope : state.scopes)
+                {
+                    // Scopes left open when the frame ended have no end timestamp
+                    if (scope.end == kInvalidQuery)
+                    {
+                        continue;
+                    }
+                    uint64_t begin = _timestamps[scope.begin];
+                    uint64_t end = _timestamps[scope.end];
+                    std::string_view name(_resultNames.data() + scope.nameOffset, scope.nameLength);
+                    _results.push_back({ name, scope.depth, std::chrono::nanoseconds(end > begin ? end - begin : 0) });
+                }
+            }
+
+            state.scopes.clear();
+            state.open.clear();
+            state.names.clear();
+            state.queryCount = 0;
+        }
+
+        /**
+         * \brief Opens a scope in a frame
+         * \note The name is copied, it doesn't have to outlive the call
+         *
+         * \return The query to write the start timestamp to, kInvalidQuery when the frame has no queries left
+         */
+        uint32_t BeginScope(const uint32_t frame, const std::string_view name)
+        {
+            if (frame >= _frames.size())
+            {
+                return kInvalidQuery;
+            }
+
+            Frame& state = _frames[frame];
+            if (state.queryCount + 2 > kMaxQueriesPerFrame)
+            {
+                // Still tracked so the matching EndScope closes the right scope
+                state.open.push_back(kInvalidQuery);
+                return kInvalidQuery;
+            }
+
+            auto nameOffset = static_cast<uint32_t>(state.names.size());
+            state.names.insert(state.names.end(), name.begin(), name.end());
+
+            state.open.push_back(static_cast<uint32_t>(state.scopes.size()));
+            state.scopes.push_back({
+                nameOffset, static_cast<uint32_t>(name.size()),
+                static_cast<uint32_t>(state.open.size() - 1), state.queryCount++, kInvalidQuery
+            });
+            return state.scopes.back().begin;
+        }
+
+        /**
+         * \brief Closes the innermost open scope of a frame
+         * \return The query to write the end timestamp to, kInvalidQuery when no scope is open or it had no queries
+         */
+        uint32_t EndScope(const uint32_t frame)
+        {
+            if (frame >= _frames.size())
+            {
+                return kInvalidQuery;
+            }
+
+            Frame& state = _frames[frame];
+            if (state.open.empty())
+            {
+                return kInvalidQuery;
+            }
+
+            uint32_t scope = state.open.back();
+            state.open.pop_back();
+            if (scope == kInvalidQuery)
+            {
+                return kInvalidQuery;
+            }
+            state.scopes[scope].end = state.queryCount++;
+            return state.scopes[scope].end;
+        }
+
+        /* Queries written in the frame so far, backends resolve this many */
+        [[nodiscard]] uint32_t GetQueryCount(const uint32_t frame) const { return frame < _frames.size() ? _frames[frame].queryCount : 0; }
+
+        /* The scopes of the latest frame whose timestamps came back in the order they were opened, valid until the next BeginFrame */
+        [[nodiscard]] std::span<const TimingResult> GetResults() const { return _results; }
+    protected:
+        TimingQueries() : _timestamps(kMaxQueriesPerFrame) {}
+
+        /**
+         * \brief Reads the timestamps a frame's queries were written with
+         * \note Only called once the frame's GPU work is done, it must not wait
+         *
+         * \param frame The frame the queries were written in
+         * \param nanoseconds Filled with each query's timestamp in nanoseconds
+         * \return False if the timestamps couldn't be read, the results are kept from the last frame
+         */
+        virtual bool ReadTimestamps(uint32_t frame, std::span<uint64_t> nanoseconds) = 0;
+    private:
+        struct Scope
+        {
+            /* Where the name is in the frame's name buffer, offsets stay valid when the buffer grows */
+            uint32_t nameOffset;
+            uint32_t nameLength;
+            uint32_t depth;
+            uint32_t begin;
+            uint32_t end;
+        };
+
+        struct Frame
+        {
+            std::vector<Scope> scopes;
+            /* Indices of the open scopes, innermost last */
+            std::vector<uint32_t> open;
+            std::vector<char> names;
+            uint32_t queryCount = 0;
+        };
+
+        std::vector<Frame> _frames;
+        std::vector<TimingResult> _results;
+        std::vector<char> _resultNames;
+        std::vector<uint64_t> _timestamps;
+    };
+}
\ No newline at end of file
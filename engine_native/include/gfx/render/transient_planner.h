@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace lumi::gfx::render
+{
+    /* A resource that only has to exist between two passes of a frame */
+    struct TransientResource
+    {
+        uint64_t size = 0;
+        uint64_t alignment = 1;
+        /* First and last pass, in execution order, that use the resource */
+        uint32_t firstPass = 0;
+        uint32_t lastPass = 0;
+    };
+
+    struct TransientPlan
+    {
+        /* Where each resource starts in the shared heap, in the order the resources were given */
+        std::vector<uint64_t> offsets;
+        /* Size of the shared heap, the peak memory with aliasing */
+        uint64_t heapSize = 0;
+        /* Memory the resources need with an allocation each, the peak memory without aliasing */
+        uint64_t unaliasedSize = 0;
+        /* Most memory in use during a single pass, no placement can have a smaller heap */
+        uint64_t peakLiveSize = 0;
+    };
+
+    /**
+     * \brief Places resources in one heap so resources whose lifetimes don't overlap share memory
+     * \details Resources are placed largest first, each at the lowest aligned offset that doesn't overlap the memory
+     *          of an already placed resource alive during any of the same passes.
+     * \note Only placement is planned here, the backend creates the heap and the resources in it
+     */
+    TransientPlan PlanTransientResources(std::span<const TransientResource> resources);
+}
\ No newline at end of file
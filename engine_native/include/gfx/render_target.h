@@ -3,8 +3,13 @@
 #include <memory>
 #include <vector>
 #include <cstdint>
+#include <core/frame_arena.h>
+#include <gfx/backend.h>
+#include <gfx/resize_policy.h>
 #include <gfx/render/render_orchestrator.h>
+#include <gfx/render/timing_queries.h>
 #include <gfx/resources/image_buffer.h>
+#include <gfx/resources/sync.h>
 
 namespace lumi::gfx
 {
@@ -26,5 +31,56 @@ namespace lumi::gfx
         virtual int GetHeight() = 0;
         virtual std::shared_ptr<IImageBuffer> GetColorBuffer(const uint32_t index) = 0;
         virtual std::shared_ptr<IImageBuffer> GetDepthBuffer(const uint32_t index) = 0;
+
+        /* Timestamp queries of the scopes recorded on this target, GetResults has the latest finished frame */
+        virtual render::TimingQueries& GetTimings() = 0;
+
+        /**
+         * \brief The timeline this target's frames signal when the GPU finishes them
+         * \note StartRendering only waits for the frame that last used the index, up to maxInFlight frames overlap
+         */
+        virtual resources::ISync& GetSync() = 0;
+
+        /* The backend that created this target, lets backends cast it back without RTTI */
+        [[nodiscard]] Backend GetBackend() const { return _backend; }
+
+        /**
+         * \brief Scratch memory for recording the frame using index
+         * \note Memory from it stays valid until the target starts rendering with index again, after the GPU is done
+         */
+        [[nodiscard]] core::LinearArena& GetFrameArena(const uint32_t index) { return _frameArenas.Get(index); }
+
+        /**
+         * \brief Changes how often the target rebuilds its buffers while its surface is being resized
+         * \note A zeroed config rebuilds on the first frame after every size change
+         */
+        void SetResizePolicy(const ResizePolicyConfig& config) { _resizePolicy.SetConfig(config); }
+        [[nodiscard]] const ResizePolicy& GetResizePolicy() const { return _resizePolicy; }
+    protected:
+        explicit IRenderTarget(const Backend backend) : _backend(backend) {}
+
+        /**
+         * \brief Resizes to the latest requested size when the policy asks for it
+         * \note Call at the start of a frame, it's a flag check while no resize is pending
+         *
+         * \param now The time the policy decides with, the backend's Resize is expected to Reset it with the same clock
+         */
+        void ApplyResizePolicy(const ResizePolicy::Clock::time_point now)
+        {
+            if (!_resizePolicy.IsPending())
+            {
+                return;
+            }
+            if (_resizePolicy.ShouldRebuild(now))
+            {
+                Resize(_resizePolicy.GetRequestedWidth(), _resizePolicy.GetRequestedHeight());
+            }
+        }
+
+        Backend _backend;
+        /* Sized in Init and reset in StartRendering by each backend */
+        core::FrameArena _frameArenas;
+        /* Backends request surface sizes and Reset it whenever their buffers are recreated */
+        ResizePolicy _resizePolicy;
     };
 }
\ No newline at end of file
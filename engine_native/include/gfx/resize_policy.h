@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+namespace lumi::gfx
+{
+    struct ResizePolicyConfig
+    {
+        /* Shortest time between two rebuilds, growing past the buffers waits this long at most */
+        std::chrono::nanoseconds minRebuildInterval = std::chrono::milliseconds(100);
+        /* How long the size must stay the same before shrinking the buffers to it */
+        std::chrono::nanoseconds settleTime = std::chrono::milliseconds(250);
+    };
+
+    /**
+     * \brief Decides when a render target rebuilds its size dependent buffers while its surface is being resized
+     * \details Size requests are coalesced, only the latest one is kept. A surface that fits in the current buffers
+     *          renders into their top-left corner (GetRenderWidth/GetRenderHeight) and rebuilds once the size settles.
+     *          A surface that outgrew them rebuilds as soon as minRebuildInterval passed since the last rebuild.
+     * \note Time is passed in, so the decisions are the same on any backend, including the null one
+     */
+    class ResizePolicy
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        void SetConfig(const ResizePolicyConfig& config) { _config = config; }
+        [[nodiscard]] const ResizePolicyConfig& GetConfig() const { return _config; }
+
+        /**
+         * \brief Call after the buffers were (re)created, clears any request they satisfy
+         */
+        void Reset(const int width, const int height, const Clock::time_point now)
+        {
+            _bufferWidth = width;
+            _bufferHeight = height;
+            _lastRebuild = now;
+            _forced = false;
+            _pending = _requestedWidth != _bufferWidth || _requestedHeight != _bufferHeight;
+        }
+
+        /**
+         * \brief The surface changed size, replaces any request that wasn't rebuilt yet
+         * \note Empty sizes (e.g. a minimized window) are ignored, the buffers are kept for when it's restored
+         */
+        void Request(const int width, const int height, const Clock::time_point now)
+        {
+            if (width <= 0 || height <= 0 || (width == _requestedWidth && height == _requestedHeight))
+            {
+                return;
+            }
+            _requestedWidth = width;
+            _requestedHeight = height;
+            _lastRequest = now;
+            _pending = _requestedWidth != _bufferWidth || _requestedHeight != _bufferHeight;
+        }
+
+        /**
+         * \brief Rebuilds at the requested size the next time ShouldRebuild is asked, e.g. after a format change
+         */
+        void Force() { _forced = true; }
+
+        /**
+         * \brief Checks if the buffers should be rebuilt at GetRequestedWidth/GetRequestedHeight now
+         */
+        [[nodiscard]] bool ShouldRebuild(const Clock::time_point now) const
+        {
+            if (_forced)
+            {
+                return true;
+            }
+            if (!_pending || now - _lastRebuild < _config.minRebuildInterval)
+            {
+                return false;
+            }
+            if (!Fits())
+            {
+                return true;
+            }
+            return now - _lastRequest >= _config.settleTime;
+        }
+
+        /* Whether a request is still waiting for a rebuild, checking it doesn't need the time */
+        [[nodiscard]] bool IsPending() const { return _pending || _forced; }
+
+        /* The area to render into, never larger than the buffers */
+        [[nodiscard]] int GetRenderWidth() const { return std::min(_requestedWidth, _bufferWidth); }
+        [[nodiscard]] int GetRenderHeight() const { return std::min(_requestedHeight, _bufferHeight); }
+
+        [[nodiscard]] int GetRequestedWidth() const { return _requestedWidth; }
+        [[nodiscard]] int GetRequestedHeight() const { return _requestedHeight; }
+        [[nodiscard]] int GetBufferWidth() const { return _bufferWidth; }
+        [[nodiscard]] int GetBufferHeight() const { return _bufferHeight; }
+    private:
+        [[nodiscard]] bool Fits() const { return _requestedWidth <= _bufferWidth && _requestedHeight <= _bufferHeight; }
+
+        ResizePolicyConfig _config;
+        int _requestedWidth = 0;
+        int _requestedHeight = 0;
+        int _bufferWidth = 0;
+        int _bufferHeight = 0;
+        bool _pending = false;
+        bool _forced = false;
+        Clock::time_point _lastRequest{};
+        Clock::time_point _lastRebuild{};
+    };
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <gfx/backend.h>
 #include "gpu_resource.h"
 
 namespace lumi::gfx::resources
@@ -48,6 +49,20 @@ namespace lumi::gfx::resources
         Present
     };
 
+    /* Bytes per pixel of a format */
+    inline uint32_t GetImageFormatSize(const ImageFormat format)
+    {
+        switch (format)
+        {
+            case ImageFormat::RGBA8: return 4;
+            case ImageFormat::RGBA16F: return 8;
+            case ImageFormat::RGBA32F: return 16;
+            case ImageFormat::Depth24Stencil8: return 4;
+            case ImageFormat::Undefined: return 0;
+        }
+        return 0;
+    }
+
     struct ImageDesc
     {
         uint32_t width;
@@ -77,6 +92,16 @@ namespace lumi::gfx::resources
          * \param toState The new state that this image should attempt to transition to
          */
         virtual void Transition(const ImageState& toState) = 0;
+
+        /**
+         * \brief Makes this image the one using memory it shares with other images, then moves it into a state
+         * \details The contents are undefined afterwards, whatever image used the memory last may have written over it.
+         *          Transient images are aliased before their first use each frame instead of transitioned, so a state
+         *          left over from an earlier frame never skips the work that readies the memory.
+         *
+         * \param toState The state of the image's first use
+         */
+        virtual void Alias(const ImageState& toState) = 0;
         virtual void Destroy() override = 0;
 
         [[nodiscard]] uint32_t GetWidth() const { return _description.width; }
@@ -85,7 +110,13 @@ namespace lumi::gfx::resources
         [[nodiscard]] ImageUsage GetUsage() const { return _description.usage; }
         [[nodiscard]] ImageState GetState() const { return _state; }
         [[nodiscard]] virtual void* Get() = 0;
+
+        /* The backend that created this image, lets backends cast it back without RTTI */
+        [[nodiscard]] Backend GetBackend() const { return _backend; }
     protected:
+        explicit IImageBuffer(const Backend backend) : _backend(backend) {}
+
+        Backend _backend;
         ImageDesc _description;
         ImageState _state = ImageState::Undefined;
     };
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace lumi::gfx::resources
+{
+    /**
+     * \brief A timeline of increasing 64-bit values, the GPU reaches each value once the work submitted before it is done
+     * \details Work is tracked by keeping the value Signal returned for it and waiting on or comparing against that value,
+     *          so any number of frames can be in flight while waiting only on the one that's about to be reused.
+     * \note Value 0 is reached from the start, waiting on it never blocks
+     */
+    class ISync
+    {
+    public:
+        /* Pass to Wait to block until the value is reached, however long it takes */
+        static constexpr std::chrono::nanoseconds kWaitForever = std::chrono::nanoseconds::max();
+
+        virtual ~ISync() = default;
+
+        /**
+         * \brief Queues a signal after all work submitted so far
+         * \return uint64_t - The value the timeline reaches once that work is done, always larger than the previous one
+         */
+        virtual uint64_t Signal() = 0;
+
+        /**
+         * \brief Blocks the calling thread until the timeline reaches value or the timeout passes
+         * \return true - The value was reached.
+         * \return false - The timeout passed first, or the wait failed.
+         */
+        virtual bool Wait(uint64_t value, std::chrono::nanoseconds timeout = kWaitForever) = 0;
+
+        /* The largest value the timeline reached, it never goes down */
+        [[nodiscard]] virtual uint64_t GetCompletedValue() const = 0;
+
+        /* The value the last Signal returned, 0 before the first one */
+        [[nodiscard]] virtual uint64_t GetSignaledValue() const = 0;
+
+        [[nodiscard]] bool IsComplete(const uint64_t value) const { return GetCompletedValue() >= value; }
+
+        /* Waits for everything signaled so far */
+        bool WaitIdle() { return Wait(GetSignaledValue()); }
+    };
+}
\ No newline at end of file
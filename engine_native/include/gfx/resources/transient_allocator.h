@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include "image_buffer.h"
+
+namespace lumi::gfx::resources
+{
+    /* Memory an image needs when it's placed in a heap */
+    struct ImageMemoryRequirements
+    {
+        uint64_t size = 0;
+        uint64_t alignment = 1;
+    };
+
+    /**
+     * \brief Creates images inside one heap at offsets chosen by the caller, so images can share memory
+     * \warning Images placed over the same memory overwrite each other, only use images that alias outside of the
+     *          passes they're used in and clear or fully write them on first use
+     */
+    class ITransientAllocator
+    {
+    public:
+        virtual ~ITransientAllocator() = default;
+
+        [[nodiscard]] virtual ImageMemoryRequirements GetRequirements(const ImageDesc& desc) = 0;
+
+        /**
+         * \brief Creates the heap images are placed in, replacing the previous one
+         * \warning Destroy the images placed in the previous heap first
+         *
+         * \return true The heap was created
+         * \return false The heap couldn't be created
+         */
+        virtual bool Reserve(uint64_t size) = 0;
+
+        /**
+         * \brief Creates an image at an offset inside the heap
+         *
+         * \return The image, or nullptr if it doesn't fit in the heap or couldn't be created
+         */
+        [[nodiscard]] virtual std::unique_ptr<IImageBuffer> CreateImage(const ImageDesc& desc, uint64_t offset) = 0;
+
+        /* Destroys the heap */
+        virtual void Release() = 0;
+
+        [[nodiscard]] virtual uint64_t GetHeapSize() const = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace lumi::sys
+{
+    /* The timings recorded for every frame */
+    enum class FrameMetric : uint8_t
+    {
+        Frame, /* Start of one frame to the start of the next */
+        CpuRecord, /* Recording commands on the CPU */
+        Submit, /* Handing recorded commands to the GPU */
+        PresentWait, /* Presenting and waiting for a frame slot to free up */
+        Count
+    };
+
+    inline constexpr size_t kFrameMetricCount = static_cast<size_t>(FrameMetric::Count);
+    inline constexpr size_t kMaxFrameStatsWindows = 4;
+
+    struct FrameTimings
+    {
+        std::chrono::nanoseconds frame{};
+        std::chrono::nanoseconds cpuRecord{};
+        std::chrono::nanoseconds submit{};
+        std::chrono::nanoseconds presentWait{};
+    };
+
+    /* Percentiles of one metric in milliseconds */
+    struct FramePercentiles
+    {
+        float p50 = 0.0f;
+        float p95 = 0.0f;
+        float p99 = 0.0f;
+        float max = 0.0f;
+        /* Frames the percentiles were taken from */
+        uint32_t count = 0;
+    };
+
+    struct FrameStatsSnapshot
+    {
+        /* Number of most recent frames this snapshot covers */
+        uint32_t window = 0;
+        std::array<FramePercentiles, kFrameMetricCount> metrics{};
+
+        [[nodiscard]] const FramePercentiles& Get(const FrameMetric metric) const { return metrics[static_cast<size_t>(metric)]; }
+    };
+
+    /**
+     * \brief Keeps rolling histograms of frame timings over one or more windows of recent frames
+     * \details Samples are stored in microseconds in log-scaled buckets (8 per power of two), so percentiles are within
+     *          about 6% of the real value while max is exact. Every window's histogram is updated when a frame is
+     *          recorded, so taking a snapshot never has to sort samples.
+     * \note Snapshots can be taken from any thread without blocking the recording thread, a snapshot taken while
+     *       a frame is being recorded may include part of that frame
+     * \warning Only record from one thread at a time
+     */
+    class FrameStats
+    {
+    public:
+        static constexpr size_t kBucketCount = 240;
+
+        /**
+         * \param windows How many recent frames each window covers, at most kMaxFrameStatsWindows are used
+         */
+        explicit FrameStats(std::span<const uint32_t> windows);
+        FrameStats() : FrameStats(std::array<uint32_t, 2>{120, 1000}) {}
+
+        FrameStats(const FrameStats&) = delete;
+        FrameStats& operator=(const FrameStats&) = delete;
+
+        void Record(const FrameTimings& timings);
+
+        /**
+         * \brief Computes the percentiles of every window
+         *
+         * \param out Receives one snapshot per window, in the order the windows were given
+         * \return The number of snapshots written
+         */
+        size_t Snapshot(std::span<FrameStatsSnapshot> out) const;
+        [[nodiscard]] std::vector<FrameStatsSnapshot> Snapshot() const;
+
+        [[nodiscard]] size_t GetWindowCount() const { return _windowCount; }
+        [[nodiscard]] uint64_t GetRecordedCount() const { return _recorded.load(std::memory_order_acquire); }
+
+        /* Maps microseconds to a histogram bucket */
+        static size_t GetBucket(uint32_t micros);
+        /* The value a bucket reports, the middle of the range it covers */
+        static uint32_t GetBucketValue(size_t bucket);
+    private:
+        using Histogram = std::array<std::atomic<uint32_t>, kBucketCount>;
+
+        struct Window
+        {
+            uint32_t frames = 0;
+            std::array<Histogram, kFrameMetricCount> histograms{};
+        };
+
+        std::array<std::unique_ptr<Window>, kMaxFrameStatsWindows> _windows;
+        size_t _windowCount = 0;
+
+        /* Last samples in microseconds, large enough for the biggest window */
+        std::array<std::unique_ptr<std::atomic<uint32_t>[]>, kFrameMetricCount> _samples;
+        uint32_t _capacity = 0;
+        std::atomic<uint64_t> _recorded = 0;
+
+        FramePercentiles ComputePercentiles(const Window& window, size_t metric, uint64_t recorded) const;
+    };
+}
\ No newline at end of file
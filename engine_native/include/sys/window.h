@@ -1,8 +1,11 @@
 #pragma once
 
-#include <iostream>
+#include <cstdint>
 #include <string>
+#include <vector>
 #include <SDL3/SDL.h>
+#include <core/inline_function.h>
+#include <debugging/logger.h>
 
 namespace lumi::sys
 {
@@ -17,6 +20,41 @@ namespace lumi::sys
         FullscreenBorderless /* Imitates Fullscreen but maintains the features from Windowed */
     };
 
+    /**
+     * \brief What about a window changed, render targets only rebuild for the changes that affect them
+     */
+    enum class WindowChange : uint32_t
+    {
+        None = 0,
+        Size = 1 << 0, /* The size in pixels changed */
+        Format = 1 << 1, /* The display's color format changed (e.g. HDR was toggled) */
+        Display = 1 << 2 /* The window moved to another display or the display's scale changed */
+    };
+
+    inline WindowChange operator|(WindowChange a, WindowChange b) {
+        return static_cast<WindowChange>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+    }
+    inline WindowChange operator&(WindowChange a, WindowChange b) {
+        return static_cast<WindowChange>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
+    }
+    inline WindowChange& operator|=(WindowChange& a, WindowChange b) {
+        a = a | b;
+        return a;
+    }
+
+    struct WindowChangeEvent
+    {
+        WindowChange changes;
+        /* Increases by one for every change the window publishes */
+        uint64_t generation;
+        int width;
+        int height;
+    };
+
+    using WindowChangeCallback = core::InlineFunction<void(const WindowChangeEvent&), 32>;
+    using WindowSubscription = uint32_t;
+    constexpr WindowSubscription kInvalidWindowSubscription = 0;
+
     struct WindowProperties
     {
         std::string title;
@@ -67,6 +105,21 @@ namespace lumi::sys
          */
         void Process(const SDL_Event& event);
 
+        /**
+         * \brief Calls callback every time the window's size, format or display changes
+         * \note Callbacks run on the thread that processes the window's events, in the order they subscribed
+         * \warning Don't subscribe or unsubscribe from inside a callback
+         *
+         * \param callback Receives what changed and the window's new generation
+         * \return WindowSubscription - Pass it to Unsubscribe() before whatever the callback captured is destroyed
+         */
+        [[nodiscard]] WindowSubscription Subscribe(WindowChangeCallback callback);
+
+        /**
+         * \brief Stops calling a callback added with Subscribe(), does nothing for kInvalidWindowSubscription
+         */
+        void Unsubscribe(WindowSubscription subscription);
+
         /**
          * \brief Warps the window to the provided position on the screen
          * 
@@ -186,16 +239,17 @@ namespace lumi::sys
             SDL_DisplayID displayIdx = SDL_GetDisplayForWindow(_handle);
             if (displayIdx == 0)
             {
-                std::cout << "Failed to get display index for window " << GetID() << "; " 
-                          << "Falling back to primary display" << std::endl;
+                LUMI_LOG_WARN(debugging::LogSysWindow,
+                    "Failed to get display index for window {}; Falling back to primary display", GetID()
+                );
                 displayIdx = SDL_GetPrimaryDisplay();
             }
             SDL_Rect displayBounds;
             if (!SDL_GetDisplayBounds(displayIdx, &displayBounds)) // Ensure that we can retrieve a rectangle of the display
             {
-                std::cerr << "Failed to get display bounds for window " << GetID() 
-                          << " "
-                          << SDL_GetError() << std::endl;
+                LUMI_LOG_ERROR(debugging::LogSysWindow,
+                    "Failed to get display bounds for window {} {}", GetID(), SDL_GetError()
+                );
                 return false;
             }
             *rect = displayBounds;
@@ -209,9 +263,13 @@ namespace lumi::sys
          */
         [[nodiscard]] bool Closing() const { return _needsClose; }
 
+        /* Size of the window in pixels, follows resizes once their events are processed */
         [[nodiscard]] int GetWidth() const { return _width; }
         [[nodiscard]] int GetHeight() const { return _height; }
 
+        /* Number of changes published so far, compare it against a copy to see if anything changed since */
+        [[nodiscard]] uint64_t GetGeneration() const { return _generation; }
+
         /**
          * \brief Retrieves the handle.
          * \return SDL_Window - The handle associated with this window.
@@ -231,6 +289,15 @@ namespace lumi::sys
          */
         virtual SDL_Window* CreateWindowObject();
     private:
+        struct Subscriber
+        {
+            WindowSubscription id;
+            WindowChangeCallback callback;
+        };
+
+        /* Bumps the generation and tells every subscriber about changes */
+        void Publish(WindowChange changes);
+
         SDL_Window* _handle = nullptr;
         bool _needsClose = false;
 
@@ -250,5 +317,9 @@ namespace lumi::sys
         int _hMax = 0;
         int _wMin = 0;
         int _hMin = 0;
+
+        uint64_t _generation = 0;
+        WindowSubscription _nextSubscription = kInvalidWindowSubscription + 1;
+        std::vector<Subscriber> _subscribers;
     };
 }
\ No newline at end of file
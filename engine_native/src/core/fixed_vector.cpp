@@ -0,0 +1,13 @@
+#include <core/fixed_vector.h>
+#include <debugging/logger.h>
+
+namespace lumi::core
+{
+    void ReportFixedVectorOverflow(const size_t capacity, const size_t count)
+    {
+        LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogCore, std::chrono::seconds(1),
+            "A fixed vector of {} items was given {}, the ones past its capacity were dropped",
+            capacity, count
+        );
+    }
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <core/frame_arena.h>
+
+namespace lumi::core
+{
+    LinearArena::LinearArena(const size_t blockSize)
+        : _blockSize(std::max<size_t>(blockSize, 64))
+    {
+    }
+
+    void* LinearArena::Allocate(const size_t size, const size_t alignment)
+    {
+        while (true)
+        {
+            if (_block < _blocks.size())
+            {
+                Block& block = _blocks[_block];
+                auto address = reinterpret_cast<uintptr_t>(block.data.get()) + _offset;
+                size_t padding = (alignment - address % alignment) % alignment;
+                if (_offset + padding + size <= block.size)
+                {
+                    _offset += padding + size;
+                    _used += padding + size;
+                    return reinterpret_cast<void*>(address + padding);
+                }
+
+                // Whatever is left at the end of a block is wasted until the arena resets and merges its blocks
+                if (_block + 1 < _blocks.size())
+                {
+                    ++_block;
+                    _offset = 0;
+                    continue;
+                }
+            }
+
+            AddBlock(size + alignment);
+            _block = _blocks.size() - 1;
+            _offset = 0;
+        }
+    }
+
+    void LinearArena::Reset()
+    {
+        if (_blocks.size() > 1)
+        {
+            size_t capacity = GetCapacity();
+            _blocks.clear();
+            AddBlock(capacity);
+        }
+        _block = 0;
+        _offset = 0;
+        _used = 0;
+    }
+
+    size_t LinearArena::GetCapacity() const
+    {
+        size_t capacity = 0;
+        for (const auto& block : _blocks)
+        {
+            capacity += block.size;
+        }
+        return capacity;
+    }
+
+    void LinearArena::AddBlock(const size_t minSize)
+    {
+        size_t size = std::max(_blockSize, minSize);
+        _blocks.push_back({ std::make_unique_for_overwrite<std::byte[]>(size), size });
+    }
+
+    void FrameArena::SetFrameCount(const uint32_t count)
+    {
+        _arenas.clear();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            _arenas.emplace_back();
+        }
+    }
+
+    void FrameArena::BeginFrame(const uint32_t frame)
+    {
+        if (frame < _arenas.size())
+        {
+            _arenas[frame].Reset();
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,408 @@
+#include <format>
+#include <utility>
+#include <core/job_system.h>
+#include <debugging/profiler.h>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace lumi::core
+{
+    struct Job
+    {
+        JobFunction function;
+        JobCounter* counter = nullptr;
+        JobAffinity affinity = JobAffinity::Any;
+        /* The next job waiting on the same counter */
+        Job* next = nullptr;
+        /* Jobs from threads outside of the pool don't have slots and are deleted once they run */
+        bool allocated = false;
+        std::atomic<bool> inUse = false;
+    };
+
+    struct JobSystem::ThreadData
+    {
+        WorkStealingDeque<Job*, kJobsPerThread> deque;
+        std::unique_ptr<Job[]> jobs = std::make_unique<Job[]>(kJobsPerThread);
+        size_t nextJob = 0;
+        uint32_t stealSeed = 0;
+    };
+
+    namespace
+    {
+        thread_local uint32_t t_threadIndex = JobSystem::kNoThreadIndex;
+
+        /* Spins before giving up the time slice, waits are usually short */
+        constexpr uint32_t kSpinCount = 64;
+
+        void CpuPause()
+        {
+            #if defined(_MSC_VER)
+            _mm_pause();
+            #elif defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+            #else
+            std::this_thread::yield();
+            #endif
+        }
+    }
+
+    JobSystem::JobSystem() = default;
+
+    JobSystem::~JobSystem()
+    {
+        Stop();
+    }
+
+    void JobSystem::Start(const uint32_t workerCount)
+    {
+        Stop();
+
+        _workerCount = workerCount;
+        for (uint32_t i = 0; i <= workerCount; ++i)
+        {
+            auto data = std::make_unique<ThreadData>();
+            data->stealSeed = i * 2654435761u + 1;
+            _threads.push_back(std::move(data));
+        }
+
+        t_threadIndex = 0;
+        _running.store(true, std::memory_order_release);
+        for (uint32_t i = 1; i <= workerCount; ++i)
+        {
+            _workers.emplace_back([this, i] { WorkerLoop(i); });
+        }
+    }
+
+    void JobSystem::Stop()
+    {
+        if (!_running.exchange(false, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        {
+            std::lock_guard lock(_sleepMutex);
+            _epoch.fetch_add(1);
+        }
+        _wake.notify_all();
+        for (auto& worker : _workers)
+        {
+            worker.join();
+        }
+        _workers.clear();
+
+        std::lock_guard lock(_sharedMutex);
+        for (auto* jobs : { &_sharedJobs, &_mainThreadJobs })
+        {
+            for (Job* job : *jobs)
+            {
+                if (job->allocated) delete job;
+            }
+        }
+        _sharedJobs.clear();
+        _mainThreadJobs.clear();
+        _mainThreadJobCount.store(0, std::memory_order_relaxed);
+        _threads.clear();
+        _workerCount = 0;
+        t_threadIndex = kNoThreadIndex;
+    }
+
+    void JobSystem::Run(JobFunction function, JobCounter* counter, const JobAffinity affinity)
+    {
+        if (counter)
+        {
+            counter->_pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (!IsRunning())
+        {
+            function();
+            if (counter) Finish(*counter);
+            return;
+        }
+
+        Submit(AllocateJob(function, counter, affinity));
+    }
+
+    void JobSystem::RunAfter(JobCounter& dependency, JobFunction function, JobCounter* counter, const JobAffinity affinity)
+    {
+        if (counter)
+        {
+            counter->_pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (!IsRunning())
+        {
+            // Without workers every job ran when it was added, so the dependency is already done
+            function();
+            if (counter) Finish(*counter);
+            return;
+        }
+
+        Job* job = AllocateJob(function, counter, affinity);
+        {
+            std::lock_guard lock(dependency._mutex);
+            if (dependency._pending.load(std::memory_order_acquire) != 0)
+            {
+                job->next = dependency._waiting;
+                dependency._waiting = job;
+                return;
+            }
+        }
+        Submit(job);
+    }
+
+    void JobSystem::Wait(JobCounter& counter)
+    {
+        uint32_t threadIndex = t_threadIndex;
+        uint32_t spins = 0;
+        while (!counter.IsDone())
+        {
+            if (IsRunning() && TryRunJob(threadIndex))
+            {
+                spins = 0;
+                continue;
+            }
+
+            if (++spins < kSpinCount)
+            {
+                CpuPause();
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        // The thread that finished the last job may still hold the lock, the counter can't go away before it lets go
+        std::lock_guard lock(counter._mutex);
+    }
+
+    void JobSystem::RunMainThreadJobs()
+    {
+        if (!IsMainThread())
+        {
+            return;
+        }
+
+        while (TryRunMainThreadJob())
+        {
+        }
+    }
+
+    uint32_t JobSystem::GetThreadIndex()
+    {
+        return t_threadIndex;
+    }
+
+    Job* JobSystem::AllocateJob(JobFunction& function, JobCounter* counter, const JobAffinity affinity)
+    {
+        Job* job = nullptr;
+
+        // Slots are reused in order, a slot still in use is skipped
+        uint32_t threadIndex = t_threadIndex;
+        if (threadIndex < _threads.size())
+        {
+            ThreadData& data = *_threads[threadIndex];
+            for (size_t attempt = 0; attempt < kJobsPerThread && !job; ++attempt)
+            {
+                Job& slot = data.jobs[data.nextJob];
+                data.nextJob = (data.nextJob + 1) % kJobsPerThread;
+                if (!slot.inUse.load(std::memory_order_acquire))
+                {
+                    slot.inUse.store(true, std::memory_order_relaxed);
+                    job = &slot;
+                }
+            }
+        }
+
+        if (!job)
+        {
+            job = new Job();
+            job->allocated = true;
+        }
+
+        job->function = std::move(function);
+        job->counter = counter;
+        job->affinity = affinity;
+        return job;
+    }
+
+    void JobSystem::Submit(Job* job)
+    {
+        if (job->affinity == JobAffinity::MainThread)
+        {
+            std::lock_guard lock(_sharedMutex);
+            _mainThreadJobs.push_back(job);
+            _mainThreadJobCount.fetch_add(1, std::memory_order_release);
+            return;
+        }
+
+        uint32_t threadIndex = t_threadIndex;
+        if (threadIndex >= _threads.size() || !_threads[threadIndex]->deque.Push(job))
+        {
+            std::lock_guard lock(_sharedMutex);
+            _sharedJobs.push_back(job);
+        }
+        WakeWorkers();
+    }
+
+    bool JobSystem::TryRunJob(const uint32_t threadIndex)
+    {
+        Job* job = nullptr;
+        bool inPool = threadIndex < _threads.size();
+        if (inPool && _threads[threadIndex]->deque.Pop(job))
+        {
+            Execute(job);
+            return true;
+        }
+
+        if (threadIndex == 0 && TryRunMainThreadJob())
+        {
+            return true;
+        }
+
+        {
+            std::lock_guard lock(_sharedMutex);
+            if (!_sharedJobs.empty())
+            {
+                job = _sharedJobs.back();
+                _sharedJobs.pop_back();
+            }
+        }
+        if (job)
+        {
+            Execute(job);
+            return true;
+        }
+
+        // Steal from the other threads, starting at a random one so thieves spread out
+        auto threadCount = static_cast<uint32_t>(_threads.size());
+        uint32_t start = 0;
+        if (inPool)
+        {
+            uint32_t& seed = _threads[threadIndex]->stealSeed;
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            start = seed % threadCount;
+        }
+
+        for (uint32_t i = 0; i < threadCount; ++i)
+        {
+            uint32_t victim = (start + i) % threadCount;
+            if (victim != threadIndex && _threads[victim]->deque.Steal(job))
+            {
+                Execute(job);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool JobSystem::TryRunMainThreadJob()
+    {
+        if (_mainThreadJobCount.load(std::memory_order_acquire) == 0)
+        {
+            return false;
+        }
+
+        Job* job = nullptr;
+        {
+            std::lock_guard lock(_sharedMutex);
+            if (_mainThreadJobs.empty())
+            {
+                return false;
+            }
+            job = _mainThreadJobs.front();
+            _mainThreadJobs.erase(_mainThreadJobs.begin());
+            _mainThreadJobCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        Execute(job);
+        return true;
+    }
+
+    void JobSystem::Execute(Job* job)
+    {
+        job->function();
+        job->function = nullptr;
+
+        JobCounter* counter = job->counter;
+        if (job->allocated)
+        {
+            delete job;
+        }
+        else
+        {
+            job->inUse.store(false, std::memory_order_release);
+        }
+
+        if (counter)
+        {
+            Finish(*counter);
+        }
+    }
+
+    void JobSystem::Finish(JobCounter& counter)
+    {
+        Job* ready = nullptr;
+        {
+            std::lock_guard lock(counter._mutex);
+            if (counter._pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            {
+                return;
+            }
+            ready = std::exchange(counter._waiting, nullptr);
+        }
+
+        while (ready)
+        {
+            Job* job = std::exchange(ready, ready->next);
+            job->next = nullptr;
+            Submit(job);
+        }
+    }
+
+    void JobSystem::WakeWorkers()
+    {
+        _epoch.fetch_add(1);
+        if (_sleeping.load() > 0)
+        {
+            std::lock_guard lock(_sleepMutex);
+            _wake.notify_one();
+        }
+    }
+
+    void JobSystem::WorkerLoop(const uint32_t threadIndex)
+    {
+        t_threadIndex = threadIndex;
+        debugging::Profiler::Instance().SetThreadName(std::format("Job Worker {}", threadIndex));
+
+        while (_running.load(std::memory_order_acquire))
+        {
+            uint64_t seen = _epoch.load();
+
+            bool ran = false;
+            for (uint32_t spin = 0; spin < kSpinCount && !ran; ++spin)
+            {
+                ran = TryRunJob(threadIndex);
+                if (!ran) CpuPause();
+            }
+            if (ran)
+            {
+                continue;
+            }
+
+            std::unique_lock lock(_sleepMutex);
+            _sleeping.fetch_add(1);
+            _wake.wait(lock, [&]
+            {
+                return _epoch.load() != seen || !_running.load(std::memory_order_acquire);
+            });
+            _sleeping.fetch_sub(1);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+#include <core/job_system.h>
+#include <core/radix_sort.h>
+#include <debugging/logger.h>
+#include <debugging/profiler.h>
+
+namespace lumi::core
+{
+    namespace
+    {
+        /* 11 bits sorts 64 bit keys in 6 passes instead of 8, and a pass's histogram still fits in L1 */
+        constexpr uint32_t kDigitBits = 11;
+        constexpr uint32_t kBuckets = 1u << kDigitBits;
+        constexpr uint32_t kPasses = (64 + kDigitBits - 1) / kDigitBits;
+        /* Smaller chunks spend more time handing out jobs than sorting */
+        constexpr size_t kMinChunkSize = 32 * 1024;
+
+        using Histogram = std::array<uint32_t, kBuckets>;
+        using ChunkHistograms = std::array<Histogram, kPasses>;
+
+        uint32_t GetDigit(const uint64_t key, const uint32_t pass)
+        {
+            return static_cast<uint32_t>(key >> (pass * kDigitBits)) & (kBuckets - 1);
+        }
+    }
+
+    void RadixSort(const std::span<SortEntry> entries, const std::span<SortEntry> scratch)
+    {
+        const size_t count = entries.size();
+        if (count < 2)
+        {
+            return;
+        }
+        if (scratch.size() < count)
+        {
+            LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogCore, std::chrono::seconds(1),
+                "Radix sort of {} entries was given scratch space for only {}, the entries were left unsorted",
+                count, scratch.size()
+            );
+            return;
+        }
+        LUMI_PROFILE_ZONE("RadixSort");
+
+        auto& jobs = JobSystem::Instance();
+        size_t chunkCount = 1;
+        if (jobs.IsRunning())
+        {
+            chunkCount = std::clamp<size_t>(count / kMinChunkSize, 1, jobs.GetThreadCount());
+        }
+        const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+        // Kept between calls so sorting every frame doesn't allocate, each chunk only touches its own histograms
+        thread_local std::vector<ChunkHistograms> cachedHistograms;
+        if (cachedHistograms.size() < chunkCount)
+        {
+            cachedHistograms.resize(chunkCount);
+        }
+        // Jobs must see the sorting thread's histograms, not their own thread's
+        ChunkHistograms* histograms = cachedHistograms.data();
+
+        auto forEachChunk = [&](auto&& body)
+        {
+            jobs.ParallelFor(chunkCount, 1, [&](const size_t begin, const size_t end)
+            {
+                for (size_t chunk = begin; chunk < end; ++chunk)
+                {
+                    body(chunk, std::min(count, chunk * chunkSize), std::min(count, (chunk + 1) * chunkSize));
+                }
+            });
+        };
+
+        // Count every digit in one read, it tells which passes can be skipped and gives the first pass its counts
+        forEachChunk([&](const size_t chunk, const size_t begin, const size_t end)
+        {
+            auto& chunkHistograms = histograms[chunk];
+            for (auto& histogram : chunkHistograms)
+            {
+                histogram.fill(0);
+            }
+            for (size_t i = begin; i < end; ++i)
+            {
+                const uint64_t key = entries[i].key;
+                for (uint32_t pass = 0; pass < kPasses; ++pass)
+                {
+                    ++chunkHistograms[pass][GetDigit(key, pass)];
+                }
+            }
+        });
+
+        std::array<bool, kPasses> needed{};
+        for (uint32_t pass = 0; pass < kPasses; ++pass)
+        {
+            Histogram total{};
+            for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+            {
+                for (uint32_t digit = 0; digit < kBuckets; ++digit)
+                {
+                    total[digit] += histograms[chunk][pass][digit];
+                }
+            }
+            needed[pass] = std::none_of(total.begin(), total.end(), [count](const uint32_t n) { return n == count; });
+        }
+
+        SortEntry* source = entries.data();
+        SortEntry* destination = scratch.data();
+        bool counted = true;
+        for (uint32_t pass = 0; pass < kPasses; ++pass)
+        {
+            if (!needed[pass])
+            {
+                continue;
+            }
+
+            // Chunk counts from the first read only hold while the entries are still in their original order
+            if (!counted)
+            {
+                forEachChunk([&](const size_t chunk, const size_t begin, const size_t end)
+                {
+                    Histogram& histogram = histograms[chunk][pass];
+                    histogram.fill(0);
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        ++histogram[GetDigit(source[i].key, pass)];
+                    }
+                });
+            }
+            counted = false;
+
+            // Turn the counts into where each chunk writes each digit, earlier chunks first to keep the sort stable
+            uint32_t offset = 0;
+            for (uint32_t digit = 0; digit < kBuckets; ++digit)
+            {
+                for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+                {
+                    uint32_t& slot = histograms[chunk][pass][digit];
+                    const uint32_t digitCount = slot;
+                    slot = offset;
+                    offset += digitCount;
+                }
+            }
+
+            forEachChunk([&](const size_t chunk, const size_t begin, const size_t end)
+            {
+                // A local copy, the compiler can't tell writes to destination don't change the offsets
+                Histogram offsets = histograms[chunk][pass];
+                for (size_t i = begin; i < end; ++i)
+                {
+                    destination[offsets[GetDigit(source[i].key, pass)]++] = source[i];
+                }
+            });
+
+            std::swap(source, destination);
+        }
+
+        if (source != entries.data())
+        {
+            std::memcpy(entries.data(), source, count * sizeof(SortEntry));
+        }
+    }
+}
\ No newline at end of file
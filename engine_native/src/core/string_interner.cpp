@@ -0,0 +1,43 @@
+#include <core/string_interner.h>
+
+namespace lumi::core
+{
+    InternedString StringInterner::Intern(const std::string_view string)
+    {
+        auto it = _ids.find(string);
+        if (it != _ids.end())
+        {
+            return { it->second };
+        }
+
+        auto id = static_cast<uint32_t>(_strings.size());
+        const std::string& stored = _strings.emplace_back(string);
+        _ids.emplace(stored, id);
+        return { id };
+    }
+
+    InternedString StringInterner::Find(const std::string_view string) const
+    {
+        auto it = _ids.find(string);
+        if (it == _ids.end())
+        {
+            return {};
+        }
+        return { it->second };
+    }
+
+    std::string_view StringInterner::GetString(const InternedString string) const
+    {
+        if (string.id >= _strings.size())
+        {
+            return {};
+        }
+        return _strings[string.id];
+    }
+
+    void StringInterner::Clear()
+    {
+        _ids.clear();
+        _strings.clear();
+    }
+}
\ No newline at end of file
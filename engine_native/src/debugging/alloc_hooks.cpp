@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <debugging/alloc_tracker.h>
+
+/**
+ * Replaces the global operator new and delete so AllocTracker can count allocations.
+ * This is built as the debugalloc object library, link it into an executable to opt in.
+ */
+
+namespace
+{
+    using lumi::debugging::AllocTracker;
+
+    void* Allocate(std::size_t size) noexcept
+    {
+        void* ptr = std::malloc(size == 0 ? 1 : size);
+        if (ptr)
+        {
+            AllocTracker::OnAllocate(size);
+        }
+        return ptr;
+    }
+
+    void* AllocateAligned(std::size_t size, std::align_val_t alignment) noexcept
+    {
+        size = size == 0 ? 1 : size;
+
+        #ifdef _WIN32
+        void* ptr = _aligned_malloc(size, static_cast<std::size_t>(alignment));
+        #else
+        void* ptr = nullptr;
+        if (posix_memalign(&ptr, std::max(static_cast<std::size_t>(alignment), sizeof(void*)), size) != 0)
+        {
+            ptr = nullptr;
+        }
+        #endif
+
+        if (ptr)
+        {
+            AllocTracker::OnAllocate(size);
+        }
+        return ptr;
+    }
+
+    void Free(void* ptr) noexcept
+    {
+        if (ptr)
+        {
+            AllocTracker::OnFree();
+            std::free(ptr);
+        }
+    }
+
+    void FreeAligned(void* ptr) noexcept
+    {
+        if (ptr)
+        {
+            AllocTracker::OnFree();
+            #ifdef _WIN32
+            _aligned_free(ptr);
+            #else
+            std::free(ptr);
+            #endif
+        }
+    }
+
+    void* AllocateOrThrow(std::size_t size)
+    {
+        while (true)
+        {
+            if (void* ptr = Allocate(size))
+            {
+                return ptr;
+            }
+
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+            {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    void* AllocateAlignedOrThrow(std::size_t size, std::align_val_t alignment)
+    {
+        while (true)
+        {
+            if (void* ptr = AllocateAligned(size, alignment))
+            {
+                return ptr;
+            }
+
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+            {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+}
+
+void* operator new(std::size_t size) { return AllocateOrThrow(size); }
+void* operator new[](std::size_t size) { return AllocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return AllocateAlignedOrThrow(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return AllocateAlignedOrThrow(size, alignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateAligned(size, alignment); }
+
+void operator delete(void* ptr) noexcept { Free(ptr); }
+void operator delete[](void* ptr) noexcept { Free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { Free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { Free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { Free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { Free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(ptr); }
\ No newline at end of file
@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <format>
+#include <debugging/alloc_tracker.h>
+#include <debugging/logger.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <dbghelp.h>
+#elif __has_include(<execinfo.h>)
+    #include <execinfo.h>
+    #include <cxxabi.h>
+    #define LUMI_HAS_EXECINFO 1
+#endif
+
+namespace lumi::debugging
+{
+    namespace
+    {
+        /* Frames belonging to the tracker, the hooks' own frames depend on inlining and are trimmed when resolving */
+        constexpr uint32_t kSkippedFrames = 2;
+
+        /* Set while a thread is capturing a stack, so anything allocating underneath isn't captured again */
+        thread_local bool t_capturing = false;
+
+        uint32_t CaptureStack(void** frames, const uint32_t depth)
+        {
+            #ifdef _WIN32
+            return RtlCaptureStackBackTrace(kSkippedFrames, depth, frames, nullptr);
+            #elif defined(LUMI_HAS_EXECINFO)
+            void* buffer[AllocTracker::kCallSiteDepth + kSkippedFrames];
+            int captured = backtrace(buffer, static_cast<int>(depth + kSkippedFrames));
+            uint32_t count = captured > static_cast<int>(kSkippedFrames) ? static_cast<uint32_t>(captured) - kSkippedFrames : 0;
+            std::copy(buffer + kSkippedFrames, buffer + kSkippedFrames + count, frames);
+            return count;
+            #else
+            (void)frames;
+            (void)depth;
+            return 0;
+            #endif
+        }
+
+        uint64_t HashStack(void* const* frames, const uint32_t depth)
+        {
+            uint64_t hash = 14695981039346656037ull;
+            for (uint32_t i = 0; i < depth; ++i)
+            {
+                hash ^= reinterpret_cast<uintptr_t>(frames[i]);
+                hash *= 1099511628211ull;
+            }
+            return hash == 0 ? 1 : hash;
+        }
+
+        std::vector<std::string> ResolveStack(void* const* frames, const uint32_t depth)
+        {
+            std::vector<std::string> resolved;
+
+            #ifdef _WIN32
+            static const bool initialized = SymInitialize(GetCurrentProcess(), nullptr, TRUE) != FALSE;
+            alignas(SYMBOL_INFO) char buffer[sizeof(SYMBOL_INFO) + 256] = {};
+            auto* symbol = reinterpret_cast<SYMBOL_INFO*>(buffer);
+            symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+            symbol->MaxNameLen = 255;
+
+            for (uint32_t i = 0; i < depth; ++i)
+            {
+                auto address = reinterpret_cast<DWORD64>(frames[i]);
+                std::string name = std::format("0x{:x}", address);
+                if (initialized && SymFromAddr(GetCurrentProcess(), address, nullptr, symbol))
+                {
+                    name = symbol->Name;
+
+                    IMAGEHLP_LINE64 line = {};
+                    line.SizeOfStruct = sizeof(line);
+                    DWORD displacement = 0;
+                    if (SymGetLineFromAddr64(GetCurrentProcess(), address, &displacement, &line))
+                    {
+                        name += std::format(" ({}:{})", line.FileName, line.LineNumber);
+                    }
+                }
+                resolved.push_back(std::move(name));
+            }
+            #elif defined(LUMI_HAS_EXECINFO)
+            char** symbols = backtrace_symbols(frames, static_cast<int>(depth));
+            for (uint32_t i = 0; i < depth; ++i)
+            {
+                std::string name = symbols ? symbols[i] : std::format("{}", frames[i]);
+
+                // Entries look like "binary(mangled+0x1f) [0x...]", swap the mangled name for a readable one
+                size_t open = name.find('(');
+                size_t plus = name.find('+', open);
+                if (open != std::string::npos && plus != std::string::npos && plus > open + 1)
+                {
+                    std::string mangled = name.substr(open + 1, plus - open - 1);
+                    int status = 0;
+                    char* demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+                    if (status == 0 && demangled)
+                    {
+                        name.replace(open + 1, mangled.size(), demangled);
+                    }
+                    std::free(demangled);
+                }
+                resolved.push_back(std::move(name));
+            }
+            std::free(symbols);
+
+            // Drop the allocation hooks, the report should start at the code that allocated
+            auto hook = std::find_if(resolved.rbegin(), resolved.rend(), [](const std::string& frame)
+            {
+                return frame.find("operator new") != std::string::npos;
+            });
+            resolved.erase(resolved.begin(), hook.base());
+            #else
+            for (uint32_t i = 0; i < depth; ++i)
+            {
+                resolved.push_back(std::format("{}", frames[i]));
+            }
+            #endif
+
+            return resolved;
+        }
+    }
+
+    void AllocTracker::OnAllocate(const size_t size)
+    {
+        if (!s_hooked.load(std::memory_order_relaxed))
+        {
+            s_hooked.store(true, std::memory_order_relaxed);
+        }
+
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+        s_bytes.fetch_add(size, std::memory_order_relaxed);
+
+        AllocStats& thread = GetThreadStats();
+        ++thread.allocations;
+        thread.bytes += size;
+
+        if (s_captureCallSites.load(std::memory_order_relaxed) && !t_capturing)
+        {
+            Instance().RecordCallSite(size);
+        }
+    }
+
+    void AllocTracker::OnFree()
+    {
+        s_frees.fetch_add(1, std::memory_order_relaxed);
+        ++GetThreadStats().frees;
+    }
+
+    bool AllocTracker::MarkFrame()
+    {
+        AllocStats now = GetTotals();
+        _lastFrame.allocations = now.allocations - _frameStart.allocations;
+        _lastFrame.bytes = now.bytes - _frameStart.bytes;
+        _lastFrame.frees = now.frees - _frameStart.frees;
+        _frameStart = now;
+
+        if (_lastFrame.allocations <= _budget.allocations && _lastFrame.bytes <= _budget.bytes)
+        {
+            return true;
+        }
+
+        ++_violations;
+        if (_budget.abortOnExceed)
+        {
+            LUMI_LOG_ERROR(LogCore, "Frame made {} allocations ({} bytes), the budget is {} allocations ({} bytes)",
+                _lastFrame.allocations, _lastFrame.bytes, _budget.allocations, _budget.bytes);
+            LogCallSites();
+            Logger::Instance().Flush();
+            std::abort();
+        }
+        return false;
+    }
+
+    void AllocTracker::SetCallSiteCapture(const bool capture)
+    {
+        s_captureCallSites.store(capture, std::memory_order_relaxed);
+    }
+
+    void AllocTracker::ClearCallSites()
+    {
+        for (auto& slot : _callSites)
+        {
+            slot.ready.store(false, std::memory_order_relaxed);
+            slot.allocations.store(0, std::memory_order_relaxed);
+            slot.bytes.store(0, std::memory_order_relaxed);
+            slot.hash.store(0, std::memory_order_release);
+        }
+    }
+
+    std::vector<AllocCallSite> AllocTracker::GetCallSites(const size_t maxSites) const
+    {
+        // Nothing below may be captured, resolving symbols allocates
+        t_capturing = true;
+
+        std::vector<const CallSiteSlot*> slots;
+        for (const auto& slot : _callSites)
+        {
+            if (slot.ready.load(std::memory_order_acquire))
+            {
+                slots.push_back(&slot);
+            }
+        }
+
+        std::sort(slots.begin(), slots.end(), [](const CallSiteSlot* a, const CallSiteSlot* b)
+        {
+            return a->allocations.load(std::memory_order_relaxed) > b->allocations.load(std::memory_order_relaxed);
+        });
+        slots.resize(std::min(slots.size(), maxSites));
+
+        std::vector<AllocCallSite> sites;
+        for (const CallSiteSlot* slot : slots)
+        {
+            AllocCallSite site;
+            site.allocations = slot->allocations.load(std::memory_order_relaxed);
+            site.bytes = slot->bytes.load(std::memory_order_relaxed);
+            site.frames = ResolveStack(slot->frames.data(), slot->depth);
+            sites.push_back(std::move(site));
+        }
+
+        t_capturing = false;
+        return sites;
+    }
+
+    void AllocTracker::LogCallSites(const size_t maxSites) const
+    {
+        for (const auto& site : GetCallSites(maxSites))
+        {
+            LUMI_LOG_WARN(LogCore, "{} allocations ({} bytes) from:", site.allocations, site.bytes);
+            for (const auto& frame : site.frames)
+            {
+                LUMI_LOG_WARN(LogCore, "    {}", frame);
+            }
+        }
+    }
+
+    AllocStats AllocTracker::GetTotals() const
+    {
+        AllocStats totals;
+        totals.allocations = s_allocations.load(std::memory_order_relaxed);
+        totals.bytes = s_bytes.load(std::memory_order_relaxed);
+        totals.frees = s_frees.load(std::memory_order_relaxed);
+        return totals;
+    }
+
+    void AllocTracker::RecordCallSite(const size_t size)
+    {
+        t_capturing = true;
+
+        void* frames[kCallSiteDepth];
+        uint32_t depth = CaptureStack(frames, kCallSiteDepth);
+        uint64_t hash = HashStack(frames, depth);
+
+        // Open addressing, a stack claims the first empty slot and fills in its frames before marking it ready
+        for (size_t probe = 0; probe < kMaxCallSites; ++probe)
+        {
+            CallSiteSlot& slot = _callSites[(hash + probe) % kMaxCallSites];
+            uint64_t existing = slot.hash.load(std::memory_order_acquire);
+            if (existing == 0 && slot.hash.compare_exchange_strong(existing, hash, std::memory_order_acq_rel))
+            {
+                std::copy(frames, frames + depth, slot.frames.begin());
+                slot.depth = depth;
+                slot.ready.store(true, std::memory_order_release);
+                existing = hash;
+            }
+
+            if (existing == hash)
+            {
+                slot.allocations.fetch_add(1, std::memory_order_relaxed);
+                slot.bytes.fetch_add(size, std::memory_order_relaxed);
+                break;
+            }
+        }
+
+        t_capturing = false;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include <debugging/binary_log.h>
+#include <debugging/log_category.h>
+#include <debugging/log_format.h>
+
+namespace lumi::debugging
+{
+    using binary_log::BinaryLogEntry;
+
+    namespace
+    {
+        template<typename V>
+        void Put(std::ofstream& file, const V& value)
+        {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(V));
+        }
+
+        template<typename V>
+        bool Get(std::ifstream& file, V& value)
+        {
+            return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(V)));
+        }
+
+        bool GetBytes(std::ifstream& file, std::string& out, uint16_t length)
+        {
+            out.resize(length);
+            return static_cast<bool>(file.read(out.data(), length));
+        }
+    }
+
+    BinaryLogFileSink::BinaryLogFileSink(const std::string& path)
+        : _file(path, std::ios::binary | std::ios::trunc)
+    {
+        if (_file)
+        {
+            _file.write(binary_log::kMagic, sizeof(binary_log::kMagic));
+        }
+    }
+
+    void BinaryLogFileSink::Write(const LogMessage& message)
+    {
+        if (!_file)
+        {
+            return;
+        }
+
+        uint16_t category = WriteCategory(message.category);
+        if (!message.deferred)
+        {
+            auto length = static_cast<uint16_t>(std::min<size_t>(message.text.size(), UINT16_MAX));
+            Put(_file, BinaryLogEntry::Text);
+            Put(_file, message.timestamp);
+            Put(_file, message.threadId);
+            Put(_file, category);
+            Put(_file, message.type);
+            Put(_file, length);
+            _file.write(message.text.data(), length);
+            return;
+        }
+
+        if (_writtenFormats.insert(message.formatId).second)
+        {
+            auto length = static_cast<uint16_t>(std::min<size_t>(message.format.size(), UINT16_MAX));
+            Put(_file, BinaryLogEntry::Format);
+            Put(_file, message.formatId);
+            Put(_file, length);
+            _file.write(message.format.data(), length);
+        }
+
+        auto length = static_cast<uint16_t>(message.args.size());
+        Put(_file, BinaryLogEntry::Record);
+        Put(_file, message.timestamp);
+        Put(_file, message.threadId);
+        Put(_file, category);
+        Put(_file, message.formatId);
+        Put(_file, message.type);
+        Put(_file, length);
+        _file.write(message.args.data(), length);
+    }
+
+    void BinaryLogFileSink::Flush()
+    {
+        _file.flush();
+    }
+
+    uint16_t BinaryLogFileSink::WriteCategory(const LogCategory* category)
+    {
+        if (!category)
+        {
+            return binary_log::kNoCategory;
+        }
+
+        uint16_t index = category->GetIndex();
+        if (_writtenCategories.insert(index).second)
+        {
+            std::string_view name = category->GetName();
+            auto length = static_cast<uint16_t>(name.size());
+            Put(_file, BinaryLogEntry::Category);
+            Put(_file, index);
+            Put(_file, length);
+            _file.write(name.data(), length);
+        }
+        return index;
+    }
+
+    bool BinaryLogReader::Open(const std::string& path)
+    {
+        _file.open(path, std::ios::binary);
+        if (!_file)
+        {
+            return false;
+        }
+
+        char magic[sizeof(binary_log::kMagic)];
+        if (!_file.read(magic, sizeof(magic)))
+        {
+            return false;
+        }
+        return std::equal(std::begin(magic), std::end(magic), std::begin(binary_log::kMagic));
+    }
+
+    bool BinaryLogReader::Next(LogMessage& message, std::string& text)
+    {
+        BinaryLogEntry entry;
+        while (Get(_file, entry))
+        {
+            switch (entry)
+            {
+                case BinaryLogEntry::Format:
+                {
+                    uint32_t id = 0;
+                    uint16_t length = 0;
+                    if (!Get(_file, id) || !Get(_file, length) || !GetBytes(_file, _formats[id], length))
+                        return false;
+                    break;
+                }
+                case BinaryLogEntry::Category:
+                {
+                    uint16_t index = 0;
+                    uint16_t length = 0;
+                    if (!Get(_file, index) || !Get(_file, length) || !GetBytes(_file, _categories[index], length))
+                        return false;
+                    break;
+                }
+                case BinaryLogEntry::Record:
+                {
+                    uint16_t category = 0;
+                    uint16_t length = 0;
+                    message = {};
+                    if (!Get(_file, message.timestamp) || !Get(_file, message.threadId) || !Get(_file, category)
+                        || !Get(_file, message.formatId) || !Get(_file, message.type) || !Get(_file, length)
+                        || !GetBytes(_file, _args, length))
+                        return false;
+                    ReadCategory(category);
+
+                    auto format = _formats.find(message.formatId);
+                    message.deferred = true;
+                    message.args = _args;
+                    text.clear();
+                    if (format != _formats.end())
+                    {
+                        message.format = format->second;
+                        FormatLogArgs(message.format, message.args, text);
+                    }
+                    else
+                    {
+                        text = "<unknown format>";
+                    }
+                    message.text = text;
+                    return true;
+                }
+                case BinaryLogEntry::Text:
+                {
+                    uint16_t category = 0;
+                    uint16_t length = 0;
+                    message = {};
+                    if (!Get(_file, message.timestamp) || !Get(_file, message.threadId) || !Get(_file, category)
+                        || !Get(_file, message.type) || !Get(_file, length) || !GetBytes(_file, text, length))
+                        return false;
+                    ReadCategory(category);
+                    message.text = text;
+                    return true;
+                }
+                default:
+                    return false;
+            }
+        }
+        return false;
+    }
+
+    void BinaryLogReader::ReadCategory(uint16_t index)
+    {
+        auto category = _categories.find(index);
+        _category = category != _categories.end() ? std::string_view(category->second) : std::string_view();
+    }
+}
\ No newline at end of file
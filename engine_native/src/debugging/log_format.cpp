@@ -0,0 +1,242 @@
+#include <iterator>
+#include <debugging/log_format.h>
+
+namespace lumi::debugging
+{
+    namespace
+    {
+        constexpr size_t kMaxFormatArgs = 32;
+
+        struct DecodedArg
+        {
+            LogArgTag tag;
+            union
+            {
+                int64_t i;
+                uint64_t u;
+                float f;
+                double d;
+                char c;
+            };
+            std::string_view str;
+        };
+
+        template<typename V>
+        bool ReadScalar(std::string_view args, size_t& offset, V& value)
+        {
+            if (offset + sizeof(V) > args.size())
+                return false;
+            std::memcpy(&value, args.data() + offset, sizeof(V));
+            offset += sizeof(V);
+            return true;
+        }
+
+        size_t DecodeArgs(std::string_view args, DecodedArg* decoded)
+        {
+            size_t count = 0;
+            size_t offset = 0;
+            while (offset < args.size() && count < kMaxFormatArgs)
+            {
+                DecodedArg& arg = decoded[count];
+                arg.tag = static_cast<LogArgTag>(args[offset++]);
+
+                bool ok = false;
+                switch (arg.tag)
+                {
+                    case LogArgTag::Int:
+                        ok = ReadScalar(args, offset, arg.i);
+                        break;
+                    case LogArgTag::UInt:
+                    case LogArgTag::Pointer:
+                        ok = ReadScalar(args, offset, arg.u);
+                        break;
+                    case LogArgTag::Float:
+                        ok = ReadScalar(args, offset, arg.f);
+                        break;
+                    case LogArgTag::Double:
+                        ok = ReadScalar(args, offset, arg.d);
+                        break;
+                    case LogArgTag::Bool:
+                    {
+                        uint8_t b = 0;
+                        ok = ReadScalar(args, offset, b);
+                        arg.u = b;
+                        break;
+                    }
+                    case LogArgTag::Char:
+                        ok = ReadScalar(args, offset, arg.c);
+                        break;
+                    case LogArgTag::String:
+                    {
+                        uint16_t length = 0;
+                        ok = ReadScalar(args, offset, length) && offset + length <= args.size();
+                        if (ok)
+                        {
+                            arg.str = args.substr(offset, length);
+                            offset += length;
+                        }
+                        break;
+                    }
+                }
+
+                if (!ok)
+                    break;
+                ++count;
+            }
+            return count;
+        }
+
+        template<typename V>
+        void FormatOne(std::string& out, std::string_view spec, V value)
+        {
+            std::vformat_to(std::back_inserter(out), spec, std::make_format_args(value));
+        }
+
+        void FormatArg(std::string& out, std::string_view spec, const DecodedArg& arg)
+        {
+            switch (arg.tag)
+            {
+                case LogArgTag::Int:
+                    FormatOne(out, spec, arg.i);
+                    break;
+                case LogArgTag::UInt:
+                    FormatOne(out, spec, arg.u);
+                    break;
+                case LogArgTag::Float:
+                    FormatOne(out, spec, arg.f);
+                    break;
+                case LogArgTag::Double:
+                    FormatOne(out, spec, arg.d);
+                    break;
+                case LogArgTag::Bool:
+                    FormatOne(out, spec, arg.u != 0);
+                    break;
+                case LogArgTag::Char:
+                    FormatOne(out, spec, arg.c);
+                    break;
+                case LogArgTag::String:
+                    FormatOne(out, spec, arg.str);
+                    break;
+                case LogArgTag::Pointer:
+                    FormatOne(out, spec, reinterpret_cast<const void*>(arg.u));
+                    break;
+            }
+        }
+    }
+
+    bool LogFormatRegistry::Register(const LogFormat& format)
+    {
+        for (size_t probe = 0; probe < kCapacity; ++probe)
+        {
+            Entry& entry = _entries[(format.id + probe) & (kCapacity - 1)];
+            uint32_t id = entry.id.load(std::memory_order_acquire);
+            if (id == 0)
+            {
+                if (entry.id.compare_exchange_strong(id, format.id, std::memory_order_acq_rel))
+                {
+                    entry.length.store(static_cast<uint32_t>(format.text.size()), std::memory_order_relaxed);
+                    entry.text.store(format.text.data(), std::memory_order_release);
+                    return true;
+                }
+            }
+
+            if (id == format.id)
+            {
+                // Another thread may have claimed the entry but not published the text yet
+                const char* text = nullptr;
+                while (!(text = entry.text.load(std::memory_order_acquire))) {}
+                if (text == format.text.data())
+                    return true;
+                return std::string_view(text, entry.length.load(std::memory_order_relaxed)) == format.text;
+            }
+        }
+        return false;
+    }
+
+    std::string_view LogFormatRegistry::Find(uint32_t id) const
+    {
+        for (size_t probe = 0; probe < kCapacity; ++probe)
+        {
+            const Entry& entry = _entries[(id + probe) & (kCapacity - 1)];
+            uint32_t entryId = entry.id.load(std::memory_order_acquire);
+            if (entryId == 0)
+                return {};
+
+            const char* text = entry.text.load(std::memory_order_acquire);
+            if (entryId == id && text)
+                return std::string_view(text, entry.length.load(std::memory_order_relaxed));
+        }
+        return {};
+    }
+
+    void FormatLogArgs(std::string_view format, std::string_view args, std::string& out)
+    {
+        DecodedArg decoded[kMaxFormatArgs];
+        size_t count = DecodeArgs(args, decoded);
+
+        std::string spec;
+        size_t nextArg = 0;
+        for (size_t i = 0; i < format.size(); ++i)
+        {
+            char c = format[i];
+            if (c == '}')
+            {
+                out.push_back(c);
+                if (i + 1 < format.size() && format[i + 1] == '}')
+                    ++i;
+                continue;
+            }
+            if (c != '{')
+            {
+                out.push_back(c);
+                continue;
+            }
+            if (i + 1 < format.size() && format[i + 1] == '{')
+            {
+                out.push_back('{');
+                ++i;
+                continue;
+            }
+
+            size_t end = format.find('}', i);
+            if (end == std::string_view::npos)
+            {
+                out.append(format.substr(i));
+                return;
+            }
+
+            // Split "{index:spec}" into its argument index and the spec passed to std::format
+            std::string_view field = format.substr(i + 1, end - i - 1);
+            size_t colon = field.find(':');
+            std::string_view index = field.substr(0, colon);
+            size_t argIndex = nextArg++;
+            if (!index.empty())
+            {
+                argIndex = 0;
+                for (char digit : index)
+                    argIndex = argIndex * 10 + static_cast<size_t>(digit - '0');
+            }
+
+            if (argIndex >= count)
+            {
+                out.append("{?}");
+            }
+            else
+            {
+                spec.assign("{");
+                if (colon != std::string_view::npos)
+                    spec.append(field.substr(colon));
+                spec.push_back('}');
+                try
+                {
+                    FormatArg(out, spec, decoded[argIndex]);
+                }
+                catch (const std::format_error&)
+                {
+                    out.append("{?}");
+                }
+            }
+            i = end;
+        }
+    }
+}
\ No newline at end of file
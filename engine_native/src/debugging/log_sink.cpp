@@ -0,0 +1,21 @@
+#include <iostream>
+#include <debugging/log_sink.h>
+#include <debugging/log_category.h>
+
+namespace lumi::debugging
+{
+    void ConsoleLogSink::Write(const LogMessage& message)
+    {
+        std::cout << "[" << LogTypeName(message.type) << "]";
+        if (message.category)
+        {
+            std::cout << "[" << message.category->GetName() << "]";
+        }
+        std::cout << ": " << message.text << '\n';
+    }
+
+    void ConsoleLogSink::Flush()
+    {
+        std::cout.flush();
+    }
+}
\ No newline at end of file
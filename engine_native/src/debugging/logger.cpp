@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <debugging/logger.h>
+
+namespace lumi::debugging
+{
+    namespace
+    {
+        uint64_t Now()
+        {
+            return static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()
+                ).count()
+            );
+        }
+
+        uint32_t CurrentThreadId()
+        {
+            thread_local uint32_t id = static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+            return id;
+        }
+    }
+
+    Logger::Logger()
+    {
+        _sinks.push_back(std::make_shared<ConsoleLogSink>());
+    }
+
+    Logger::~Logger()
+    {
+        StopAsync();
+    }
+
+    void Logger::StartAsync(const AsyncLogConfig& config)
+    {
+        if (IsAsync())
+        {
+            StopAsync();
+        }
+
+        _config = config;
+        _config.batchSize = std::max<uint32_t>(_config.batchSize, 1);
+        _ring = std::make_unique<LogRingBuffer>(_config.memoryBudget);
+
+        _running.store(true, std::memory_order_release);
+        _worker = std::thread(&Logger::WorkerLoop, this);
+        _async.store(true, std::memory_order_release);
+    }
+
+    void Logger::StopAsync()
+    {
+        if (!IsAsync())
+        {
+            return;
+        }
+
+        _async.store(false, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            _running.store(false, std::memory_order_release);
+        }
+        _wake.notify_one();
+
+        if (_worker.joinable())
+        {
+            _worker.join();
+        }
+        Flush();
+    }
+
+    void Logger::Flush()
+    {
+        FlushRateLimiters();
+
+        std::lock_guard<std::mutex> lock(_sinkMutex);
+        if (_ring)
+        {
+            while (DrainBatch() > 0) {}
+        }
+        FlushSinks();
+    }
+
+    void Logger::AddSink(std::shared_ptr<ILogSink> sink)
+    {
+        if (!sink)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(_sinkMutex);
+        _sinks.push_back(std::move(sink));
+    }
+
+    void Logger::RemoveSink(const std::shared_ptr<ILogSink>& sink)
+    {
+        std::lock_guard<std::mutex> lock(_sinkMutex);
+        auto it = std::find(_sinks.begin(), _sinks.end(), sink);
+        if (it == _sinks.end())
+        {
+            return;
+        }
+        (*it)->Flush();
+        _sinks.erase(it);
+    }
+
+    void Logger::ClearSinks()
+    {
+        std::lock_guard<std::mutex> lock(_sinkMutex);
+        FlushSinks();
+        _sinks.clear();
+    }
+
+    void Logger::RegisterRateLimiter(LogRateLimiter& limiter)
+    {
+        std::lock_guard<std::mutex> lock(_rateLimiterMutex);
+        _rateLimiters.push_back(&limiter);
+        limiter.registered = true;
+    }
+
+    void Logger::UnregisterRateLimiter(LogRateLimiter& limiter)
+    {
+        std::lock_guard<std::mutex> lock(_rateLimiterMutex);
+        std::erase(_rateLimiters, &limiter);
+    }
+
+    void Logger::WriteSuppressed(const LogSuppressed& suppressed)
+    {
+        if (suppressed.count == 0)
+        {
+            return;
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(suppressed.elapsed);
+        Log(*suppressed.category, suppressed.type, "Suppressed {} repeats of \"{}\" in the last {}ms",
+            suppressed.count, suppressed.text, elapsed.count());
+    }
+
+    void Logger::FlushRateLimiters()
+    {
+        std::vector<LogSuppressed> pending;
+        {
+            std::lock_guard<std::mutex> lock(_rateLimiterMutex);
+            for (LogRateLimiter* limiter : _rateLimiters)
+            {
+                limiter->TakeSuppressed(pending);
+            }
+        }
+
+        // Written without the lock, a sink may log rate limited messages itself
+        for (const auto& suppressed : pending)
+        {
+            WriteSuppressed(suppressed);
+        }
+    }
+
+    LogRateLimiter::~LogRateLimiter()
+    {
+        if (!registered)
+        {
+            return;
+        }
+
+        Logger& logger = Logger::Instance();
+        logger.UnregisterRateLimiter(*this);
+
+        std::vector<LogSuppressed> pending;
+        TakeSuppressed(pending);
+        for (const auto& suppressed : pending)
+        {
+            logger.WriteSuppressed(suppressed);
+        }
+    }
+
+    void Logger::Write(const LogCategory& category, const LogType& logType, const std::string& msg)
+    {
+        if (IsAsync())
+        {
+            Enqueue([&](LogRecord& record)
+            {
+                StampRecord(record, category, logType);
+                record.kind = LogRecordKind::Text;
+
+                size_t length = std::min(msg.size(), sizeof(record.message));
+                std::memcpy(record.message, msg.data(), length);
+                record.length = static_cast<uint16_t>(length);
+            });
+            return;
+        }
+
+        LogMessage message;
+        message.timestamp = Now();
+        message.category = &category;
+        message.threadId = CurrentThreadId();
+        message.type = logType;
+        message.text = msg;
+
+        std::lock_guard<std::mutex> lock(_sinkMutex);
+        WriteToSinks(message);
+        FlushSinks();
+    }
+
+    void Logger::StampRecord(LogRecord& record, const LogCategory& category, const LogType& logType)
+    {
+        record.timestamp = Now();
+        record.category = &category;
+        record.threadId = CurrentThreadId();
+        record.type = logType;
+    }
+
+    void Logger::WriteRecord(const LogRecord& record)
+    {
+        std::lock_guard<std::mutex> lock(_sinkMutex);
+        DispatchRecord(record);
+        FlushSinks();
+    }
+
+    void Logger::DispatchRecord(const LogRecord& record)
+    {
+        LogMessage message;
+        message.timestamp = record.timestamp;
+        message.category = record.category;
+        message.threadId = record.threadId;
+        message.type = record.type;
+
+        if (record.kind == LogRecordKind::Text)
+        {
+            message.text = std::string_view(record.message, record.length);
+            WriteToSinks(message);
+            return;
+        }
+
+        message.deferred = true;
+        message.formatId = record.formatId;
+        message.format = LogFormatRegistry::Instance().Find(record.formatId);
+        message.args = std::string_view(record.message, record.length);
+
+        bool needsText = std::any_of(_sinks.begin(), _sinks.end(), [&](const auto& sink)
+        {
+            return sink->Accepts(message.type) && sink->NeedsText();
+        });
+        if (needsText)
+        {
+            _scratch.clear();
+            FormatLogArgs(message.format, message.args, _scratch);
+            message.text = _scratch;
+        }
+        WriteToSinks(message);
+    }
+
+    void Logger::WriteToSinks(const LogMessage& message)
+    {
+        for (const auto& sink : _sinks)
+        {
+            if (sink->Accepts(message.type))
+            {
+                sink->Write(message);
+            }
+        }
+    }
+
+    void Logger::FlushSinks()
+    {
+        for (const auto& sink : _sinks)
+        {
+            sink->Flush();
+        }
+    }
+
+    size_t Logger::DrainBatch()
+    {
+        LogRecord record;
+        size_t written = 0;
+        while (written < _config.batchSize && _ring->TryPop(record))
+        {
+            DispatchRecord(record);
+            ++written;
+        }
+        return written;
+    }
+
+    void Logger::WorkerLoop()
+    {
+        while (_running.load(std::memory_order_acquire))
+        {
+            size_t written = 0;
+            {
+                std::lock_guard<std::mutex> lock(_sinkMutex);
+                written = DrainBatch();
+                if (written > 0)
+                {
+                    FlushSinks();
+                }
+            }
+
+            // Keep draining while there's a backlog, otherwise sleep until woken or the idle interval passes
+            if (written < _config.batchSize)
+            {
+                std::unique_lock<std::mutex> lock(_wakeMutex);
+                _wake.wait_for(lock, _config.idleInterval, [this]
+                {
+                    return !_running.load(std::memory_order_acquire);
+                });
+            }
+        }
+    }
+}
\ No newline at end of file
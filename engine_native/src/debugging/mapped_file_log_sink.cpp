@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <debugging/mapped_file_log_sink.h>
+#include <debugging/log_category.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace lumi::debugging
+{
+    namespace
+    {
+        constexpr size_t kMinFileSize = 4096;
+
+        std::string RotatedPath(const std::string& path, uint32_t index)
+        {
+            return path + "." + std::to_string(index);
+        }
+    }
+
+    MappedFileLogSink::MappedFileLogSink(const MappedFileLogConfig& config)
+        : _config(config)
+    {
+        _config.fileSize = std::max(_config.fileSize, kMinFileSize);
+        _config.maxFiles = std::max<uint32_t>(_config.maxFiles, 1);
+        Open();
+    }
+
+    MappedFileLogSink::~MappedFileLogSink()
+    {
+        Close();
+    }
+
+    void MappedFileLogSink::Write(const LogMessage& message)
+    {
+        if (!_view)
+        {
+            return;
+        }
+
+        auto time = std::chrono::floor<std::chrono::microseconds>(
+            std::chrono::sys_time<std::chrono::nanoseconds>(std::chrono::nanoseconds(message.timestamp))
+        );
+        std::string_view category = message.category ? message.category->GetName() : std::string_view("core");
+
+        for (int attempt = 0; attempt < 2; ++attempt)
+        {
+            size_t available = _capacity - _offset;
+            char* dest = _view + _offset;
+            if (available > 1)
+            {
+                // Everything but the opening bracket is written first, it's stored last to mark the line as complete
+                auto result = std::format_to_n(dest + 1, available - 1, "{:%F %T}] [{}][{}]: {}\n",
+                    time, LogTypeName(message.type), category, message.text);
+                size_t written = std::min(static_cast<size_t>(result.size), available - 1);
+                size_t length = static_cast<size_t>(result.size) + 1;
+
+                // A line that can't fit in an empty file is cut off instead of rotating forever
+                bool fits = length <= available;
+                if (!fits && _offset == 0)
+                {
+                    length = available;
+                    dest[length - 1] = '\n';
+                    fits = true;
+                }
+
+                if (fits)
+                {
+                    // Recovery treats the first NUL as the end of the log
+                    std::replace(dest + 1, dest + length, '\0', ' ');
+                    std::atomic_signal_fence(std::memory_order_release);
+                    dest[0] = '[';
+                    _offset += length;
+                    return;
+                }
+
+                std::memset(dest + 1, 0, written);
+            }
+
+            if (!Rotate())
+            {
+                return;
+            }
+        }
+    }
+
+    bool MappedFileLogSink::Open()
+    {
+        #ifdef _WIN32
+        HANDLE file = CreateFileA(_config.path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+            OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER size = {};
+        GetFileSizeEx(file, &size);
+        size_t usedSize = static_cast<size_t>(size.QuadPart);
+        _capacity = std::max(_config.fileSize, usedSize);
+
+        // Mapping past the end of the file grows it with zeros
+        auto capacity = static_cast<uint64_t>(_capacity);
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(capacity >> 32), static_cast<DWORD>(capacity), nullptr);
+        if (!mapping)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, _capacity);
+        if (!view)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        _file = file;
+        _mapping = mapping;
+        _view = static_cast<char*>(view);
+        #else
+        int file = ::open(_config.path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (file < 0)
+        {
+            return false;
+        }
+
+        struct stat info = {};
+        fstat(file, &info);
+        size_t usedSize = static_cast<size_t>(info.st_size);
+        _capacity = std::max(_config.fileSize, usedSize);
+
+        if (ftruncate(file, static_cast<off_t>(_capacity)) != 0)
+        {
+            ::close(file);
+            return false;
+        }
+
+        void* view = mmap(nullptr, _capacity, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        if (view == MAP_FAILED)
+        {
+            ::close(file);
+            return false;
+        }
+
+        _file = file;
+        _view = static_cast<char*>(view);
+        #endif
+
+        Recover(usedSize);
+        return true;
+    }
+
+    void MappedFileLogSink::Close()
+    {
+        if (!_view)
+        {
+            return;
+        }
+
+        #ifdef _WIN32
+        UnmapViewOfFile(_view);
+        CloseHandle(_mapping);
+        _mapping = nullptr;
+
+        LARGE_INTEGER end = {};
+        end.QuadPart = static_cast<LONGLONG>(_offset);
+        SetFilePointerEx(_file, end, nullptr, FILE_BEGIN);
+        SetEndOfFile(_file);
+        CloseHandle(_file);
+        _file = nullptr;
+        #else
+        munmap(_view, _capacity);
+        if (ftruncate(_file, static_cast<off_t>(_offset)) != 0)
+        {
+            // The file keeps its zeroed tail, which is recovered the next time it's opened
+        }
+        ::close(_file);
+        _file = -1;
+        #endif
+
+        _view = nullptr;
+        _capacity = 0;
+        _offset = 0;
+    }
+
+    bool MappedFileLogSink::Rotate()
+    {
+        Close();
+
+        std::error_code ec;
+        if (_config.maxFiles > 1)
+        {
+            std::filesystem::remove(RotatedPath(_config.path, _config.maxFiles - 1), ec);
+            for (uint32_t i = _config.maxFiles - 1; i > 1; --i)
+            {
+                std::filesystem::rename(RotatedPath(_config.path, i - 1), RotatedPath(_config.path, i), ec);
+            }
+            std::filesystem::rename(_config.path, RotatedPath(_config.path, 1), ec);
+        }
+        else
+        {
+            std::filesystem::remove(_config.path, ec);
+        }
+
+        return Open();
+    }
+
+    void MappedFileLogSink::Recover(size_t usedSize)
+    {
+        // A line's first byte is written last, so the first NUL ends the complete lines
+        usedSize = std::min(usedSize, _capacity);
+        auto end = static_cast<const char*>(std::memchr(_view, '\0', usedSize));
+        _offset = end ? static_cast<size_t>(end - _view) : usedSize;
+
+        // Clear whatever a crash left of an unfinished line
+        std::memset(_view + _offset, 0, usedSize - _offset);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <debugging/profiler.h>
+
+namespace lumi::debugging
+{
+    namespace
+    {
+        thread_local ProfilerThreadBuffer* t_buffer = nullptr;
+
+        void AppendJsonString(std::string& out, std::string_view text)
+        {
+            out.push_back('"');
+            for (char c : text)
+            {
+                switch (c)
+                {
+                    case '"': out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    case '\n': out += "\\n"; break;
+                    case '\t': out += "\\t"; break;
+                    default:
+                    {
+                        if (static_cast<unsigned char>(c) < 0x20)
+                        {
+                            std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned int>(c));
+                        }
+                        else
+                        {
+                            out.push_back(c);
+                        }
+                        break;
+                    }
+                }
+            }
+            out.push_back('"');
+        }
+
+        /* Trace timestamps are microseconds from the start of the capture */
+        double ToTraceTime(uint64_t time, uint64_t origin)
+        {
+            return static_cast<double>(time - origin) / 1000.0;
+        }
+    }
+
+    void Profiler::StartCapture(const uint32_t frameCount)
+    {
+        std::lock_guard lock(_mutex);
+        s_capturing.store(false, std::memory_order_relaxed);
+        _pendingFrames = std::max<uint32_t>(frameCount, 1);
+        _remainingFrames = 0;
+    }
+
+    void Profiler::StopCapture()
+    {
+        std::lock_guard lock(_mutex);
+        s_capturing.store(false, std::memory_order_relaxed);
+        _remainingFrames = 0;
+    }
+
+    void Profiler::MarkFrame()
+    {
+        uint64_t now = ProfilerNow();
+
+        std::lock_guard lock(_mutex);
+        if (IsCapturing())
+        {
+            _frames.push_back(now);
+            if (--_remainingFrames == 0)
+            {
+                s_capturing.store(false, std::memory_order_relaxed);
+            }
+        }
+
+        if (!IsCapturing() && _pendingFrames > 0)
+        {
+            _remainingFrames = _pendingFrames;
+            _pendingFrames = 0;
+            BeginCapture(now);
+        }
+    }
+
+    void Profiler::SetThreadName(std::string_view name)
+    {
+        ProfilerThreadBuffer& buffer = GetThreadBuffer();
+
+        std::lock_guard lock(_mutex);
+        buffer.threadName = name;
+    }
+
+    void Profiler::Record(std::string_view name, const uint64_t start, const uint64_t end, const uint32_t index,
+        const uint64_t allocations, const uint64_t allocBytes)
+    {
+        ProfilerThreadBuffer& buffer = GetThreadBuffer();
+
+        uint64_t head = buffer.head.load(std::memory_order_relaxed);
+        ProfileEvent& event = buffer.events[head % kProfileEventsPerThread];
+        event.start = start;
+        event.end = end;
+        event.index = index;
+        event.allocations = static_cast<uint32_t>(std::min<uint64_t>(allocations, UINT32_MAX));
+        event.allocBytes = static_cast<uint32_t>(std::min<uint64_t>(allocBytes, UINT32_MAX));
+
+        size_t length = std::min(name.size(), sizeof(event.name) - 1);
+        std::memcpy(event.name, name.data(), length);
+        event.name[length] = '\0';
+
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+
+    bool Profiler::ExportChromeTrace(const std::string& path)
+    {
+        std::lock_guard lock(_mutex);
+        if (_frames.empty())
+        {
+            return false;
+        }
+
+        uint64_t origin = _frames.front();
+        bool allocsTracked = AllocTracker::IsHooked();
+        std::string out;
+        out.reserve(1024 * 1024);
+        out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        out += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"lumi\"}},\n";
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Frames\"}}";
+
+        // Frames are shown as zones on their own track
+        for (size_t i = 1; i < _frames.size(); ++i)
+        {
+            std::format_to(std::back_inserter(out),
+                ",\n{{\"name\":\"Frame {}\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                i - 1, ToTraceTime(_frames[i - 1], origin), ToTraceTime(_frames[i], _frames[i - 1]));
+        }
+
+        for (const auto& thread : _threads)
+        {
+            uint32_t tid = thread->threadIndex + 1;
+            out += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,";
+            std::format_to(std::back_inserter(out), "\"tid\":{},\"args\":{{\"name\":", tid);
+            AppendJsonString(out, thread->threadName);
+            out += "}}";
+
+            // Only the newest kProfileEventsPerThread events of the capture are still in the ring
+            uint64_t head = thread->head.load(std::memory_order_acquire);
+            uint64_t first = std::max(thread->captureStart,
+                head > kProfileEventsPerThread ? head - kProfileEventsPerThread : 0);
+            for (uint64_t i = first; i < head; ++i)
+            {
+                const ProfileEvent& event = thread->events[i % kProfileEventsPerThread];
+                if (event.start < origin)
+                {
+                    continue;
+                }
+
+                out += ",\n{\"name\":";
+                AppendJsonString(out, event.name);
+                std::format_to(std::back_inserter(out), ",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}",
+                    tid, ToTraceTime(event.start, origin), ToTraceTime(event.end, event.start));
+
+                // Only zones with something to show get arguments
+                std::string args;
+                if (event.index != kProfileNoIndex)
+                {
+                    std::format_to(std::back_inserter(args), "\"index\":{}", event.index);
+                }
+                if (allocsTracked)
+                {
+                    std::format_to(std::back_inserter(args), "{}\"allocs\":{},\"alloc_bytes\":{}",
+                        args.empty() ? "" : ",", event.allocations, event.allocBytes);
+                }
+                if (!args.empty())
+                {
+                    std::format_to(std::back_inserter(out), ",\"args\":{{{}}}", args);
+                }
+                out += "}";
+            }
+        }
+        out += "\n]}\n";
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            return false;
+        }
+        file.write(out.data(), static_cast<std::streamsize>(out.size()));
+        return static_cast<bool>(file);
+    }
+
+    size_t Profiler::GetCapturedFrameCount()
+    {
+        std::lock_guard lock(_mutex);
+        return _frames.empty() ? 0 : _frames.size() - 1;
+    }
+
+    uint64_t Profiler::GetOverwrittenCount()
+    {
+        std::lock_guard lock(_mutex);
+        uint64_t overwritten = 0;
+        for (const auto& thread : _threads)
+        {
+            uint64_t recorded = thread->head.load(std::memory_order_acquire) - thread->captureStart;
+            if (recorded > kProfileEventsPerThread)
+            {
+                overwritten += recorded - kProfileEventsPerThread;
+            }
+        }
+        return overwritten;
+    }
+
+    ProfilerThreadBuffer& Profiler::GetThreadBuffer()
+    {
+        if (!t_buffer)
+        {
+            // Buffers are kept after their thread exits so its events can still be exported
+            std::lock_guard lock(_mutex);
+            auto buffer = std::make_unique<ProfilerThreadBuffer>();
+            buffer->threadIndex = static_cast<uint32_t>(_threads.size());
+            buffer->threadName = std::format("Thread {}", buffer->threadIndex);
+            t_buffer = buffer.get();
+            _threads.push_back(std::move(buffer));
+        }
+        return *t_buffer;
+    }
+
+    void Profiler::BeginCapture(const uint64_t now)
+    {
+        for (const auto& thread : _threads)
+        {
+            thread->captureStart = thread->head.load(std::memory_order_acquire);
+        }
+        _frames.clear();
+        _frames.push_back(now);
+        s_capturing.store(true, std::memory_order_relaxed);
+    }
+}
\ No newline at end of file
@@ -48,7 +48,7 @@ namespace lumi::gfx::d3d12
             if (FAILED(D3D12CreateDevice(adapter.Get(), D3D_FEATURE_LEVEL_11_0, _uuidof(ID3D12Device), nullptr)))
                 continue; // Skip if it doesn't support D3D12
 
-            debugging::Logger::Instance().LogInfo(
+            LUMI_LOG_INFO(debugging::LogGfxD3D12,
                 "Found adapter after {} enumeration{}",
                 adapterIndex+1, adapterIndex > 0 ? "s" : ""
             );
@@ -56,7 +56,7 @@ namespace lumi::gfx::d3d12
             std::wstring ws(desc.Description);
             std::string adapterName(ws.begin(), ws.end());
 
-            debugging::Logger::Instance().LogInfo(
+            LUMI_LOG_INFO(debugging::LogGfxD3D12,
                 "Adapter name: {} \n \tAdapter dedicated video mem: {} \n \tAdapter dedicated system mem: {}",
                 adapterName, 
                 desc.DedicatedVideoMemory / (1024 * 1024), 
@@ -67,7 +67,7 @@ namespace lumi::gfx::d3d12
             return true;
         }
 
-        debugging::Logger::Instance().LogError("Failed to find a suitable adapter for D3D12");
+        LUMI_LOG_ERROR(debugging::LogGfxD3D12, "Failed to find a suitable adapter for D3D12");
         return false;
     }
 
@@ -99,7 +99,7 @@ namespace lumi::gfx::d3d12
         {
             if (IsDeviceLost())
             {
-                debugging::Logger::Instance().LogError(
+                LUMI_LOG_ERROR(debugging::LogGfxD3D12,
                     "D3D12 DEVICE WAS LOST, REASON: 0x{:08X}", GetDeviceRemovedReason()
                 );
             }
@@ -1,10 +1,11 @@
 #include <d3d12_render_target.h>
 #include <debugging/logger.h>
+#include <debugging/profiler.h>
 
 namespace lumi::gfx::d3d12
 {
     D3D12RenderTarget::D3D12RenderTarget(D3D12Device& device, sys::WinPtr& window)
-        : _device(device), _window(window)
+        : IRenderTarget(Backend::D3D12), _device(device), _window(window)
     {
 
     }
@@ -17,12 +18,23 @@ namespace lumi::gfx::d3d12
     bool D3D12RenderTarget::Init(const uint32_t maxInFlight)
     {
         _maxFramesInFlight = maxInFlight;
+        _frameArenas.SetFrameCount(_maxFramesInFlight);
+
+        auto now = ResizePolicy::Clock::now();
+        _resizePolicy.Request(_window->GetWidth(), _window->GetHeight(), now);
+        _resizePolicy.Reset(_window->GetWidth(), _window->GetHeight(), now);
 
         if (!CreateSync()) return false;
         if (!CreateSwapChain()) return false;
         if (!CreateImages()) return false;
         if (!CreateCommandAllocator()) return false;
         if (!CreateCommandList()) return false;
+        if (!_timings.Create(_maxFramesInFlight)) return false;
+
+        // Everything was just created from the window's current state
+        _appliedGeneration = _window->GetGeneration();
+        _windowGeneration.store(_appliedGeneration, std::memory_order_relaxed);
+        _windowSubscription = _window->Subscribe([this](const sys::WindowChangeEvent& event) { OnWindowChanged(event); });
 
         return true;
     }
@@ -30,12 +42,11 @@ namespace lumi::gfx::d3d12
     void D3D12RenderTarget::Resize(const int width, const int height)
     {
         // Wait for the GPU to finish frames before resizing the buffers
-        for (uint32_t i = 0; i < _maxFramesInFlight; ++i)
-            _sync->WaitForFrame(i);
+        _sync->WaitIdle();
         
-        // Destroy objects that are dependent on the size
-        DestroyCommandList();
-        DestroyCommandAllocator();
+        LUMI_LOG_INFO(debugging::LogGfxD3D12, "Resizing the buffers of window {} to {}x{}", _window->GetID(), width, height);
+
+        // Only the images depend on the size, command allocators and lists are kept
         DestroyImages();
 
         DXGI_SWAP_CHAIN_DESC desc;
@@ -53,21 +64,46 @@ namespace lumi::gfx::d3d12
             return;
         }
 
+        auto now = ResizePolicy::Clock::now();
+        _resizePolicy.Request(width, height, now);
+        _resizePolicy.Reset(width, height, now);
         CreateImages();
-        CreateCommandAllocator();
-        CreateCommandList();
     }
 
     void D3D12RenderTarget::StartRendering(const uint32_t index)
     {
+        LUMI_PROFILE_ZONE_INDEX("D3D12RenderTarget::StartRendering", index);
         if (OutOfDate())
         {
-            Resize(static_cast<int>(_window->GetWidth()), static_cast<int>(_window->GetHeight()));
+            _appliedGeneration = _windowGeneration.load(std::memory_order_acquire);
+            auto changes = static_cast<sys::WindowChange>(_windowChanges.exchange(0, std::memory_order_relaxed));
+
+            // Moving to another display keeps the buffers valid, only size and format changes need new ones
+            if ((changes & sys::WindowChange::Size) != sys::WindowChange::None)
+            {
+                _resizePolicy.Request(_window->GetWidth(), _window->GetHeight(), ResizePolicy::Clock::now());
+            }
+            if ((changes & sys::WindowChange::Format) != sys::WindowChange::None)
+            {
+                _resizePolicy.Force();
+            }
         }
 
+        // Rebuilds are coalesced and rate-limited while the window is dragged, frames render into the top-left corner meanwhile
+        ApplyResizePolicy(ResizePolicy::Clock::now());
+
         auto& colorBuffer = _colorBuffers[index];
         auto& depthBuffer = _depthBuffers[index];
 
+        // Only the frame that last used this index has to be done, the others keep running on the GPU
+        auto waitStart = std::chrono::steady_clock::now();
+        _sync->Wait(_frameValues[index]);
+        _frameWaitTime = std::chrono::steady_clock::now() - waitStart;
+
+        // Nothing on the GPU reads the frame's memory anymore
+        _frameArenas.BeginFrame(index);
+        _timings.BeginFrame(index);
+
         // Reset command objects to discard previous executions
         _commandAllocators[index]->Reset();
         _commandLists[index]->Reset(_commandAllocators[index].Get(), nullptr);
@@ -85,50 +121,60 @@ namespace lumi::gfx::d3d12
 
     void D3D12RenderTarget::EndRendering(const uint32_t index)
     {
+        LUMI_PROFILE_ZONE_INDEX("D3D12RenderTarget::EndRendering", index);
         auto& colorBuffer = _colorBuffers[index];
 
         // Move ONLY color to present, depth is not presented to the screen
         colorBuffer->SetCommandList(_commandLists[index]);
         colorBuffer->Transition(ImageState::Present);
 
+        _timings.Resolve(_commandLists[index].Get(), index);
         _commandLists[index]->Close();
     }
 
     void D3D12RenderTarget::SubmitRendering(const uint32_t index)
     {
+        LUMI_PROFILE_ZONE_INDEX("D3D12RenderTarget::SubmitRendering", index);
         // Execute command list
         ID3D12CommandList* lists[] = { _commandLists[index].Get() };
         _device.GetCommandQueue()->ExecuteCommandLists(1, lists);
 
         // Present
+        auto presentStart = std::chrono::steady_clock::now();
         _swapChain->Present(1, 0);
 
-        // Signal and wait using sync object
-        _sync->Signal(_device.GetCommandQueue().Get(), index);
-        _sync->WaitForFrame(index);
-        _sync->AdvanceFrame();
+        // Signal without waiting, the next frame with this index waits for it in StartRendering
+        _frameValues[index] = _sync->Signal();
+        _presentWaitTime = std::chrono::steady_clock::now() - presentStart + _frameWaitTime;
     }
 
     bool D3D12RenderTarget::OutOfDate() const
     {
-        DXGI_SWAP_CHAIN_DESC desc;
-        _swapChain->GetDesc(&desc);
-        
-        bool sizeOutOfDate = static_cast<uint32_t>(desc.BufferDesc.Width) != _window->GetWidth() 
-                             || static_cast<uint32_t>(desc.BufferDesc.Height) != _window->GetHeight();
-        if (sizeOutOfDate)
-        {
-            debugging::Logger::Instance().LogInfo("Window {} size out of date", _window->GetID());
-            return true;
-        }
-
-        // TODO: Check all images and ensure the format is the same as the render target
+        // The window publishes its changes, so there's no need to ask the swap chain every frame
+        return _windowGeneration.load(std::memory_order_relaxed) != _appliedGeneration;
+    }
 
-        return false;
+    void D3D12RenderTarget::OnWindowChanged(const sys::WindowChangeEvent& event)
+    {
+        _windowChanges.fetch_or(static_cast<uint32_t>(event.changes), std::memory_order_relaxed);
+        _windowGeneration.store(event.generation, std::memory_order_release);
     }
 
     void D3D12RenderTarget::Cleanup()
     {
+        // Frames can still be in flight, nothing they use may be released before they finish
+        if (_sync)
+        {
+            _sync->WaitIdle();
+        }
+
+        if (_windowSubscription != sys::kInvalidWindowSubscription && _window)
+        {
+            _window->Unsubscribe(_windowSubscription);
+            _windowSubscription = sys::kInvalidWindowSubscription;
+        }
+
+        _timings.Destroy();
         DestroyCommandList();
         DestroyCommandAllocator();
         DestroyImages();
@@ -139,25 +185,28 @@ namespace lumi::gfx::d3d12
     bool D3D12RenderTarget::CreateSync()
     {
         _sync = std::make_shared<D3D12Sync>();
-        return _sync->Init(_device, _maxFramesInFlight);
+        _frameValues.assign(_maxFramesInFlight, 0);
+        return _sync->Init(_device);
     }
 
     bool D3D12RenderTarget::CreateSwapChain()
     {
         DXGI_SWAP_CHAIN_DESC1 desc = {};
         desc.BufferCount = _maxFramesInFlight;
-        desc.Width = static_cast<UINT>(_window->GetWidth());
-        desc.Height = static_cast<UINT>(_window->GetHeight());
+        desc.Width = static_cast<UINT>(_resizePolicy.GetBufferWidth());
+        desc.Height = static_cast<UINT>(_resizePolicy.GetBufferHeight());
         desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
         desc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
         desc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
         desc.SampleDesc.Count = 1;
+        // Buffers larger than the window are presented from the top-left corner instead of being stretched
+        desc.Scaling = DXGI_SCALING_NONE;
 
         HWND hwnd = static_cast<HWND>(SDL_GetPointerProperty(SDL_GetWindowProperties(_window->GetHandle()), SDL_PROP_WINDOW_WIN32_HWND_POINTER, NULL));
 
         if (!hwnd)
         {
-            debugging::Logger::Instance().LogError("Failed to find a HWND from window {}", _window->GetID());
+            LUMI_LOG_ERROR(debugging::LogGfxD3D12, "Failed to find a HWND from window {}", _window->GetID());
             return false;
         }
 
@@ -190,15 +239,15 @@ namespace lumi::gfx::d3d12
             // Create depth buffer
             resources::ImageDesc depthDesc = {};
             depthDesc.format = resources::ImageFormat::Depth24Stencil8;
-            depthDesc.width = _window->GetWidth();
-            depthDesc.height = _window->GetHeight();
+            depthDesc.width = _resizePolicy.GetBufferWidth();
+            depthDesc.height = _resizePolicy.GetBufferHeight();
             depthDesc.usage = resources::ImageUsage::DepthStencil;
             
             _depthBuffers[i] = std::make_unique<D3D12ImageBuffer>(_device);
             _depthBuffers[i]->SetDesc(depthDesc);
             if (!_depthBuffers[i]->Create())
             {
-                debugging::Logger::Instance().LogError("Failed to create depth image for index {}", i);
+                LUMI_LOG_ERROR(debugging::LogGfxD3D12, "Failed to create depth image for index {}", i);
                 return false;
             }
         }
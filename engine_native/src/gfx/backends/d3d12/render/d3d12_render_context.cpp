@@ -1,183 +1,263 @@
+#include <gfx/render/command_buffer.h>
 #include <render/d3d12_render_context.h>
 #include <d3d12_render_target.h>
 
 #include <debugging/logger.h>
+#include <debugging/profiler.h>
 
 namespace lumi::gfx::d3d12::render
 {
     void D3D12RenderContext::SetRenderTarget(IRenderTarget& window)
     {
-        auto* renderTarget = dynamic_cast<D3D12RenderTarget*>(&window);
+        auto* renderTarget = BackendCast<D3D12RenderTarget>(&window);
         if (!renderTarget)
         {
             return;
         }
 
+        _renderTarget = renderTarget;
         _commandAllocator = renderTarget->GetCommandAllocator(_frameNum);
         _commandList = renderTarget->GetCommandList(_frameNum);
     }
 
     void D3D12RenderContext::BeginRecording(const RenderInfo& info)
     {
-        std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> rtvHandles;
+        core::FixedVector<IImageBuffer*, kMaxColorAttachments> color;
         for (const auto& colorInfo : info.color)
         {
-            auto* d3d12Image = dynamic_cast<D3D12ImageBuffer*>(colorInfo.image);
-            if (d3d12Image)
+            color.Push(colorInfo.image);
+        }
+        BindAttachments(color.AsSpan());
+        SetViewport(info.view.view);
+        SetScissor(info.view.scissor);
+
+        for (const auto& colorInfo : info.color)
+        {
+            if (colorInfo.loadOp == RenderLoadOp::Clear)
             {
-                rtvHandles.push_back(d3d12Image->GetRTVHandle());
+                ClearColor(colorInfo.image, colorInfo.color);
             }
         }
 
-        D3D12_CPU_DESCRIPTOR_HANDLE* dsvHandle = nullptr;
-        if (info.depth)
+        if (info.depth && info.depth->loadOp == RenderLoadOp::Clear)
         {
-            auto* d3d12Image = dynamic_cast<D3D12ImageBuffer*>(info.depth->image);
-            if (d3d12Image)
+            const auto& depthArray = info.depth->depthStencil;
+            ClearDepthStencil(info.depth->image, depthArray[0], static_cast<UINT8>(depthArray[1]));
+        }
+    }
+
+    void D3D12RenderContext::EndRecording(const RenderInfo& info)
+    {
+        for (const auto& colorInfo : info.color)
+        {
+            if (colorInfo.storeOp == RenderStoreOp::DontCare)
             {
-                dsvHandle = &(d3d12Image->GetDSVHandle());
+                Discard(colorInfo.image);
             }
         }
 
-        D3D12_VIEWPORT d3d12Viewport;
-        D3D12_RECT d3d12Rect;
-        
-        Viewport infoViewport = info.view.view;
-        Scissor infoScissor = info.view.scissor;
-
-        d3d12Viewport.Height = infoViewport.height;
-        d3d12Viewport.Width = infoViewport.width;
-        d3d12Viewport.MaxDepth = infoViewport.maxDepth;
-        d3d12Viewport.MinDepth = infoViewport.minDepth;
-        d3d12Viewport.TopLeftX = infoViewport.x;
-        d3d12Viewport.TopLeftY = infoViewport.y;
-
-        d3d12Rect.left = infoScissor.x;
-        d3d12Rect.top = infoScissor.y;
-        d3d12Rect.right = infoScissor.x + infoScissor.width;
-        d3d12Rect.bottom = infoScissor.y + infoScissor.height;
-        
-        _commandList->RSSetViewports(1, &d3d12Viewport);
-        _commandList->RSSetScissorRects(1, &d3d12Rect);
+        if (info.depth && info.depth->storeOp == RenderStoreOp::DontCare)
+        {
+            Discard(info.depth->image);
+        }
+    }
 
-        if (!rtvHandles.empty())
-            _commandList->OMSetRenderTargets(static_cast<UINT>(rtvHandles.size()), rtvHandles.data(), FALSE, nullptr);
+    void D3D12RenderContext::Transition(IImageBuffer& image, const ImageState& state)
+    {
+        auto* d3d12Image = BackendCast<D3D12ImageBuffer>(&image);
+        if (!d3d12Image)
+        {
+            LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxD3D12, std::chrono::seconds(1),
+                "D3D12 cannot transition an image that isn't a D3D12 image!"
+            );
+            return;
+        }
 
-        for (size_t i = 0; i < info.color.size(); ++i)
+        d3d12Image->SetCommandList(_commandList);
+        d3d12Image->Transition(state);
+    }
+
+    void D3D12RenderContext::Alias(IImageBuffer& image, const ImageState& state)
+    {
+        auto* d3d12Image = BackendCast<D3D12ImageBuffer>(&image);
+        if (!d3d12Image)
         {
-            const auto& colorInfo = info.color[i];
-            auto colorImage = rtvHandles[i];
-            const auto& colorArray = colorInfo.color;
-            switch (colorInfo.loadOp)
+            LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxD3D12, std::chrono::seconds(1),
+                "D3D12 cannot alias an image that isn't a D3D12 image!"
+            );
+            return;
+        }
+
+        d3d12Image->SetCommandList(_commandList);
+        d3d12Image->Alias(state);
+    }
+
+    void D3D12RenderContext::Execute(const CommandBuffer& commands)
+    {
+        LUMI_PROFILE_ZONE("D3D12RenderContext::Execute");
+        using namespace gfx::render;
+        for (const CommandHeader& command : commands)
+        {
+            switch (command.type)
             {
-                case RenderLoadOp::Clear:
+                case CommandType::SetRenderTarget:
+                    SetRenderTarget(*command.As<SetRenderTargetCommand>().target);
+                    break;
+                case CommandType::BeginPass:
+                    BindAttachments(command.As<BeginPassCommand>().GetColor());
+                    break;
+                case CommandType::EndPass:
+                    break;
+                case CommandType::SetViewport:
+                    SetViewport(command.As<SetViewportCommand>().viewport);
+                    break;
+                case CommandType::SetScissor:
+                    SetScissor(command.As<SetScissorCommand>().scissor);
+                    break;
+                case CommandType::ClearColor:
+                {
+                    const auto& clear = command.As<ClearColorCommand>();
+                    ClearColor(clear.image, clear.color);
+                    break;
+                }
+                case CommandType::ClearDepthStencil:
                 {
-                    FLOAT clearColor[4] = { colorArray[0], colorArray[1], colorArray[2], colorArray[3] };
-                    _commandList->ClearRenderTargetView(colorImage, clearColor, 0, nullptr);
+                    const auto& clear = command.As<ClearDepthStencilCommand>();
+                    ClearDepthStencil(clear.image, clear.depth, clear.stencil);
+                    break;
                 }
-                case RenderLoadOp::Load:
+                case CommandType::Discard:
+                    Discard(command.As<DiscardCommand>().image);
                     break;
-                case RenderLoadOp::DontCare:
+                case CommandType::Transition:
+                {
+                    const auto& transition = command.As<TransitionCommand>();
+                    Transition(*transition.image, transition.state);
                     break;
-            }
-        }
-
-        if (dsvHandle)
-        {
-            const auto& depthInfo = info.depth;
-            const auto& depthArray = depthInfo->depthStencil;
-
-            switch (depthInfo->loadOp)
-            {
-                case RenderLoadOp::Clear:
+                }
+                case CommandType::Alias:
                 {
-                    FLOAT depthValue = depthArray[0];
-                    UINT8 stencilValue = static_cast<UINT8>(depthArray[1]);
-                    _commandList->ClearDepthStencilView(
-                        *dsvHandle,
-                        D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL,
-                        depthValue,
-                        stencilValue,
-                        0,
-                        nullptr
-                    );
+                    const auto& alias = command.As<AliasCommand>();
+                    Alias(*alias.image, alias.state);
                     break;
                 }
-                case RenderLoadOp::DontCare:
+                case CommandType::BeginTiming:
+                    BeginTiming(command.As<BeginTimingCommand>().name);
                     break;
-                case RenderLoadOp::Load:
+                case CommandType::EndTiming:
+                    EndTiming();
                     break;
             }
         }
     }
 
-    void D3D12RenderContext::EndRecording(const RenderInfo& info)
+    void D3D12RenderContext::BeginTiming(const std::string_view name)
     {
-        for (size_t i = 0; i < info.color.size(); ++i)
+        if (_renderTarget)
         {
-            auto& colorInfo = info.color[i];
-            auto* img = dynamic_cast<D3D12ImageBuffer*>(colorInfo.image);
-            if (!img) 
-            {
-                debugging::Logger::Instance().LogError(
-                    "D3D12 cannot handle store operation on color image {}, the image doesn't cast back to D3D12ImageBuffer!",
-                    i
-                );
-                continue;
-            }
-            switch (colorInfo.storeOp)
-            {
-                case RenderStoreOp::DontCare:
-                {
-                    auto resource = static_cast<ID3D12Resource*>(img->Get());
-                    if (!resource) 
-                    {
-                        debugging::Logger::Instance().LogError(
-                            "D3D12 attempted to discard an image resource on color image {} via RenderStoreOp::DontCare, but it has no resource!",
-                            i
-                        );
-                        break;
-                    }
-                    _commandList->DiscardResource(resource, nullptr);
-                    break;
-                }
-                case RenderStoreOp::Store:
-                    break;
-            }
+            auto& timings = _renderTarget->GetTimings();
+            timings.Write(_commandList.Get(), _frameNum, timings.BeginScope(_frameNum, name));
         }
+    }
 
-        if (info.depth)
+    void D3D12RenderContext::EndTiming()
+    {
+        if (_renderTarget)
         {
-            auto& depthInfo = info.depth;
-            auto* img = dynamic_cast<D3D12ImageBuffer*>(depthInfo->image);
-            if (!img)
+            auto& timings = _renderTarget->GetTimings();
+            timings.Write(_commandList.Get(), _frameNum, timings.EndScope(_frameNum));
+        }
+    }
+
+    void D3D12RenderContext::BindAttachments(const std::span<IImageBuffer* const> color)
+    {
+        core::FixedVector<D3D12_CPU_DESCRIPTOR_HANDLE, kMaxColorAttachments> rtvHandles;
+        for (IImageBuffer* image : color)
+        {
+            auto* d3d12Image = BackendCast<D3D12ImageBuffer>(image);
+            if (d3d12Image)
             {
-                debugging::Logger::Instance().LogError(
-                    "D3D12 cannot handle store operation on depth image, the image doesn't cast back to D3D12ImageBuffer!"
-                );
-                _commandList->Close();
-                return;
-            }
-            switch (depthInfo->storeOp)
-            {
-                case RenderStoreOp::DontCare:
-                {
-                    auto resource = static_cast<ID3D12Resource*>(img->Get());
-                    if (!resource) 
-                    {
-                        debugging::Logger::Instance().LogError(
-                            "D3D12 attempted to discard an image resource on depth image via RenderStoreOp::DontCare, but it has no resource!"
-                        );
-                        break;
-                    }
-                    _commandList->DiscardResource(resource, nullptr);
-                    break;
-                }
-                case RenderStoreOp::Store:
-                    break;
+                rtvHandles.Push(d3d12Image->GetRTVHandle());
             }
         }
 
-        _commandList->Close();
+        if (!rtvHandles.empty())
+            _commandList->OMSetRenderTargets(static_cast<UINT>(rtvHandles.size()), rtvHandles.data(), FALSE, nullptr);
+    }
+
+    void D3D12RenderContext::SetViewport(const Viewport& viewport)
+    {
+        D3D12_VIEWPORT d3d12Viewport;
+        d3d12Viewport.Height = viewport.height;
+        d3d12Viewport.Width = viewport.width;
+        d3d12Viewport.MaxDepth = viewport.maxDepth;
+        d3d12Viewport.MinDepth = viewport.minDepth;
+        d3d12Viewport.TopLeftX = viewport.x;
+        d3d12Viewport.TopLeftY = viewport.y;
+
+        _commandList->RSSetViewports(1, &d3d12Viewport);
+    }
+
+    void D3D12RenderContext::SetScissor(const Scissor& scissor)
+    {
+        D3D12_RECT d3d12Rect;
+        d3d12Rect.left = scissor.x;
+        d3d12Rect.top = scissor.y;
+        d3d12Rect.right = scissor.x + scissor.width;
+        d3d12Rect.bottom = scissor.y + scissor.height;
+
+        _commandList->RSSetScissorRects(1, &d3d12Rect);
+    }
+
+    void D3D12RenderContext::ClearColor(IImageBuffer* image, const std::array<float, 4>& color)
+    {
+        auto* d3d12Image = BackendCast<D3D12ImageBuffer>(image);
+        if (!d3d12Image)
+        {
+            return;
+        }
+
+        FLOAT clearColor[4] = { color[0], color[1], color[2], color[3] };
+        _commandList->ClearRenderTargetView(d3d12Image->GetRTVHandle(), clearColor, 0, nullptr);
+    }
+
+    void D3D12RenderContext::ClearDepthStencil(IImageBuffer* image, const float depth, const UINT8 stencil)
+    {
+        auto* d3d12Image = BackendCast<D3D12ImageBuffer>(image);
+        if (!d3d12Image)
+        {
+            return;
+        }
+
+        _commandList->ClearDepthStencilView(
+            d3d12Image->GetDSVHandle(),
+            D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL,
+            depth,
+            stencil,
+            0,
+            nullptr
+        );
+    }
+
+    void D3D12RenderContext::Discard(IImageBuffer* image)
+    {
+        auto* d3d12Image = BackendCast<D3D12ImageBuffer>(image);
+        if (!d3d12Image)
+        {
+            LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxD3D12, std::chrono::seconds(1),
+                "D3D12 cannot handle store operation on an image that isn't a D3D12 image!"
+            );
+            return;
+        }
+
+        ID3D12Resource* resource = d3d12Image->GetResource();
+        if (!resource)
+        {
+            LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxD3D12, std::chrono::seconds(1),
+                "D3D12 attempted to discard an image via RenderStoreOp::DontCare, but it has no resource!"
+            );
+            return;
+        }
+        _commandList->DiscardResource(resource, nullptr);
     }
 }
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include <array>
 #include <resources/d3d12_image_buffer.h>
 #include <d3d12_device.h>
 #include <debugging/logger.h>
@@ -7,11 +8,11 @@
 namespace lumi::gfx::d3d12::resources
 {
     D3D12ImageBuffer::D3D12ImageBuffer(D3D12Device& device)
-        : _device(device)
+        : IImageBuffer(Backend::D3D12), _device(device)
     {}
 
     D3D12ImageBuffer::D3D12ImageBuffer(D3D12Device& device, ComPtr<ID3D12Resource> buffer)
-        : _device(device), _res(buffer)
+        : IImageBuffer(Backend::D3D12), _device(device), _res(buffer)
     {
         D3D12_RESOURCE_DESC desc = buffer->GetDesc();
         ImageDesc imgDesc = {};
@@ -28,23 +29,29 @@ namespace lumi::gfx::d3d12::resources
     }
 
     bool D3D12ImageBuffer::Create()
+    {
+        return CreateResource(nullptr, 0);
+    }
+
+    bool D3D12ImageBuffer::CreatePlaced(ComPtr<ID3D12Heap> heap, const UINT64 offset)
+    {
+        if (!heap)
+        {
+            LUMI_LOG_ERROR(debugging::LogGfxD3D12, "Cannot place an image without a heap");
+            return false;
+        }
+        return CreateResource(heap, offset);
+    }
+
+    bool D3D12ImageBuffer::CreateResource(ComPtr<ID3D12Heap> heap, const UINT64 offset)
     {
         if (_res)
         {
-            debugging::Logger::Instance().LogWarn("Please destroy the current image before creating one");
+            LUMI_LOG_WARN(debugging::LogGfxD3D12, "Please destroy the current image before creating one");
             return false;
         }
 
-        D3D12_RESOURCE_DESC desc = {};
-        desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-        desc.Width = _description.width;
-        desc.Height = _description.height;
-        desc.DepthOrArraySize = 1;
-        desc.MipLevels = 1;
-        desc.Format = utils::ChooseD3D12Format(_description.format);
-        desc.SampleDesc.Count = 1;
-        desc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
-        desc.Flags = utils::ChooseD3D12Flags(_description.usage);
+        D3D12_RESOURCE_DESC desc = utils::ChooseD3D12ResourceDesc(_description);
 
         D3D12_HEAP_PROPERTIES heapProps = {};
         heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
@@ -69,18 +76,28 @@ namespace lumi::gfx::d3d12::resources
             pClearValue = &clearValue;
         }
 
-        HRESULT hr = _device.Get()->CreateCommittedResource(
-            &heapProps,
-            D3D12_HEAP_FLAG_NONE,
-            &desc,
-            D3D12_RESOURCE_STATE_COMMON,
-            pClearValue,
-            IID_PPV_ARGS(&_res)
-        );
+        // Placed images share their heap's memory with other images, committed ones get their own
+        HRESULT hr = heap
+            ? _device.Get()->CreatePlacedResource(
+                heap.Get(),
+                offset,
+                &desc,
+                D3D12_RESOURCE_STATE_COMMON,
+                pClearValue,
+                IID_PPV_ARGS(&_res)
+            )
+            : _device.Get()->CreateCommittedResource(
+                &heapProps,
+                D3D12_HEAP_FLAG_NONE,
+                &desc,
+                D3D12_RESOURCE_STATE_COMMON,
+                pClearValue,
+                IID_PPV_ARGS(&_res)
+            );
 
         if (debugging::Logger::Instance().LogIfHRESULTFailure(hr, "Failed to create D3D12ImageBuffer"))
         {
-            debugging::Logger::Instance().LogInfo(
+            LUMI_LOG_INFO(debugging::LogGfxD3D12,
                 "Image description:\n \tWidth: {}\n \tHeight: {}\n \tFormat: {}\n \tFlags: {}",
                 desc.Width,
                 desc.Height,
@@ -93,7 +110,7 @@ namespace lumi::gfx::d3d12::resources
         _rtvIndex = _device.AllocateRTVIndex();
         if (_rtvIndex < 0)
         {
-            debugging::Logger::Instance().LogError(
+            LUMI_LOG_ERROR(debugging::LogGfxD3D12,
                 "Cannot allocate a new rtv index, out of rtv descriptors"
             );
             return false;
@@ -105,7 +122,7 @@ namespace lumi::gfx::d3d12::resources
             _rtvIndex = _device.AllocateRTVIndex();
             if (_rtvIndex < 0)
             {
-                debugging::Logger::Instance().LogError(
+                LUMI_LOG_ERROR(debugging::LogGfxD3D12,
                     "Cannot allocate a new rtv index, out of rtv descriptors"
                 );
                 return false;
@@ -114,7 +131,7 @@ namespace lumi::gfx::d3d12::resources
             auto rtvHeap = _device.GetRTVHeap();
             if (!rtvHeap)
             {
-                debugging::Logger::Instance().LogError("Image Buffers require the device to have a valid rtv heap!");
+                LUMI_LOG_ERROR(debugging::LogGfxD3D12, "Image Buffers require the device to have a valid rtv heap!");
                 return false;
             }
 
@@ -140,6 +157,34 @@ namespace lumi::gfx::d3d12::resources
         _state = toState;
     }
 
+    void D3D12ImageBuffer::Alias(const ImageState& toState)
+    {
+        std::array<D3D12_RESOURCE_BARRIER, 2> barriers = {};
+        UINT barrierCount = 1;
+        barriers[0].Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+        barriers[0].Aliasing.pResourceBefore = nullptr;
+        barriers[0].Aliasing.pResourceAfter = _res.Get();
+
+        if (_state != toState)
+        {
+            barriers[1].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            barriers[1].Transition.pResource = _res.Get();
+            barriers[1].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+            barriers[1].Transition.StateBefore = utils::ChooseD3D12State(_state);
+            barriers[1].Transition.StateAfter = utils::ChooseD3D12State(toState);
+            ++barrierCount;
+        }
+        _commandList->ResourceBarrier(barrierCount, barriers.data());
+        _state = toState;
+
+        // Aliased render targets and depth buffers have to be cleared, discarded or copied to before they're used,
+        // discarding is the cheapest and only works in the states they're written in
+        if (toState == ImageState::Color || toState == ImageState::DepthStencil || toState == ImageState::UAV)
+        {
+            _commandList->DiscardResource(_res.Get(), nullptr);
+        }
+    }
+
     void D3D12ImageBuffer::Destroy()
     {
         if (_rtvIndex >= 0) 
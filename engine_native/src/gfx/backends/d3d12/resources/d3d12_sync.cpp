@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <resources/d3d12_sync.h>
 #include <debugging/logger.h>
 
@@ -5,10 +6,10 @@ namespace lumi::gfx::d3d12::resources
 {
     D3D12Sync::~D3D12Sync() { Destroy(); }
 
-    bool D3D12Sync::Init(D3D12Device& device, int frameCount)
+    bool D3D12Sync::Init(D3D12Device& device)
     {
-        _frameCount = frameCount;
-        _fenceValues.resize(frameCount, 0);
+        _queue = device.GetCommandQueue();
+        _signaledValue = 0;
 
         if (debugging::Logger::Instance().LogIfHRESULTFailure(
             device.Get()->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&_fence)),
@@ -21,44 +22,83 @@ namespace lumi::gfx::d3d12::resources
         _fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
         if (!_fenceEvent)
         {
-            debugging::Logger::Instance().LogError("Failed to create D3D12 fence event");
+            LUMI_LOG_ERROR(debugging::LogGfxD3D12, "Failed to create D3D12 fence event");
             return false;
         }
         return true;
     }
 
-    void D3D12Sync::Signal(ID3D12CommandQueue* queue, int frameIndex)
+    void D3D12Sync::Destroy()
     {
-        _fenceValues[frameIndex]++;
-        queue->Signal(_fence.Get(), _fenceValues[frameIndex]);
+        if (_fenceEvent) {
+            CloseHandle(_fenceEvent);
+            _fenceEvent = nullptr;
+        }
+        _fence.Reset();
+        _queue.Reset();
     }
 
-    void D3D12Sync::WaitForFrame(int frameIndex)
+    uint64_t D3D12Sync::Signal()
     {
-        if (_fence->GetCompletedValue() < _fenceValues[frameIndex])
+        HRESULT hr = _queue->Signal(_fence.Get(), _signaledValue + 1);
+        if (FAILED(hr))
         {
-            _fence->SetEventOnCompletion(_fenceValues[frameIndex], _fenceEvent);
-            WaitForSingleObject(_fenceEvent, INFINITE);
+            // Waiting on the last value that was queued is still safe, the new work just isn't tracked
+            LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxD3D12, std::chrono::seconds(1),
+                "Failed to signal the fence with value {} (HRESULT: 0x{:08X})",
+                _signaledValue + 1, static_cast<unsigned int>(hr)
+            );
+            return _signaledValue;
         }
+        return ++_signaledValue;
     }
 
-    void D3D12Sync::AdvanceFrame()
+    bool D3D12Sync::Wait(const uint64_t value, const std::chrono::nanoseconds timeout)
     {
-        _currentFrame = (_currentFrame + 1) % _frameCount;
-    }
+        if (!_fence)
+        {
+            return value == 0;
+        }
 
-    void D3D12Sync::Destroy()
-    {
-        if (_fenceEvent) {
-            CloseHandle(_fenceEvent);
-            _fenceEvent = nullptr;
+        using Clock = std::chrono::steady_clock;
+        bool forever = timeout == kWaitForever;
+        Clock::time_point deadline = forever ? Clock::time_point::max() : Clock::now() + timeout;
+
+        // The event is shared by every wait, one that timed out leaves its value registered and the event fires for
+        // that value later, so a wake-up alone doesn't mean this value was reached
+        while (_fence->GetCompletedValue() < value)
+        {
+            DWORD milliseconds = INFINITE;
+            if (!forever)
+            {
+                auto remaining = deadline - Clock::now();
+                if (remaining <= std::chrono::nanoseconds::zero())
+                {
+                    return false;
+                }
+                // Round up so short timeouts still wait instead of polling once
+                auto rounded = std::chrono::ceil<std::chrono::milliseconds>(remaining).count();
+                milliseconds = static_cast<DWORD>(std::clamp<long long>(rounded, 0, INFINITE - 1));
+            }
+
+            if (FAILED(_fence->SetEventOnCompletion(value, _fenceEvent)))
+            {
+                LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxD3D12, std::chrono::seconds(1),
+                    "Failed to set the fence event for value {}", value);
+                return false;
+            }
+            if (WaitForSingleObject(_fenceEvent, milliseconds) == WAIT_FAILED)
+            {
+                LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxD3D12, std::chrono::seconds(1),
+                    "Failed to wait on the fence event for value {}", value);
+                return false;
+            }
         }
-        _fence.Reset();
-        _fenceValues.clear();
+        return true;
     }
 
-    UINT64 D3D12Sync::GetFenceValue(int frameIndex) const
+    uint64_t D3D12Sync::GetCompletedValue() const
     {
-        return _fenceValues[frameIndex];
+        return _fence ? _fence->GetCompletedValue() : 0;
     }
 }
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include <resources/d3d12_timing_queries.h>
+#include <debugging/logger.h>
+
+namespace lumi::gfx::d3d12::resources
+{
+    D3D12TimingQueries::~D3D12TimingQueries() { Destroy(); }
+
+    bool D3D12TimingQueries::Create(const uint32_t frameCount)
+    {
+        if (FAILED(_device.GetCommandQueue()->GetTimestampFrequency(&_frequency)) || _frequency == 0)
+        {
+            LUMI_LOG_ERROR(debugging::LogGfxD3D12, "Failed to get the command queue's timestamp frequency");
+            return false;
+        }
+
+        D3D12_QUERY_HEAP_DESC heapDesc = {};
+        heapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+        heapDesc.Count = kMaxQueriesPerFrame;
+
+        D3D12_HEAP_PROPERTIES heapProps = {};
+        heapProps.Type = D3D12_HEAP_TYPE_READBACK;
+
+        D3D12_RESOURCE_DESC bufferDesc = {};
+        bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        bufferDesc.Width = sizeof(UINT64) * kMaxQueriesPerFrame;
+        bufferDesc.Height = 1;
+        bufferDesc.DepthOrArraySize = 1;
+        bufferDesc.MipLevels = 1;
+        bufferDesc.Format = DXGI_FORMAT_UNKNOWN;
+        bufferDesc.SampleDesc.Count = 1;
+        bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+        _heaps.resize(frameCount);
+        _readback.resize(frameCount);
+        for (uint32_t i = 0; i < frameCount; ++i)
+        {
+            if (FAILED(_device.Get()->CreateQueryHeap(&heapDesc, IID_PPV_ARGS(&_heaps[i]))))
+            {
+                LUMI_LOG_ERROR(debugging::LogGfxD3D12, "Failed to create the timestamp query heap of frame {}", i);
+                return false;
+            }
+
+            if (FAILED(_device.Get()->CreateCommittedResource(
+                &heapProps,
+                D3D12_HEAP_FLAG_NONE,
+                &bufferDesc,
+                D3D12_RESOURCE_STATE_COPY_DEST,
+                nullptr,
+                IID_PPV_ARGS(&_readback[i])
+            )))
+            {
+                LUMI_LOG_ERROR(debugging::LogGfxD3D12, "Failed to create the timestamp readback buffer of frame {}", i);
+                return false;
+            }
+        }
+
+        SetFrameCount(frameCount);
+        return true;
+    }
+
+    void D3D12TimingQueries::Destroy()
+    {
+        _heaps.clear();
+        _readback.clear();
+        SetFrameCount(0);
+    }
+
+    void D3D12TimingQueries::Write(ID3D12GraphicsCommandList* commandList, const uint32_t frame, const uint32_t query)
+    {
+        if (query == kInvalidQuery || frame >= _heaps.size())
+        {
+            return;
+        }
+        commandList->EndQuery(_heaps[frame].Get(), D3D12_QUERY_TYPE_TIMESTAMP, query);
+    }
+
+    void D3D12TimingQueries::Resolve(ID3D12GraphicsCommandList* commandList, const uint32_t frame)
+    {
+        uint32_t count = GetQueryCount(frame);
+        if (count == 0 || frame >= _heaps.size())
+        {
+            return;
+        }
+        commandList->ResolveQueryData(_heaps[frame].Get(), D3D12_QUERY_TYPE_TIMESTAMP, 0, count, _readback[frame].Get(), 0);
+    }
+
+    bool D3D12TimingQueries::ReadTimestamps(const uint32_t frame, const std::span<uint64_t> nanoseconds)
+    {
+        if (frame >= _readback.size())
+        {
+            return false;
+        }
+
+        D3D12_RANGE readRange = { 0, nanoseconds.size_bytes() };
+        void* mapped = nullptr;
+        if (FAILED(_readback[frame]->Map(0, &readRange, &mapped)))
+        {
+            return false;
+        }
+
+        const auto* ticks = static_cast<const UINT64*>(mapped);
+        for (size_t i = 0; i < nanoseconds.size(); ++i)
+        {
+            // Split so ticks * 1e9 can't overflow
+            UINT64 seconds = ticks[i] / _frequency;
+            UINT64 remainder = ticks[i] % _frequency;
+            nanoseconds[i] = seconds * 1'000'000'000ull + remainder * 1'000'000'000ull / _frequency;
+        }
+
+        D3D12_RANGE writeRange = { 0, 0 };
+        _readback[frame]->Unmap(0, &writeRange);
+        return true;
+    }
+}
\ No newline at end of file
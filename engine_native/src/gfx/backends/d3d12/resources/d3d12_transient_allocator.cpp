@@ -0,0 +1,64 @@
+#include <resources/d3d12_transient_allocator.h>
+#include <resources/d3d12_image_buffer.h>
+#include <d3d12_device.h>
+#include <debugging/logger.h>
+
+#include <utils/d3d12_image_utils.h>
+
+namespace lumi::gfx::d3d12::resources
+{
+    ImageMemoryRequirements D3D12TransientAllocator::GetRequirements(const ImageDesc& desc)
+    {
+        D3D12_RESOURCE_DESC resourceDesc = utils::ChooseD3D12ResourceDesc(desc);
+        D3D12_RESOURCE_ALLOCATION_INFO info = _device.Get()->GetResourceAllocationInfo(0, 1, &resourceDesc);
+
+        ImageMemoryRequirements requirements;
+        requirements.size = info.SizeInBytes;
+        requirements.alignment = info.Alignment;
+        return requirements;
+    }
+
+    bool D3D12TransientAllocator::Reserve(const uint64_t size)
+    {
+        Release();
+
+        D3D12_HEAP_DESC desc = {};
+        desc.SizeInBytes = size;
+        desc.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+        desc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+        desc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+
+        auto hr = _device.Get()->CreateHeap(&desc, IID_PPV_ARGS(&_heap));
+        if (debugging::Logger::Instance().LogIfHRESULTFailure(hr, "Failed to create a {} byte transient heap", size))
+        {
+            return false;
+        }
+
+        _heapSize = size;
+        return true;
+    }
+
+    std::unique_ptr<IImageBuffer> D3D12TransientAllocator::CreateImage(const ImageDesc& desc, const uint64_t offset)
+    {
+        if (!_heap || offset + GetRequirements(desc).size > _heapSize)
+        {
+            LUMI_LOG_ERROR(debugging::LogGfxD3D12, "Image at offset {} doesn't fit in the {} byte transient heap",
+                offset, _heapSize);
+            return nullptr;
+        }
+
+        auto image = std::make_unique<D3D12ImageBuffer>(_device);
+        image->SetDesc(desc);
+        if (!image->CreatePlaced(_heap, offset))
+        {
+            return nullptr;
+        }
+        return image;
+    }
+
+    void D3D12TransientAllocator::Release()
+    {
+        _heap.Reset();
+        _heapSize = 0;
+    }
+}
\ No newline at end of file
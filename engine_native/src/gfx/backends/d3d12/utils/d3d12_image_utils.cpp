@@ -71,4 +71,19 @@ namespace lumi::gfx::d3d12::utils
                 return D3D12_RESOURCE_STATE_COMMON;
         }
     }
+
+    D3D12_RESOURCE_DESC ChooseD3D12ResourceDesc(const ImageDesc& desc)
+    {
+        D3D12_RESOURCE_DESC resourceDesc = {};
+        resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+        resourceDesc.Width = desc.width;
+        resourceDesc.Height = desc.height;
+        resourceDesc.DepthOrArraySize = 1;
+        resourceDesc.MipLevels = 1;
+        resourceDesc.Format = ChooseD3D12Format(desc.format);
+        resourceDesc.SampleDesc.Count = 1;
+        resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+        resourceDesc.Flags = ChooseD3D12Flags(desc.usage);
+        return resourceDesc;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include <null_device.h>
+#include <debugging/logger.h>
+
+namespace lumi::gfx::null
+{
+    bool NullDevice::Init()
+    {
+        if (_initialized)
+        {
+            LUMI_LOG_WARN(debugging::LogGfxNull, "Null device was already initialized");
+            return false;
+        }
+        _initialized = true;
+        return true;
+    }
+
+    void NullDevice::Cleanup()
+    {
+        _initialized = false;
+    }
+
+    void NullDevice::ResetCounts()
+    {
+        for (auto& count : _counts)
+        {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include <null_render_target.h>
+#include <debugging/logger.h>
+#include <debugging/profiler.h>
+
+namespace lumi::gfx::null
+{
+    NullRenderTarget::NullRenderTarget(NullDevice& device, const int width, const int height)
+        : IRenderTarget(Backend::Null), _device(device), _requestedWidth(width), _requestedHeight(height)
+    {
+
+    }
+
+    NullRenderTarget::~NullRenderTarget()
+    {
+        Cleanup();
+    }
+
+    bool NullRenderTarget::Init(const uint32_t maxInFlight)
+    {
+        _maxFramesInFlight = maxInFlight;
+        _frameValues.assign(_maxFramesInFlight, 0);
+        _frameArenas.SetFrameCount(_maxFramesInFlight);
+        _timings.SetFrameCount(_maxFramesInFlight);
+
+        Clock::time_point now = Now();
+        _resizePolicy.Request(_requestedWidth, _requestedHeight, now);
+        _resizePolicy.Reset(_requestedWidth, _requestedHeight, now);
+        _appliedGeneration = _requestedGeneration;
+
+        if (!CreateImages()) return false;
+
+        return true;
+    }
+
+    void NullRenderTarget::Resize(const int width, const int height)
+    {
+        // Wait for the simulated GPU to finish frames before resizing the buffers
+        _sync.WaitIdle();
+
+        DestroyImages();
+        Clock::time_point now = Now();
+        _resizePolicy.Request(width, height, now);
+        _resizePolicy.Reset(width, height, now);
+        CreateImages();
+
+        _device.Count(NullOp::Resizes);
+    }
+
+    void NullRenderTarget::StartRendering(const uint32_t index)
+    {
+        LUMI_PROFILE_ZONE_INDEX("NullRenderTarget::StartRendering", index);
+        Clock::time_point now = Now();
+        if (OutOfDate())
+        {
+            _appliedGeneration = _requestedGeneration;
+            _resizePolicy.Request(_requestedWidth, _requestedHeight, now);
+            if (_formatChanged)
+            {
+                _formatChanged = false;
+                _resizePolicy.Force();
+            }
+        }
+        ApplyResizePolicy(now);
+
+        // Only the frame that last used this index has to be done before its images are reused
+        WaitForFrame(index);
+        _frameArenas.BeginFrame(index);
+        _timings.BeginFrame(index);
+
+        auto& colorBuffer = _colorBuffers[index];
+        auto& depthBuffer = _depthBuffers[index];
+
+        colorBuffer->Transition(ImageState::Color);
+        if (depthBuffer->GetState() != ImageState::DepthStencil)
+        {
+            depthBuffer->Transition(ImageState::DepthStencil);
+        }
+
+        _device.Count(NullOp::FramesStarted);
+    }
+
+    void NullRenderTarget::EndRendering(const uint32_t index)
+    {
+        LUMI_PROFILE_ZONE_INDEX("NullRenderTarget::EndRendering", index);
+
+        // Move ONLY color to present, depth is not presented
+        _colorBuffers[index]->Transition(ImageState::Present);
+
+        _device.Count(NullOp::FramesEnded);
+    }
+
+    void NullRenderTarget::SubmitRendering(const uint32_t index)
+    {
+        LUMI_PROFILE_ZONE_INDEX("NullRenderTarget::SubmitRendering", index);
+        if (_colorBuffers[index]->GetState() != ImageState::Present)
+        {
+            _device.Count(NullOp::InvalidTransitions);
+            if (_device.GetConfig().logValidationErrors)
+            {
+                LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxNull, std::chrono::seconds(1),
+                    "Submitted frame {} without its color image in the present state", index
+                );
+            }
+        }
+
+        // The simulated GPU starts on this frame once the previous one is done
+        _frameValues[index] = _sync.Signal();
+
+        _device.Count(NullOp::FramesSubmitted);
+    }
+
+    bool NullRenderTarget::OutOfDate() const
+    {
+        return _requestedGeneration != _appliedGeneration;
+    }
+
+    void NullRenderTarget::Cleanup()
+    {
+        _sync.WaitIdle();
+
+        DestroyImages();
+        _frameValues.clear();
+    }
+
+    bool NullRenderTarget::CreateImages()
+    {
+        _colorBuffers.resize(_maxFramesInFlight);
+        _depthBuffers.resize(_maxFramesInFlight);
+
+        for (uint32_t i = 0; i < _maxFramesInFlight; ++i)
+        {
+            resources::ImageDesc colorDesc = {};
+            colorDesc.format = resources::ImageFormat::RGBA8;
+            colorDesc.width = static_cast<uint32_t>(_resizePolicy.GetBufferWidth());
+            colorDesc.height = static_cast<uint32_t>(_resizePolicy.GetBufferHeight());
+            colorDesc.usage = resources::ImageUsage::Render;
+
+            _colorBuffers[i] = std::make_shared<NullImageBuffer>(_device);
+            _colorBuffers[i]->SetDesc(colorDesc);
+            if (!_colorBuffers[i]->Create())
+            {
+                LUMI_LOG_ERROR(debugging::LogGfxNull, "Failed to create color image for index {}", i);
+                return false;
+            }
+
+            resources::ImageDesc depthDesc = {};
+            depthDesc.format = resources::ImageFormat::Depth24Stencil8;
+            depthDesc.width = static_cast<uint32_t>(_resizePolicy.GetBufferWidth());
+            depthDesc.height = static_cast<uint32_t>(_resizePolicy.GetBufferHeight());
+            depthDesc.usage = resources::ImageUsage::DepthStencil;
+
+            _depthBuffers[i] = std::make_shared<NullImageBuffer>(_device);
+            _depthBuffers[i]->SetDesc(depthDesc);
+            if (!_depthBuffers[i]->Create())
+            {
+                LUMI_LOG_ERROR(debugging::LogGfxNull, "Failed to create depth image for index {}", i);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void NullRenderTarget::DestroyImages()
+    {
+        _colorBuffers.clear();
+        _depthBuffers.clear();
+    }
+
+    void NullRenderTarget::WaitForFrame(const uint32_t index)
+    {
+        _sync.Wait(_frameValues[index]);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include <gfx/render/command_buffer.h>
+#include <render/null_render_context.h>
+#include <null_render_target.h>
+
+#include <debugging/logger.h>
+
+namespace lumi::gfx::null::render
+{
+    void NullRenderContext::SetRenderTarget(IRenderTarget& window)
+    {
+        auto* renderTarget = BackendCast<NullRenderTarget>(&window);
+        if (!renderTarget)
+        {
+            return;
+        }
+
+        _renderTarget = renderTarget;
+        _device.Count(NullOp::RenderTargetsSet);
+    }
+
+    void NullRenderContext::BeginRecording(const RenderInfo& info)
+    {
+        bool valid = true;
+        for (const auto& colorInfo : info.color)
+        {
+            valid &= IsInState(colorInfo.image, ImageState::Color);
+        }
+        if (info.depth)
+        {
+            valid &= IsInState(info.depth->image, ImageState::DepthStencil);
+        }
+        BeginPass(valid);
+    }
+
+    void NullRenderContext::EndRecording(const RenderInfo&)
+    {
+        EndPass();
+    }
+
+    void NullRenderContext::Transition(IImageBuffer& image, const ImageState& state)
+    {
+        // The image validates and counts its own transitions
+        image.Transition(state);
+    }
+
+    void NullRenderContext::Alias(IImageBuffer& image, const ImageState& state)
+    {
+        image.Alias(state);
+    }
+
+    void NullRenderContext::Execute(const CommandBuffer& commands)
+    {
+        using namespace gfx::render;
+        for (const CommandHeader& command : commands)
+        {
+            switch (command.type)
+            {
+                case CommandType::SetRenderTarget:
+                    SetRenderTarget(*command.As<SetRenderTargetCommand>().target);
+                    break;
+                case CommandType::BeginPass:
+                {
+                    const auto& begin = command.As<BeginPassCommand>();
+                    bool valid = true;
+                    for (const IImageBuffer* image : begin.GetColor())
+                    {
+                        valid &= IsInState(image, ImageState::Color);
+                    }
+                    if (begin.depth)
+                    {
+                        valid &= IsInState(begin.depth, ImageState::DepthStencil);
+                    }
+                    BeginPass(valid);
+                    break;
+                }
+                case CommandType::EndPass:
+                    EndPass();
+                    break;
+                case CommandType::Transition:
+                {
+                    const auto& transition = command.As<TransitionCommand>();
+                    transition.image->Transition(transition.state);
+                    break;
+                }
+                case CommandType::Alias:
+                {
+                    const auto& alias = command.As<AliasCommand>();
+                    alias.image->Alias(alias.state);
+                    break;
+                }
+                case CommandType::BeginTiming:
+                    BeginTiming(command.As<BeginTimingCommand>().name);
+                    break;
+                case CommandType::EndTiming:
+                    EndTiming();
+                    break;
+                // Nothing is drawn, so views, clears and discards have nothing to check
+                case CommandType::SetViewport:
+                case CommandType::SetScissor:
+                case CommandType::ClearColor:
+                case CommandType::ClearDepthStencil:
+                case CommandType::Discard:
+                    break;
+            }
+        }
+    }
+
+    void NullRenderContext::BeginTiming(const std::string_view name)
+    {
+        if (_renderTarget)
+        {
+            auto& timings = _renderTarget->GetTimings();
+            timings.Write(_frameNum, timings.BeginScope(_frameNum, name));
+        }
+    }
+
+    void NullRenderContext::EndTiming()
+    {
+        if (_renderTarget)
+        {
+            auto& timings = _renderTarget->GetTimings();
+            timings.Write(_frameNum, timings.EndScope(_frameNum));
+        }
+    }
+
+    void NullRenderContext::BeginPass(const bool attachmentsValid)
+    {
+        if (_recording || !attachmentsValid)
+        {
+            _device.Count(NullOp::InvalidRecordings);
+            if (_device.GetConfig().logValidationErrors)
+            {
+                LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxNull, std::chrono::seconds(1),
+                    "Began recording frame {} while already recording or with an attachment in the wrong state",
+                    _frameNum
+                );
+            }
+        }
+
+        _recording = true;
+        _device.Count(NullOp::RecordingsBegun);
+    }
+
+    void NullRenderContext::EndPass()
+    {
+        if (!_recording)
+        {
+            _device.Count(NullOp::InvalidRecordings);
+            if (_device.GetConfig().logValidationErrors)
+            {
+                LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxNull, std::chrono::seconds(1),
+                    "Ended recording frame {} without beginning it", _frameNum
+                );
+            }
+        }
+
+        _recording = false;
+        _device.Count(NullOp::RecordingsEnded);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include <resources/null_image_buffer.h>
+#include <null_device.h>
+#include <debugging/logger.h>
+
+namespace lumi::gfx::null::resources
+{
+    namespace
+    {
+        bool HasUsage(const ImageUsage& usage, const ImageUsage& required)
+        {
+            return (usage & required) == required;
+        }
+    }
+
+    NullImageBuffer::NullImageBuffer(NullDevice& device)
+        : IImageBuffer(Backend::Null), _device(device)
+    {}
+
+    NullImageBuffer::~NullImageBuffer()
+    {
+        Destroy();
+    }
+
+    bool NullImageBuffer::Create()
+    {
+        if (_created)
+        {
+            LUMI_LOG_WARN(debugging::LogGfxNull, "Please destroy the current image before creating one");
+            return false;
+        }
+
+        _created = true;
+        _state = ImageState::Undefined;
+        _device.Count(NullOp::ImagesCreated);
+        return true;
+    }
+
+    void NullImageBuffer::Transition(const ImageState& toState)
+    {
+        if (_state == toState) return;
+
+        if (!_created || !IsTransitionValid(_description.usage, toState))
+        {
+            RejectTransition(toState);
+            return;
+        }
+
+        _device.Count(NullOp::Transitions);
+        _state = toState;
+    }
+
+    void NullImageBuffer::Alias(const ImageState& toState)
+    {
+        if (!_created || !IsTransitionValid(_description.usage, toState))
+        {
+            RejectTransition(toState);
+            return;
+        }
+
+        _device.Count(NullOp::Aliases);
+        _state = toState;
+    }
+
+    void NullImageBuffer::Destroy()
+    {
+        if (!_created)
+        {
+            return;
+        }
+
+        _created = false;
+        _state = ImageState::Undefined;
+        _device.Count(NullOp::ImagesDestroyed);
+    }
+
+    void NullImageBuffer::RejectTransition(const ImageState& toState)
+    {
+        _device.Count(NullOp::InvalidTransitions);
+        if (_device.GetConfig().logValidationErrors)
+        {
+            LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxNull, std::chrono::seconds(1),
+                "Invalid transition of image from state {} to {} (usage: {}, created: {})",
+                static_cast<int>(_state), static_cast<int>(toState),
+                static_cast<uint32_t>(_description.usage), _created
+            );
+        }
+    }
+
+    bool NullImageBuffer::IsTransitionValid(const ImageUsage& usage, const ImageState& toState)
+    {
+        switch (toState)
+        {
+            case ImageState::Color:
+            case ImageState::Present:
+                return HasUsage(usage, ImageUsage::Render);
+            case ImageState::DepthStencil:
+                return HasUsage(usage, ImageUsage::DepthStencil);
+            case ImageState::Shader:
+                return HasUsage(usage, ImageUsage::Shader);
+            case ImageState::UAV:
+                return HasUsage(usage, ImageUsage::UAV);
+            case ImageState::Undefined:
+                return false;
+        }
+        return false;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <thread>
+#include <resources/null_sync.h>
+#include <null_device.h>
+
+namespace lumi::gfx::null::resources
+{
+    uint64_t NullSync::Signal()
+    {
+        std::lock_guard lock(_mutex);
+        Clock::time_point now = Clock::now();
+        Retire(now);
+
+        // The simulated GPU starts on this work once everything before it is done
+        Clock::time_point start = _pending.empty() ? now : std::max(now, _pending.back());
+        _pending.push_back(start + _device.GetConfig().gpuLatency);
+        return ++_signaledValue;
+    }
+
+    bool NullSync::Wait(const uint64_t value, const std::chrono::nanoseconds timeout)
+    {
+        Clock::time_point done;
+        {
+            std::lock_guard lock(_mutex);
+            Retire(Clock::now());
+            if (value <= _completedValue)
+            {
+                return true;
+            }
+            if (value > _signaledValue)
+            {
+                // Nothing will ever signal it, fail like a timeout instead of hanging
+                return false;
+            }
+            done = _pending[value - _completedValue - 1];
+        }
+
+        _device.Count(NullOp::GpuWaits);
+        if (timeout != kWaitForever && timeout < done - Clock::now())
+        {
+            std::this_thread::sleep_for(timeout);
+            return false;
+        }
+        std::this_thread::sleep_until(done);
+        return true;
+    }
+
+    uint64_t NullSync::GetCompletedValue() const
+    {
+        std::lock_guard lock(_mutex);
+        Retire(Clock::now());
+        return _completedValue;
+    }
+
+    uint64_t NullSync::GetSignaledValue() const
+    {
+        std::lock_guard lock(_mutex);
+        return _signaledValue;
+    }
+
+    void NullSync::Retire(const Clock::time_point now) const
+    {
+        // Only the frames in flight are pending, so erasing from the front moves a few elements and never allocates
+        auto done = std::find_if(_pending.begin(), _pending.end(), [&](Clock::time_point time) { return time > now; });
+        _completedValue += static_cast<uint64_t>(done - _pending.begin());
+        _pending.erase(_pending.begin(), done);
+    }
+}
\ No newline at end of file
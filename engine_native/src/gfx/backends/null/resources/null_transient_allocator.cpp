@@ -0,0 +1,42 @@
+#include <resources/null_transient_allocator.h>
+#include <resources/null_image_buffer.h>
+#include <null_device.h>
+#include <debugging/logger.h>
+
+namespace lumi::gfx::null::resources
+{
+    ImageMemoryRequirements NullTransientAllocator::GetRequirements(const ImageDesc& desc)
+    {
+        uint64_t size = uint64_t(desc.width) * desc.height * gfx::resources::GetImageFormatSize(desc.format);
+
+        ImageMemoryRequirements requirements;
+        requirements.size = (size + kPlacementAlignment - 1) / kPlacementAlignment * kPlacementAlignment;
+        requirements.alignment = kPlacementAlignment;
+        return requirements;
+    }
+
+    bool NullTransientAllocator::Reserve(const uint64_t size)
+    {
+        _heapSize = size;
+        _device.Count(NullOp::HeapsReserved);
+        return true;
+    }
+
+    std::unique_ptr<IImageBuffer> NullTransientAllocator::CreateImage(const ImageDesc& desc, const uint64_t offset)
+    {
+        if (offset + GetRequirements(desc).size > _heapSize)
+        {
+            LUMI_LOG_ERROR(debugging::LogGfxNull, "Image at offset {} doesn't fit in the {} byte transient heap",
+                offset, _heapSize);
+            return nullptr;
+        }
+
+        auto image = std::make_unique<NullImageBuffer>(_device);
+        image->SetDesc(desc);
+        if (!image->Create())
+        {
+            return nullptr;
+        }
+        return image;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <cstring>
+#include <gfx/render/command_buffer.h>
+#include <gfx/render/render_info.h>
+#include <debugging/logger.h>
+
+namespace lumi::gfx::render
+{
+    CommandBuffer::CommandBuffer(core::LinearArena& arena, const size_t chunkSize)
+        : _arena(&arena), _chunkSize(chunkSize)
+    {
+    }
+
+    void CommandBuffer::SetRenderTarget(IRenderTarget& target)
+    {
+        Push<SetRenderTargetCommand>().target = &target;
+    }
+
+    void CommandBuffer::BeginPass(std::span<IImageBuffer* const> color, IImageBuffer* depth)
+    {
+        if (color.size() > kMaxColorAttachments)
+        {
+            LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxRender, std::chrono::seconds(1),
+                "A pass began with {} color images but at most {} can be bound, the rest were dropped",
+                color.size(), kMaxColorAttachments
+            );
+            color = color.first(kMaxColorAttachments);
+        }
+
+        auto& command = Push<BeginPassCommand>(color.size_bytes());
+        command.colorCount = static_cast<uint8_t>(color.size());
+        command.depth = depth;
+        std::memcpy(&command + 1, color.data(), color.size_bytes());
+    }
+
+    void CommandBuffer::EndPass()
+    {
+        Push<EndPassCommand>();
+    }
+
+    void CommandBuffer::SetViewport(const Viewport& viewport)
+    {
+        Push<SetViewportCommand>().viewport = viewport;
+    }
+
+    void CommandBuffer::SetScissor(const Scissor& scissor)
+    {
+        Push<SetScissorCommand>().scissor = scissor;
+    }
+
+    void CommandBuffer::ClearColor(IImageBuffer& image, const std::array<float, 4>& color)
+    {
+        auto& command = Push<ClearColorCommand>();
+        command.image = &image;
+        command.color = color;
+    }
+
+    void CommandBuffer::ClearDepthStencil(IImageBuffer& image, const float depth, const uint8_t stencil)
+    {
+        auto& command = Push<ClearDepthStencilCommand>();
+        command.image = &image;
+        command.depth = depth;
+        command.stencil = stencil;
+    }
+
+    void CommandBuffer::Discard(IImageBuffer& image)
+    {
+        Push<DiscardCommand>().image = &image;
+    }
+
+    void CommandBuffer::Transition(IImageBuffer& image, const ImageState state)
+    {
+        auto& command = Push<TransitionCommand>();
+        command.image = &image;
+        command.state = state;
+    }
+
+    void CommandBuffer::Alias(IImageBuffer& image, const ImageState state)
+    {
+        auto& command = Push<AliasCommand>();
+        command.image = &image;
+        command.state = state;
+    }
+
+    void CommandBuffer::BeginTiming(const std::string_view name)
+    {
+        Push<BeginTimingCommand>().name = name;
+    }
+
+    void CommandBuffer::EndTiming()
+    {
+        Push<EndTimingCommand>();
+    }
+
+    void CommandBuffer::Append(const CommandBuffer& other)
+    {
+        for (const CommandHeader& command : other)
+        {
+            std::memcpy(Reserve(command.size), &command, command.size);
+        }
+    }
+
+    void CommandBuffer::Clear()
+    {
+        _first = nullptr;
+        _last = nullptr;
+        _commandCount = 0;
+        _size = 0;
+    }
+
+    void* CommandBuffer::Reserve(const size_t size)
+    {
+        if (!_last || _last->used + size > _last->capacity)
+        {
+            size_t capacity = std::max(_chunkSize, size);
+            auto* chunk = ::new (_arena->Allocate(sizeof(Chunk) + capacity, alignof(Chunk))) Chunk{ nullptr, 0, static_cast<uint32_t>(capacity) };
+            (_last ? _last->next : _first) = chunk;
+            _last = chunk;
+        }
+
+        void* memory = reinterpret_cast<std::byte*>(_last + 1) + _last->used;
+        _last->used += static_cast<uint32_t>(size);
+        _size += size;
+        ++_commandCount;
+        return memory;
+    }
+}
\ No newline at end of file
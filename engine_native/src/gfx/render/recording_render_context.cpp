@@ -0,0 +1,82 @@
+#include <gfx/render/recording_render_context.h>
+
+namespace lumi::gfx::render
+{
+    void RecordingRenderContext::RecordFrame(IRenderTarget& target, const uint32_t frame)
+    {
+        SetFrameNumber(frame);
+        _frameCommands.emplace(target.GetFrameArena(frame));
+        _commands = &*_frameCommands;
+    }
+
+    void RecordingRenderContext::SetRenderTarget(IRenderTarget& window)
+    {
+        _commands->SetRenderTarget(window);
+    }
+
+    void RecordingRenderContext::BeginRecording(const RenderInfo& info)
+    {
+        core::FixedVector<IImageBuffer*, kMaxColorAttachments> color;
+        for (const auto& colorInfo : info.color)
+        {
+            color.Push(colorInfo.image);
+        }
+        _commands->BeginPass(color.AsSpan(), info.depth ? info.depth->image : nullptr);
+        _commands->SetViewport(info.view.view);
+        _commands->SetScissor(info.view.scissor);
+
+        for (const auto& colorInfo : info.color)
+        {
+            if (colorInfo.image && colorInfo.loadOp == RenderLoadOp::Clear)
+            {
+                _commands->ClearColor(*colorInfo.image, colorInfo.color);
+            }
+        }
+        if (info.depth && info.depth->image && info.depth->loadOp == RenderLoadOp::Clear)
+        {
+            const auto& depthStencil = info.depth->depthStencil;
+            _commands->ClearDepthStencil(*info.depth->image, depthStencil[0], static_cast<uint8_t>(depthStencil[1]));
+        }
+    }
+
+    void RecordingRenderContext::EndRecording(const RenderInfo& info)
+    {
+        for (const auto& colorInfo : info.color)
+        {
+            if (colorInfo.image && colorInfo.storeOp == RenderStoreOp::DontCare)
+            {
+                _commands->Discard(*colorInfo.image);
+            }
+        }
+        if (info.depth && info.depth->image && info.depth->storeOp == RenderStoreOp::DontCare)
+        {
+            _commands->Discard(*info.depth->image);
+        }
+        _commands->EndPass();
+    }
+
+    void RecordingRenderContext::Transition(IImageBuffer& image, const ImageState& state)
+    {
+        _commands->Transition(image, state);
+    }
+
+    void RecordingRenderContext::Alias(IImageBuffer& image, const ImageState& state)
+    {
+        _commands->Alias(image, state);
+    }
+
+    void RecordingRenderContext::BeginTiming(const std::string_view name)
+    {
+        _commands->BeginTiming(name);
+    }
+
+    void RecordingRenderContext::EndTiming()
+    {
+        _commands->EndTiming();
+    }
+
+    void RecordingRenderContext::Execute(const CommandBuffer& commands)
+    {
+        _commands->Append(commands);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,749 @@
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <gfx/render/render_context.h>
+#include <gfx/render/render_graph.h>
+#include <debugging/logger.h>
+
+namespace lumi::gfx::render
+{
+    RenderGraphImage RenderGraph::ImportImage(const std::string& name, RenderGraphImageResolver resolver,
+        const ImageState finalState)
+    {
+        Image image;
+        image.name = name;
+        image.resolver = std::move(resolver);
+        image.finalState = finalState;
+        _images.push_back(std::move(image));
+        _dirty = true;
+        return { static_cast<uint32_t>(_images.size() - 1) };
+    }
+
+    RenderGraphImage RenderGraph::CreateImage(const std::string& name, const ImageDesc& desc)
+    {
+        auto index = static_cast<uint32_t>(_images.size());
+        RenderGraphImageResolver resolver = [this, index](IRenderContext&, IRenderTarget*)
+        {
+            return _images[index].buffer.get();
+        };
+
+        Image image;
+        image.name = name;
+        image.resolver = std::move(resolver);
+        image.transient = true;
+        image.desc = desc;
+        _images.push_back(std::move(image));
+        _dirty = true;
+        return { index };
+    }
+
+    void RenderGraph::SetTransientAllocator(ITransientAllocator* allocator)
+    {
+        for (auto& image : _images)
+        {
+            image.buffer.reset();
+        }
+        _retainedTransients.clear();
+        _transientAllocator = allocator;
+        _dirty = true;
+        _valid = false;
+        _compileFailed = false;
+    }
+
+    void RenderGraph::NewPass(const std::string& name, RenderGraphPass pass)
+    {
+        if (_passNames.Find(name).IsValid())
+        {
+            LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxRender, std::chrono::seconds(1),
+                "Attempted to add a graph pass called {} but one was already added!", name);
+            return;
+        }
+
+        _passes.push_back({ _passNames.GetString(_passNames.Intern(name)), std::move(pass) });
+        _dirty = true;
+    }
+
+    bool RenderGraph::Compile()
+    {
+        _dirty = false;
+        _valid = false;
+        _compileFailed = true;
+        _order.clear();
+        _orchestrator.Clear();
+        _retainedTransients.clear();
+        _plannedTransitions = 0;
+        _compiledHash = HashStructure();
+        SnapshotStructure();
+        SnapshotTargets();
+        ++_compileCount;
+
+        if (!Validate())
+        {
+            return false;
+        }
+
+        std::vector<size_t> order;
+        if (!SortPasses(order))
+        {
+            return false;
+        }
+        CullPasses(order);
+
+        if (!PlanTransitions(order) || !AllocateTransients())
+        {
+            _order.clear();
+            _plannedTransitions = 0;
+            return false;
+        }
+
+        BuildOrchestrator();
+        _valid = true;
+        _compileFailed = false;
+        return true;
+    }
+
+    void RenderGraph::Execute(IRenderContext& ctx)
+    {
+        if (_dirty || TargetsResized())
+        {
+            bool unchanged = HashStructure() == _compiledHash && MatchesCompiled();
+            if (unchanged && _compileFailed)
+            {
+                // The same structure would fail the same way again, it waits for a change instead
+                _dirty = false;
+            }
+            else if (!unchanged || !_valid || !ReuseCompiled())
+            {
+                Compile();
+            }
+        }
+
+        if (_valid)
+        {
+            _orchestrator.Execute(ctx);
+        }
+    }
+
+    void RenderGraph::Clear()
+    {
+        // The compiled schedule stays, a graph rebuilt with the same structure reuses it and its transient images.
+        // Images without buffers were cleared before or rebuilt without executing, the retained buffers still apply.
+        bool holdsBuffers = std::any_of(_images.begin(), _images.end(),
+            [](const Image& image) { return image.buffer != nullptr; });
+        if (holdsBuffers)
+        {
+            _retainedTransients.clear();
+            for (auto& image : _images)
+            {
+                _retainedTransients.push_back(std::move(image.buffer));
+            }
+        }
+        _images.clear();
+        _passes.clear();
+        _passNames.Clear();
+        _dirty = true;
+    }
+
+    void RenderGraph::Reset()
+    {
+        Clear();
+        _retainedTransients.clear();
+        _placedTransients.clear();
+        _compiledImages.clear();
+        _compiledPasses.clear();
+        _order.clear();
+        _orchestrator.Clear();
+        _targetSizes.clear();
+        _transientPlan = {};
+        _plannedTransitions = 0;
+        _valid = false;
+        _compileFailed = false;
+    }
+
+    std::vector<std::string> RenderGraph::GetCompiledOrder() const
+    {
+        std::vector<std::string> names;
+        if (_dirty)
+        {
+            return names;
+        }
+
+        names.reserve(_order.size());
+        for (const auto& compiled : _order)
+        {
+            names.emplace_back(_passes[compiled.pass].name);
+        }
+        return names;
+    }
+
+    IImageBuffer* RenderGraph::GetTransientImage(const RenderGraphImage image) const
+    {
+        if (image.index >= _images.size() || !_images[image.index].transient)
+        {
+            return nullptr;
+        }
+        return _images[image.index].buffer.get();
+    }
+
+    IImageBuffer* RenderGraph::ColorBuffer(IRenderContext& ctx, IRenderTarget* target)
+    {
+        return target->GetColorBuffer(ctx.GetFrameNumber()).get();
+    }
+
+    IImageBuffer* RenderGraph::DepthBuffer(IRenderContext& ctx, IRenderTarget* target)
+    {
+        return target->GetDepthBuffer(ctx.GetFrameNumber()).get();
+    }
+
+    bool RenderGraph::Validate() const
+    {
+        bool valid = true;
+        for (const auto& pass : _passes)
+        {
+            auto check = [&](const std::vector<RenderGraphAccess>& accesses)
+            {
+                for (const auto& access : accesses)
+                {
+                    if (access.image.index >= _images.size())
+                    {
+                        LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxRender, std::chrono::seconds(1),
+                            "Graph pass {} uses an image that wasn't imported", pass.name);
+                        valid = false;
+                    }
+                    else if (access.state == ImageState::Undefined)
+                    {
+                        LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxRender, std::chrono::seconds(1),
+                            "Graph pass {} uses image {} in the Undefined state",
+                            pass.name, _images[access.image.index].name);
+                        valid = false;
+                    }
+                }
+            };
+            check(pass.info.reads);
+            check(pass.info.writes);
+        }
+        return valid;
+    }
+
+    bool RenderGraph::SortPasses(std::vector<size_t>& order) const
+    {
+        // Walking the passes in the order they were added, a read depends on the last write before it
+        // and a write on the last write and every read since then, so ping-ponging between images stays valid
+        std::vector<std::vector<size_t>> dependents(_passes.size());
+        std::vector<uint32_t> dependencies(_passes.size(), 0);
+        auto addEdge = [&](const size_t from, const size_t to)
+        {
+            if (from != to)
+            {
+                dependents[from].push_back(to);
+                ++dependencies[to];
+            }
+        };
+
+        constexpr size_t kNone = ~size_t(0);
+        std::vector<size_t> lastWriter(_images.size(), kNone);
+        std::vector<std::vector<size_t>> readers(_images.size());
+        for (size_t i = 0; i < _passes.size(); ++i)
+        {
+            for (const auto& access : _passes[i].info.reads)
+            {
+                size_t image = access.image.index;
+                if (lastWriter[image] != kNone)
+                {
+                    addEdge(lastWriter[image], i);
+                }
+                readers[image].push_back(i);
+            }
+            for (const auto& access : _passes[i].info.writes)
+            {
+                size_t image = access.image.index;
+                if (lastWriter[image] == i)
+                {
+                    continue;
+                }
+                if (lastWriter[image] != kNone)
+                {
+                    addEdge(lastWriter[image], i);
+                }
+                for (size_t reader : readers[image])
+                {
+                    addEdge(reader, i);
+                }
+                readers[image].clear();
+                lastWriter[image] = i;
+            }
+        }
+
+        // Passes that are ready run in the order they were added, so independent passes keep their order
+        std::priority_queue<size_t, std::vector<size_t>, std::greater<>> ready;
+        for (size_t i = 0; i < _passes.size(); ++i)
+        {
+            if (dependencies[i] == 0)
+            {
+                ready.push(i);
+            }
+        }
+
+        order.clear();
+        while (!ready.empty())
+        {
+            size_t pass = ready.top();
+            ready.pop();
+            order.push_back(pass);
+
+            for (size_t dependent : dependents[pass])
+            {
+                if (--dependencies[dependent] == 0)
+                {
+                    ready.push(dependent);
+                }
+            }
+        }
+
+        if (order.size() == _passes.size())
+        {
+            return true;
+        }
+
+        // Edges only point to later passes so this is a guard, passes left over either sit on a cycle or wait on one
+        for (size_t i = 0; i < _passes.size(); ++i)
+        {
+            if (dependencies[i] > 0 && ReachesItself(i, dependents, dependencies))
+            {
+                LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxRender, std::chrono::seconds(1),
+                    "Graph pass {} is part of a dependency cycle", _passes[i].name);
+            }
+        }
+        return false;
+    }
+
+    bool RenderGraph::ReachesItself(const size_t pass, const std::vector<std::vector<size_t>>& dependents,
+        const std::vector<uint32_t>& dependencies)
+    {
+        std::vector<bool> visited(dependents.size(), false);
+        std::vector<size_t> stack(dependents[pass].begin(), dependents[pass].end());
+        while (!stack.empty())
+        {
+            size_t next = stack.back();
+            stack.pop_back();
+            if (next == pass)
+            {
+                return true;
+            }
+            if (visited[next] || dependencies[next] == 0)
+            {
+                continue;
+            }
+            visited[next] = true;
+            stack.insert(stack.end(), dependents[next].begin(), dependents[next].end());
+        }
+        return false;
+    }
+
+    void RenderGraph::CullPasses(std::vector<size_t>& order) const
+    {
+        // Walk backwards from the outputs, anything a kept pass touches is needed by the passes before it
+        std::vector<bool> needed(_images.size(), false);
+        for (size_t i = 0; i < _images.size(); ++i)
+        {
+            needed[i] = _images[i].finalState != ImageState::Undefined;
+        }
+
+        std::vector<bool> keep(_passes.size(), false);
+        for (auto it = order.rbegin(); it != order.rend(); ++it)
+        {
+            const RenderGraphPass& pass = _passes[*it].info;
+            bool kept = pass.sideEffects || std::any_of(pass.writes.begin(), pass.writes.end(),
+                [&](const RenderGraphAccess& access) { return needed[access.image.index]; });
+            if (!kept)
+            {
+                continue;
+            }
+
+            keep[*it] = true;
+            for (const auto& access : pass.reads)
+            {
+                needed[access.image.index] = true;
+            }
+            for (const auto& access : pass.writes)
+            {
+                needed[access.image.index] = true;
+            }
+        }
+
+        std::erase_if(order, [&](const size_t pass) { return !keep[pass]; });
+    }
+
+    bool RenderGraph::PlanTransitions(const std::vector<size_t>& order)
+    {
+        constexpr size_t kUnused = ~size_t(0);
+        std::vector<ImageState> states(_images.size(), ImageState::Undefined);
+        std::vector<size_t> lastUse(_images.size(), kUnused);
+
+        _order.resize(order.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            CompiledPass& compiled = _order[i];
+            compiled.pass = order[i];
+            const Pass& pass = _passes[compiled.pass];
+
+            auto plan = [&](const RenderGraphAccess& access)
+            {
+                uint32_t image = access.image.index;
+                if (lastUse[image] == i)
+                {
+                    if (states[image] != access.state)
+                    {
+                        LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxRender, std::chrono::seconds(1),
+                            "Graph pass {} uses image {} in two different states",
+                            pass.name, _images[image].name);
+                        return false;
+                    }
+                    return true;
+                }
+
+                // The first use is always planned, the image's state before the graph runs isn't known until then.
+                // A transient image's memory was used by other images since, so it's aliased instead of trusting that state.
+                if (lastUse[image] == kUnused && _images[image].transient)
+                {
+                    compiled.aliases.push_back(access);
+                }
+                else if (lastUse[image] == kUnused || states[image] != access.state)
+                {
+                    compiled.before.push_back(access);
+                }
+                states[image] = access.state;
+                lastUse[image] = i;
+                return true;
+            };
+
+            for (const auto& access : pass.info.reads)
+            {
+                if (!plan(access)) return false;
+            }
+            for (const auto& access : pass.info.writes)
+            {
+                if (!plan(access)) return false;
+            }
+            _plannedTransitions += compiled.aliases.size() + compiled.before.size();
+        }
+
+        for (uint32_t image = 0; image < _images.size(); ++image)
+        {
+            ImageState finalState = _images[image].finalState;
+            if (lastUse[image] != kUnused && finalState != ImageState::Undefined && states[image] != finalState)
+            {
+                _order[lastUse[image]].after.push_back({ { image }, finalState });
+                ++_plannedTransitions;
+            }
+        }
+        return true;
+    }
+
+    bool RenderGraph::AllocateTransients()
+    {
+        // Images placed by the last compile have to go before the heap they're in is replaced
+        for (auto& image : _images)
+        {
+            image.buffer.reset();
+        }
+        _transientPlan = {};
+        _placedTransients.clear();
+
+        constexpr uint32_t kUnused = ~0u;
+        std::vector<uint32_t> firstUse(_images.size(), kUnused);
+        std::vector<uint32_t> lastUse(_images.size(), kUnused);
+        for (uint32_t i = 0; i < _order.size(); ++i)
+        {
+            const RenderGraphPass& pass = _passes[_order[i].pass].info;
+            for (const auto* accesses : { &pass.reads, &pass.writes })
+            {
+                for (const auto& access : *accesses)
+                {
+                    uint32_t image = access.image.index;
+                    firstUse[image] = std::min(firstUse[image], i);
+                    lastUse[image] = lastUse[image] == kUnused ? i : std::max(lastUse[image], i);
+                }
+            }
+        }
+
+        std::vector<uint32_t> images;
+        std::vector<TransientResource> resources;
+        for (uint32_t image = 0; image < _images.size(); ++image)
+        {
+            if (!_images[image].transient || firstUse[image] == kUnused)
+            {
+                continue;
+            }
+
+            if (!_transientAllocator)
+            {
+                LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxRender, std::chrono::seconds(1),
+                    "Graph image {} is transient but no transient allocator was set", _images[image].name);
+                return false;
+            }
+
+            resources::ImageMemoryRequirements requirements = _transientAllocator->GetRequirements(_images[image].desc);
+            images.push_back(image);
+            resources.push_back({ requirements.size, requirements.alignment, firstUse[image], lastUse[image] });
+        }
+
+        if (resources.empty())
+        {
+            return true;
+        }
+
+        _transientPlan = PlanTransientResources(resources);
+
+        // A heap big enough from an earlier compile is kept
+        if (_transientPlan.heapSize > _transientAllocator->GetHeapSize() && !_transientAllocator->Reserve(_transientPlan.heapSize))
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < images.size(); ++i)
+        {
+            Image& image = _images[images[i]];
+            image.buffer = _transientAllocator->CreateImage(image.desc, _transientPlan.offsets[i]);
+            if (!image.buffer)
+            {
+                LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxRender, std::chrono::seconds(1),
+                    "Failed to create transient graph image {}", image.name);
+                return false;
+            }
+        }
+
+        _placedTransients = std::move(images);
+        LUMI_LOG_INFO(debugging::LogGfxRender, "Placed {} transient images in {} bytes, {} bytes without aliasing",
+            _placedTransients.size(), _transientPlan.heapSize, _transientPlan.unaliasedSize);
+        return true;
+    }
+
+    uint64_t RenderGraph::HashStructure() const
+    {
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const uint64_t value)
+        {
+            hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+        };
+
+        mix(_images.size());
+        for (const auto& image : _images)
+        {
+            mix(image.transient);
+            mix(static_cast<uint64_t>(image.finalState));
+            if (image.transient)
+            {
+                mix(image.desc.width);
+                mix(image.desc.height);
+                mix(static_cast<uint64_t>(image.desc.format));
+                mix(static_cast<uint64_t>(image.desc.usage));
+            }
+        }
+
+        mix(_passes.size());
+        for (const auto& pass : _passes)
+        {
+            mix(std::hash<std::string_view>{}(pass.name));
+            mix(pass.info.sideEffects);
+            for (IRenderTarget* target : pass.info.targets)
+            {
+                mix(reinterpret_cast<uintptr_t>(target));
+                mix(static_cast<uint64_t>(target->GetWidth()));
+                mix(static_cast<uint64_t>(target->GetHeight()));
+            }
+            for (const auto* accesses : { &pass.info.reads, &pass.info.writes })
+            {
+                mix(accesses->size());
+                for (const auto& access : *accesses)
+                {
+                    mix(access.image.index);
+                    mix(static_cast<uint64_t>(access.state));
+                }
+            }
+        }
+        return hash;
+    }
+
+    void RenderGraph::SnapshotStructure()
+    {
+        _compiledImages.resize(_images.size());
+        for (size_t i = 0; i < _images.size(); ++i)
+        {
+            _compiledImages[i] = { _images[i].transient, _images[i].finalState, _images[i].desc };
+        }
+
+        _compiledPasses.resize(_passes.size());
+        for (size_t i = 0; i < _passes.size(); ++i)
+        {
+            const RenderGraphPass& info = _passes[i].info;
+            CompiledPassInfo& compiled = _compiledPasses[i];
+            compiled.name = _passes[i].name;
+            compiled.sideEffects = info.sideEffects;
+            compiled.targets = info.targets;
+            compiled.reads = info.reads;
+            compiled.writes = info.writes;
+        }
+    }
+
+    bool RenderGraph::MatchesCompiled() const
+    {
+        if (_images.size() != _compiledImages.size() || _passes.size() != _compiledPasses.size())
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < _images.size(); ++i)
+        {
+            const Image& image = _images[i];
+            const CompiledImage& compiled = _compiledImages[i];
+            if (image.transient != compiled.transient || image.finalState != compiled.finalState)
+            {
+                return false;
+            }
+            if (image.transient && (image.desc.width != compiled.desc.width || image.desc.height != compiled.desc.height
+                || image.desc.format != compiled.desc.format || image.desc.usage != compiled.desc.usage))
+            {
+                return false;
+            }
+        }
+
+        auto sameAccesses = [](const std::vector<RenderGraphAccess>& a, const std::vector<RenderGraphAccess>& b)
+        {
+            return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                [](const RenderGraphAccess& x, const RenderGraphAccess& y)
+                {
+                    return x.image.index == y.image.index && x.state == y.state;
+                });
+        };
+        for (size_t i = 0; i < _passes.size(); ++i)
+        {
+            const RenderGraphPass& info = _passes[i].info;
+            const CompiledPassInfo& compiled = _compiledPasses[i];
+            if (_passes[i].name != compiled.name || info.sideEffects != compiled.sideEffects
+                || info.targets != compiled.targets || !sameAccesses(info.reads, compiled.reads)
+                || !sameAccesses(info.writes, compiled.writes))
+            {
+                return false;
+            }
+        }
+
+        // The targets are the compiled ones, so their snapshot tells if any was resized since
+        return !TargetsResized();
+    }
+
+    void RenderGraph::SnapshotTargets()
+    {
+        _targetSizes.clear();
+        for (const auto& pass : _passes)
+        {
+            for (IRenderTarget* target : pass.info.targets)
+            {
+                auto it = std::find_if(_targetSizes.begin(), _targetSizes.end(),
+                    [&](const TargetSize& size) { return size.target == target; });
+                if (it == _targetSizes.end())
+                {
+                    _targetSizes.push_back({ target, target->GetWidth(), target->GetHeight() });
+                }
+            }
+        }
+    }
+
+    bool RenderGraph::TargetsResized() const
+    {
+        // Targets resize themselves when they start rendering, so comparing sizes catches what OutOfDate reported
+        for (const auto& size : _targetSizes)
+        {
+            if (size.target->GetWidth() != size.width || size.target->GetHeight() != size.height)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool RenderGraph::ReuseCompiled()
+    {
+        // Every image the compile placed has to come back, otherwise its passes would run without it
+        for (uint32_t image : _placedTransients)
+        {
+            if (image >= _retainedTransients.size() || !_retainedTransients[image])
+            {
+                return false;
+            }
+        }
+
+        _dirty = false;
+        for (size_t i = 0; i < _images.size() && i < _retainedTransients.size(); ++i)
+        {
+            if (_images[i].transient)
+            {
+                _images[i].buffer = std::move(_retainedTransients[i]);
+            }
+        }
+        _retainedTransients.clear();
+        SnapshotTargets();
+        ++_cacheHits;
+        return true;
+    }
+
+    void RenderGraph::BuildOrchestrator()
+    {
+        for (size_t i = 0; i < _order.size(); ++i)
+        {
+            const Pass& pass = _passes[_order[i].pass];
+
+            RenderPass compiled;
+            compiled.targets = pass.info.targets;
+            compiled.execute = [this, i](IRenderContext& ctx, IRenderTarget* target)
+            {
+                const CompiledPass& compiled = _order[i];
+                const RenderGraphPass& info = _passes[compiled.pass].info;
+
+                // Transient images are shared by the pass's targets, aliasing them again would discard what the
+                // pass wrote for the targets before
+                if (target == info.targets.front())
+                {
+                    for (const auto& access : compiled.aliases)
+                    {
+                        Alias(ctx, target, access);
+                    }
+                }
+                for (const auto& access : compiled.before)
+                {
+                    Transition(ctx, target, access);
+                }
+
+                const auto& execute = info.execute;
+                if (execute)
+                {
+                    execute(ctx, target);
+                }
+
+                for (const auto& access : compiled.after)
+                {
+                    Transition(ctx, target, access);
+                }
+            };
+            _orchestrator.NewPass(pass.name, std::move(compiled));
+        }
+    }
+
+    void RenderGraph::Transition(IRenderContext& ctx, IRenderTarget* target, const RenderGraphAccess& access) const
+    {
+        IImageBuffer* image = _images[access.image.index].resolver(ctx, target);
+        if (image && image->GetState() != access.state)
+        {
+            ctx.Transition(*image, access.state);
+        }
+    }
+
+    void RenderGraph::Alias(IRenderContext& ctx, IRenderTarget* target, const RenderGraphAccess& access) const
+    {
+        IImageBuffer* image = _images[access.image.index].resolver(ctx, target);
+        if (image)
+        {
+            ctx.Alias(*image, access.state);
+        }
+    }
+}
\ No newline at end of file
@@ -1,47 +1,193 @@
+#include <core/job_system.h>
 #include <gfx/render/render_context.h>
 #include <gfx/render/render_orchestrator.h>
 #include <debugging/logger.h>
+#include <debugging/profiler.h>
 
 namespace lumi::gfx::render
 {
-    void RenderOrchestrator::NewPass(const std::string& name, RenderPass& info)
+    /**
+     * Records the passes of each target as jobs on the job system.
+     * Every target is recorded by one thread at a time, so its command list only sees one writer.
+     */
+    class RenderOrchestrator::ParallelRecorder
     {
-        auto pass = GetPass(name);
-        if (pass)
+    public:
+        explicit ParallelRecorder(RenderContextFactory contextFactory)
+            : _contextFactory(std::move(contextFactory))
         {
-            debugging::Logger::Instance().LogError(
+        }
+
+        void Execute(std::vector<Pass>& passes, IRenderContext& ctx)
+        {
+            BuildTargets(passes);
+
+            // Every job thread gets its own context, the calling thread keeps recording with ctx
+            auto& jobs = core::JobSystem::Instance();
+            while (_contexts.size() < jobs.GetThreadCount())
+            {
+                _contexts.push_back(_contextFactory());
+            }
+            for (auto& context : _contexts)
+            {
+                context->SetFrameNumber(ctx.GetFrameNumber());
+            }
+
+            uint32_t caller = core::JobSystem::GetThreadIndex();
+            jobs.ParallelFor(_targetCount, 1, [&](const size_t begin, const size_t end)
+            {
+                uint32_t thread = core::JobSystem::GetThreadIndex();
+                IRenderContext& threadCtx = thread == caller ? ctx : *_contexts[thread];
+                for (size_t i = begin; i < end; ++i)
+                {
+                    Record(passes, _targets[i], threadCtx);
+                }
+            });
+        }
+    private:
+        struct TargetWork
+        {
+            IRenderTarget* target = nullptr;
+            /* Index of the target in each pass that renders to it, in pass order */
+            std::vector<std::pair<size_t, size_t>> passes;
+        };
+
+        RenderContextFactory _contextFactory;
+        /* Indexed by job thread */
+        std::vector<std::unique_ptr<IRenderContext>> _contexts;
+        std::vector<TargetWork> _targets;
+        size_t _targetCount = 0;
+
+        /* Groups the passes by target, reusing the vectors from the last frame */
+        void BuildTargets(const std::vector<Pass>& passes)
+        {
+            for (size_t i = 0; i < _targetCount; ++i)
+            {
+                _targets[i].passes.clear();
+            }
+            _targetCount = 0;
+
+            for (size_t pass = 0; pass < passes.size(); ++pass)
+            {
+                const auto& targets = passes[pass].info.targets;
+                for (size_t index = 0; index < targets.size(); ++index)
+                {
+                    auto it = std::find_if(_targets.begin(), _targets.begin() + _targetCount,
+                        [&](const TargetWork& work) { return work.target == targets[index]; });
+                    if (it == _targets.begin() + _targetCount)
+                    {
+                        if (_targetCount == _targets.size())
+                        {
+                            _targets.emplace_back();
+                        }
+                        it = _targets.begin() + _targetCount++;
+                        it->target = targets[index];
+                    }
+                    it->passes.emplace_back(pass, index);
+                }
+            }
+        }
+
+        static void Record(std::vector<Pass>& passes, const TargetWork& work, IRenderContext& ctx)
+        {
+            for (const auto& [pass, index] : work.passes)
+            {
+                auto& renderPass = passes[pass];
+                LUMI_PROFILE_ZONE(renderPass.name);
+                LUMI_PROFILE_ZONE_INDEX("Target", index);
+                ctx.SetRenderTarget(*work.target);
+                ctx.BeginTiming(renderPass.name);
+                renderPass.info.execute(ctx, work.target);
+                ctx.EndTiming();
+            }
+        }
+    };
+
+    RenderOrchestrator::RenderOrchestrator() = default;
+    RenderOrchestrator::~RenderOrchestrator() = default;
+    RenderOrchestrator::RenderOrchestrator(RenderOrchestrator&&) noexcept = default;
+    RenderOrchestrator& RenderOrchestrator::operator=(RenderOrchestrator&&) noexcept = default;
+
+    PassHandle RenderOrchestrator::NewPass(const std::string_view name, RenderPass info)
+    {
+        if (_passNames.Find(name).IsValid())
+        {
+            LUMI_LOG_ERROR_RATE_LIMITED(debugging::LogGfxRender, std::chrono::seconds(1),
                 "Attempted to add a pass called {} but one was already added!",
                 name
             );
-            delete pass;
-            return;
+            return {};
         }
-        _renderPasses.push_back({name, info});
+
+        core::InternedString interned = _passNames.Intern(name);
+        _renderPasses.push_back({ _passNames.GetString(interned), std::move(info) });
+        return { interned.id, _generation };
     }
 
     void RenderOrchestrator::Execute(IRenderContext& ctx)
+    {
+        LUMI_PROFILE_ZONE("RenderOrchestrator::Execute");
+        if (_parallel)
+        {
+            _parallel->Execute(_renderPasses, ctx);
+            return;
+        }
+        ExecuteSequential(ctx);
+    }
+
+    void RenderOrchestrator::SetParallelRecording(RenderContextFactory contextFactory)
+    {
+        _parallel.reset();
+        if (contextFactory)
+        {
+            _parallel = std::make_unique<ParallelRecorder>(std::move(contextFactory));
+        }
+    }
+
+    void RenderOrchestrator::ExecuteSequential(IRenderContext& ctx)
     {
         for (auto& pass : _renderPasses)
         {
-            for (const auto& target : pass.second.targets)
+            LUMI_PROFILE_ZONE(pass.name);
+            for (size_t i = 0; i < pass.info.targets.size(); ++i)
             {
+                IRenderTarget* target = pass.info.targets[i];
+                LUMI_PROFILE_ZONE_INDEX("Target", i);
                 ctx.SetRenderTarget(*target);
-                pass.second.execute(ctx, target);
+                ctx.BeginTiming(pass.name);
+                pass.info.execute(ctx, target);
+                ctx.EndTiming();
             }
         }
     }
 
-    RenderPass* RenderOrchestrator::GetPass(const std::string& name)
+    void RenderOrchestrator::Clear()
     {
-        auto it = std::find_if(_renderPasses.begin(), _renderPasses.end(), 
-            [&](Pass pass)
+        _renderPasses.clear();
+        _passNames.Clear();
+        ++_generation;
+    }
+
+    RenderPass* RenderOrchestrator::GetPass(const PassHandle handle)
+    {
+        if (!IsCurrent(handle))
         {
-            return pass.first == name;
-        });
-        if (it != _renderPasses.end())
+            return nullptr;
+        }
+        return &_renderPasses[handle.index].info;
+    }
+
+    PassHandle RenderOrchestrator::FindPass(const std::string_view name) const
+    {
+        return { _passNames.Find(name).id, _generation };
+    }
+
+    std::string_view RenderOrchestrator::GetPassName(const PassHandle handle) const
+    {
+        if (!IsCurrent(handle))
         {
-            return &(it->second);
+            return {};
         }
-        return nullptr;
+        return _passNames.GetString({ handle.index });
     }
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include <gfx/render/command_buffer.h>
+#include <gfx/render/render_context.h>
+#include <gfx/render/submission_queue.h>
+#include <debugging/profiler.h>
+
+namespace lumi::gfx::render
+{
+    void SubmissionQueue::Reserve(const size_t count)
+    {
+        _entries.reserve(count);
+        _scratch.reserve(count);
+        _functions.reserve(count);
+    }
+
+    void SubmissionQueue::Submit(const uint64_t key, SubmissionFunction function)
+    {
+        _entries.push_back({ key, static_cast<uint32_t>(_functions.size()) });
+        _functions.push_back(std::move(function));
+        _sorted = false;
+    }
+
+    void SubmissionQueue::Submit(const uint64_t key, const CommandBuffer& commands)
+    {
+        Submit(key, [&commands](IRenderContext& ctx) { ctx.Execute(commands); });
+    }
+
+    void SubmissionQueue::Sort()
+    {
+        if (_sorted)
+        {
+            return;
+        }
+        LUMI_PROFILE_ZONE("SubmissionQueue::Sort");
+
+        _scratch.resize(_entries.size());
+        core::RadixSort(_entries, _scratch);
+        _sorted = true;
+    }
+
+    void SubmissionQueue::Execute(IRenderContext& ctx)
+    {
+        Sort();
+        LUMI_PROFILE_ZONE("SubmissionQueue::Execute");
+        for (const auto& entry : _entries)
+        {
+            _functions[entry.index](ctx);
+        }
+    }
+
+    void SubmissionQueue::Clear()
+    {
+        _entries.clear();
+        _functions.clear();
+        _sorted = true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <numeric>
+#include <gfx/render/transient_planner.h>
+
+namespace lumi::gfx::render
+{
+    namespace
+    {
+        uint64_t AlignUp(const uint64_t value, const uint64_t alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        bool LifetimesOverlap(const TransientResource& a, const TransientResource& b)
+        {
+            return a.firstPass <= b.lastPass && b.firstPass <= a.lastPass;
+        }
+
+        struct Range
+        {
+            uint64_t begin;
+            uint64_t end;
+        };
+    }
+
+    TransientPlan PlanTransientResources(std::span<const TransientResource> resources)
+    {
+        TransientPlan plan;
+        plan.offsets.assign(resources.size(), 0);
+
+        // Big resources are the hardest to fit, placing them first leaves the gaps for the small ones
+        std::vector<size_t> order(resources.size());
+        std::iota(order.begin(), order.end(), size_t(0));
+        std::stable_sort(order.begin(), order.end(), [&](const size_t a, const size_t b)
+        {
+            return resources[a].size > resources[b].size;
+        });
+
+        std::vector<size_t> placed;
+        std::vector<Range> taken;
+        placed.reserve(resources.size());
+        for (size_t index : order)
+        {
+            const TransientResource& resource = resources[index];
+            uint64_t alignment = std::max<uint64_t>(resource.alignment, 1);
+
+            taken.clear();
+            for (size_t other : placed)
+            {
+                if (LifetimesOverlap(resource, resources[other]))
+                {
+                    taken.push_back({ plan.offsets[other], plan.offsets[other] + resources[other].size });
+                }
+            }
+            std::sort(taken.begin(), taken.end(), [](const Range& a, const Range& b) { return a.begin < b.begin; });
+
+            // First gap between the memory of live resources that's big enough
+            uint64_t offset = 0;
+            for (const Range& range : taken)
+            {
+                if (offset + resource.size <= range.begin)
+                {
+                    break;
+                }
+                offset = std::max(offset, AlignUp(range.end, alignment));
+            }
+
+            plan.offsets[index] = offset;
+            plan.heapSize = std::max(plan.heapSize, offset + resource.size);
+            plan.unaliasedSize += resource.size;
+            placed.push_back(index);
+        }
+
+        // Memory in use only changes when a lifetime starts, so checking those passes finds the peak
+        for (const TransientResource& resource : resources)
+        {
+            uint64_t live = 0;
+            for (const TransientResource& other : resources)
+            {
+                if (other.firstPass <= resource.firstPass && resource.firstPass <= other.lastPass)
+                {
+                    live += other.size;
+                }
+            }
+            plan.peakLiveSize = std::max(plan.peakLiveSize, live);
+        }
+        return plan;
+    }
+}
\ No newline at end of file
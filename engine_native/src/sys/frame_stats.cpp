@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <sys/frame_stats.h>
+
+namespace lumi::sys
+{
+    namespace
+    {
+        /* Values below this get a bucket each, above it every power of two is split into 8 buckets */
+        constexpr uint32_t kLinearBuckets = 16;
+        constexpr uint32_t kSubBucketBits = 3;
+
+        uint32_t ToMicros(const std::chrono::nanoseconds time)
+        {
+            auto micros = std::chrono::duration_cast<std::chrono::microseconds>(time).count();
+            return static_cast<uint32_t>(std::clamp<int64_t>(micros, 0, UINT32_MAX));
+        }
+
+        float ToMilliseconds(const uint32_t micros)
+        {
+            return static_cast<float>(micros) / 1000.0f;
+        }
+    }
+
+    FrameStats::FrameStats(std::span<const uint32_t> windows)
+    {
+        for (uint32_t frames : windows)
+        {
+            if (_windowCount == kMaxFrameStatsWindows)
+            {
+                break;
+            }
+
+            auto window = std::make_unique<Window>();
+            window->frames = std::max<uint32_t>(frames, 1);
+            _capacity = std::max(_capacity, window->frames);
+            _windows[_windowCount++] = std::move(window);
+        }
+
+        _capacity = std::max<uint32_t>(_capacity, 1);
+        for (auto& samples : _samples)
+        {
+            samples = std::make_unique<std::atomic<uint32_t>[]>(_capacity);
+        }
+    }
+
+    void FrameStats::Record(const FrameTimings& timings)
+    {
+        const std::array<uint32_t, kFrameMetricCount> values = {
+            ToMicros(timings.frame),
+            ToMicros(timings.cpuRecord),
+            ToMicros(timings.submit),
+            ToMicros(timings.presentWait)
+        };
+
+        uint64_t recorded = _recorded.load(std::memory_order_relaxed);
+        size_t slot = recorded % _capacity;
+        for (size_t metric = 0; metric < kFrameMetricCount; ++metric)
+        {
+            auto& samples = _samples[metric];
+            for (size_t i = 0; i < _windowCount; ++i)
+            {
+                Window& window = *_windows[i];
+                Histogram& histogram = window.histograms[metric];
+
+                // Remove the sample that just left this window before it's overwritten
+                if (recorded >= window.frames)
+                {
+                    uint32_t old = samples[(recorded - window.frames) % _capacity].load(std::memory_order_relaxed);
+                    histogram[GetBucket(old)].fetch_sub(1, std::memory_order_relaxed);
+                }
+                histogram[GetBucket(values[metric])].fetch_add(1, std::memory_order_relaxed);
+            }
+            samples[slot].store(values[metric], std::memory_order_relaxed);
+        }
+        _recorded.store(recorded + 1, std::memory_order_release);
+    }
+
+    size_t FrameStats::Snapshot(std::span<FrameStatsSnapshot> out) const
+    {
+        uint64_t recorded = _recorded.load(std::memory_order_acquire);
+        size_t count = std::min(out.size(), _windowCount);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Window& window = *_windows[i];
+            out[i].window = window.frames;
+            for (size_t metric = 0; metric < kFrameMetricCount; ++metric)
+            {
+                out[i].metrics[metric] = ComputePercentiles(window, metric, recorded);
+            }
+        }
+        return count;
+    }
+
+    std::vector<FrameStatsSnapshot> FrameStats::Snapshot() const
+    {
+        std::vector<FrameStatsSnapshot> snapshots(_windowCount);
+        Snapshot(snapshots);
+        return snapshots;
+    }
+
+    size_t FrameStats::GetBucket(const uint32_t micros)
+    {
+        if (micros < kLinearBuckets)
+        {
+            return micros;
+        }
+
+        uint32_t exponent = static_cast<uint32_t>(std::bit_width(micros)) - 1;
+        uint32_t subBucket = (micros >> (exponent - kSubBucketBits)) & ((1u << kSubBucketBits) - 1);
+        return kLinearBuckets + ((exponent - 4) << kSubBucketBits) + subBucket;
+    }
+
+    uint32_t FrameStats::GetBucketValue(const size_t bucket)
+    {
+        if (bucket < kLinearBuckets)
+        {
+            return static_cast<uint32_t>(bucket);
+        }
+
+        uint32_t exponent = static_cast<uint32_t>((bucket - kLinearBuckets) >> kSubBucketBits) + 4;
+        uint32_t subBucket = static_cast<uint32_t>(bucket - kLinearBuckets) & ((1u << kSubBucketBits) - 1);
+        uint64_t width = uint64_t(1) << (exponent - kSubBucketBits);
+        uint64_t lower = ((uint64_t(1) << kSubBucketBits) + subBucket) * width;
+        return static_cast<uint32_t>(std::min<uint64_t>(lower + width / 2, UINT32_MAX));
+    }
+
+    FramePercentiles FrameStats::ComputePercentiles(const Window& window, const size_t metric, const uint64_t recorded) const
+    {
+        FramePercentiles result;
+
+        // The exact max comes from the samples, the histogram only has to answer the percentiles
+        uint32_t frames = static_cast<uint32_t>(std::min<uint64_t>(recorded, window.frames));
+        uint32_t max = 0;
+        const auto& samples = _samples[metric];
+        for (uint32_t i = 1; i <= frames; ++i)
+        {
+            max = std::max(max, samples[(recorded - i) % _capacity].load(std::memory_order_relaxed));
+        }
+
+        std::array<uint32_t, kBucketCount> counts;
+        uint64_t total = 0;
+        for (size_t bucket = 0; bucket < kBucketCount; ++bucket)
+        {
+            counts[bucket] = window.histograms[metric][bucket].load(std::memory_order_relaxed);
+            total += counts[bucket];
+        }
+        if (total == 0)
+        {
+            return result;
+        }
+
+        auto percentile = [&](const double fraction)
+        {
+            auto rank = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(total)));
+            uint64_t seen = 0;
+            for (size_t bucket = 0; bucket < kBucketCount; ++bucket)
+            {
+                seen += counts[bucket];
+                if (seen >= rank)
+                {
+                    return ToMilliseconds(std::min(GetBucketValue(bucket), max));
+                }
+            }
+            return ToMilliseconds(max);
+        };
+
+        result.p50 = percentile(0.50);
+        result.p95 = percentile(0.95);
+        result.p99 = percentile(0.99);
+        result.max = ToMilliseconds(max);
+        result.count = frames;
+        return result;
+    }
+}
\ No newline at end of file
@@ -8,13 +8,13 @@ namespace lumi::sys
     {
         if (SDL_WasInit(SDL_INIT_VIDEO))
         {
-            debugging::Logger::Instance().LogWarn("SDL was already initialized, cannot start");
+            LUMI_LOG_WARN(debugging::LogSysWindow, "SDL was already initialized, cannot start");
             return false;
         }
 
         if (!SDL_Init(SDL_INIT_VIDEO))
         {
-            debugging::Logger::Instance().LogError("Failed to initialize SDL: {}", SDL_GetError());
+            LUMI_LOG_ERROR(debugging::LogSysWindow, "Failed to initialize SDL: {}", SDL_GetError());
             return false;
         }
         return true;
@@ -24,7 +24,7 @@ namespace lumi::sys
     {
         if (!SDL_WasInit(SDL_INIT_VIDEO))
         {
-            debugging::Logger::Instance().LogWarn("SDL isn't initialized, cannot close");
+            LUMI_LOG_WARN(debugging::LogSysWindow, "SDL isn't initialized, cannot close");
             return false;
         }
 
@@ -42,14 +42,14 @@ namespace lumi::sys
         // Ensure SDL is initialized before creating a window
         if (!SDL_WasInit(SDL_INIT_VIDEO))
         {
-            debugging::Logger::Instance().LogError("SDL must be initialized before creating windows");
+            LUMI_LOG_ERROR(debugging::LogSysWindow, "SDL must be initialized before creating windows");
             return false;
         }
 
         // Ensure window wasn't already created
         if (_handle)
         {
-            debugging::Logger::Instance().LogWarn("Window {} has already been created", GetID());
+            LUMI_LOG_WARN(debugging::LogSysWindow, "Window {} has already been created", GetID());
             return false;
         }
 
@@ -64,10 +64,16 @@ namespace lumi::sys
         // Ensure window creation was successful
         if (!_handle)
         {
-            debugging::Logger::Instance().LogError("Window creation failed: {}", SDL_GetError());
+            LUMI_LOG_ERROR(debugging::LogSysWindow, "Window creation failed: {}", SDL_GetError());
             return false;
         }
 
+        // The requested size is in screen coordinates, render targets need it in pixels
+        if (!SDL_GetWindowSizeInPixels(_handle, &_width, &_height))
+        {
+            LUMI_LOG_WARN(debugging::LogSysWindow, "Failed to get the size in pixels of window {}: {}", GetID(), SDL_GetError());
+        }
+
         // Assign properties that aren't included in SDL_CreateWindow
         Warp(properties.x, properties.y);
         SetBordered(properties.bordered);
@@ -90,9 +96,36 @@ namespace lumi::sys
         // Run window-specific events
         switch (event.type)
         {
+            case SDL_EVENT_WINDOW_RESIZED:
+            {
+                // Remember sizes the user drags to so going back to windowed restores them
+                if (_mode == WindowMode::Windowed)
+                {
+                    _w = event.window.data1;
+                    _h = event.window.data2;
+                }
+                break;
+            }
+            case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+            {
+                if (event.window.data1 == _width && event.window.data2 == _height)
+                {
+                    break;
+                }
+                _width = event.window.data1;
+                _height = event.window.data2;
+                Publish(WindowChange::Size);
+                break;
+            }
+            case SDL_EVENT_WINDOW_HDR_STATE_CHANGED:
+            {
+                Publish(WindowChange::Format);
+                break;
+            }
             case SDL_EVENT_WINDOW_DISPLAY_CHANGED:
             case SDL_EVENT_WINDOW_DISPLAY_SCALE_CHANGED:
             {
+                Publish(WindowChange::Display);
                 if (_mode != WindowMode::FullscreenBorderless)
                 {
                     break;
@@ -115,6 +148,37 @@ namespace lumi::sys
         }
     }
 
+    WindowSubscription Window::Subscribe(WindowChangeCallback callback)
+    {
+        WindowSubscription id = _nextSubscription++;
+        _subscribers.push_back({ id, std::move(callback) });
+        return id;
+    }
+
+    void Window::Unsubscribe(const WindowSubscription subscription)
+    {
+        auto it = std::find_if(_subscribers.begin(), _subscribers.end(),
+            [&](const Subscriber& subscriber) { return subscriber.id == subscription; });
+        if (it != _subscribers.end())
+        {
+            _subscribers.erase(it);
+        }
+    }
+
+    void Window::Publish(const WindowChange changes)
+    {
+        WindowChangeEvent event = {};
+        event.changes = changes;
+        event.generation = ++_generation;
+        event.width = _width;
+        event.height = _height;
+
+        for (auto& subscriber : _subscribers)
+        {
+            subscriber.callback(event);
+        }
+    }
+
     void Window::Warp(const int x, const int y)
     {
         _x = x;
@@ -167,7 +231,7 @@ namespace lumi::sys
         SDL_Surface* surface = SDL_LoadBMP(icon.c_str());
         if (!surface)
         {
-            debugging::Logger::Instance().LogError("Window {} failed to load window icon: {}", GetID(), SDL_GetError());
+            LUMI_LOG_ERROR(debugging::LogSysWindow, "Window {} failed to load window icon: {}", GetID(), SDL_GetError());
             return;
         }
 
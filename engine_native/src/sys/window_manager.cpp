@@ -2,6 +2,7 @@
 #include <unordered_map>
 #include <sys/window_manager.h>
 #include <debugging/logger.h>
+#include <debugging/profiler.h>
 
 namespace lumi::sys
 {
@@ -14,7 +15,7 @@ namespace lumi::sys
     {
         if (!Window::Start())
         {
-            debugging::Logger::Instance().LogError("Failed to start window service: {}", SDL_GetError());
+            LUMI_LOG_ERROR(debugging::LogSysWindow, "Failed to start window service: {}", SDL_GetError());
             return false;
         }
         return true;
@@ -25,7 +26,7 @@ namespace lumi::sys
         auto win = std::make_shared<Window>();
         if (!win->Init(properties))
         {
-            debugging::Logger::Instance().LogError("Failed to create window: {}", SDL_GetError());
+            LUMI_LOG_ERROR(debugging::LogSysWindow, "Failed to create window: {}", SDL_GetError());
             win.reset();
             return nullptr;
         }
@@ -35,6 +36,7 @@ namespace lumi::sys
 
     void WindowManager::Update()
     {
+        LUMI_PROFILE_ZONE("WindowManager::Update");
         SDL_Event e;
         while (SDL_PollEvent(&e))
         {
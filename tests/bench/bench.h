@@ -0,0 +1,127 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include <debugging/alloc_tracker.h>
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace lumi::bench
+{
+    /* Keeps the compiler from optimizing away a value or the work that produced it */
+    template<typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+        #ifdef _MSC_VER
+        static const volatile void* sink;
+        sink = &value;
+        _ReadWriteBarrier();
+        #else
+        asm volatile("" : : "g"(&value) : "memory");
+        #endif
+    }
+
+    /**
+     * \brief Times the loop of one benchmark sample
+     * \details Only the `for (auto _ : state)` loop is timed, so setup before it and teardown after it are free.
+     *          Heap allocations made by the benchmark's thread are counted over the same timed sections.
+     */
+    class BenchState
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        BenchState(uint64_t iterations, int64_t arg) : _iterations(iterations), _arg(arg) {}
+
+        /* The user-provided destructor keeps compilers from warning about the unused loop variable */
+        struct Value
+        {
+            ~Value() {}
+        };
+
+        struct Iterator
+        {
+            BenchState* state;
+            uint64_t remaining;
+
+            bool operator!=(const Iterator&)
+            {
+                if (remaining != 0)
+                {
+                    return true;
+                }
+                state->StopTimer();
+                return false;
+            }
+            Iterator& operator++() { --remaining; return *this; }
+            Value operator*() const { return {}; }
+        };
+
+        Iterator begin()
+        {
+            StartTimer();
+            return { this, _iterations };
+        }
+        Iterator end() { return { this, 0 }; }
+
+        /* Stops timing inside the loop, for per-iteration setup that shouldn't be measured */
+        void PauseTiming() { StopTimer(); }
+        void ResumeTiming() { StartTimer(); }
+
+        /* How many items (passes, messages, events...) each iteration processes */
+        void SetItemsPerIteration(const uint64_t items) { _itemsPerIteration = items; }
+
+        [[nodiscard]] int64_t GetArg() const { return _arg; }
+        [[nodiscard]] uint64_t GetIterations() const { return _iterations; }
+        [[nodiscard]] uint64_t GetItemsPerIteration() const { return _itemsPerIteration; }
+        [[nodiscard]] std::chrono::nanoseconds GetElapsed() const { return _elapsed; }
+        [[nodiscard]] uint64_t GetAllocations() const { return _allocations; }
+    private:
+        uint64_t _iterations;
+        int64_t _arg;
+        uint64_t _itemsPerIteration = 1;
+        Clock::time_point _start;
+        std::chrono::nanoseconds _elapsed{};
+        uint64_t _startAllocations = 0;
+        uint64_t _allocations = 0;
+        bool _running = false;
+
+        void StartTimer()
+        {
+            _running = true;
+            _startAllocations = debugging::AllocTracker::GetThreadStats().allocations;
+            _start = Clock::now();
+        }
+
+        void StopTimer()
+        {
+            if (_running)
+            {
+                _elapsed += Clock::now() - _start;
+                _allocations += debugging::AllocTracker::GetThreadStats().allocations - _startAllocations;
+                _running = false;
+            }
+        }
+    };
+
+    using BenchFunction = void(*)(BenchState&);
+
+    /**
+     * \brief Adds a benchmark to the suite
+     * \note Each argument registers a separate run named "name/arg", use LUMI_BENCHMARK instead of calling this
+     */
+    bool RegisterBenchmark(const char* name, BenchFunction function, std::initializer_list<int64_t> args = {});
+}
+
+#define LUMI_BENCH_CONCAT_INNER(a, b) a##b
+#define LUMI_BENCH_CONCAT(a, b) LUMI_BENCH_CONCAT_INNER(a, b)
+
+/* Registers function as a benchmark, optionally once for each argument given after it */
+#define LUMI_BENCHMARK(function, ...) \
+    static const bool LUMI_BENCH_CONCAT(lumiBenchRegistered, __LINE__) = \
+        ::lumi::bench::RegisterBenchmark(#function, function, { __VA_ARGS__ })
@@ -0,0 +1,332 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <debugging/alloc_tracker.h>
+#include <debugging/logger.h>
+#include "bench.h"
+
+/**
+ * lumi_bench [options]
+ *   --filter <text>      Only run benchmarks whose name contains text
+ *   --min-time <ms>      Time spent measuring each benchmark (default 500)
+ *   --samples <count>    Samples each benchmark's time is split into (default 10)
+ *   --json <path>        Writes the results as JSON
+ *   --baseline <path>    Compares against results previously written with --json
+ *   --threshold <pct>    Slowdown against the baseline counted as a regression (default 10)
+ *   --alloc-budget <n>   Heap allocations per iteration a benchmark may make before failing
+ *   --verbose            Keeps the engine's console log output
+ * Exits with 1 when a benchmark regressed against the baseline or went over the allocation budget.
+ */
+
+namespace lumi::bench
+{
+    namespace
+    {
+        struct BenchDefinition
+        {
+            std::string name;
+            BenchFunction function;
+            int64_t arg;
+        };
+
+        struct BenchResult
+        {
+            std::string name;
+            uint64_t iterations = 0;
+            uint32_t samples = 0;
+            double medianNs = 0.0;
+            double meanNs = 0.0;
+            double minNs = 0.0;
+            double maxNs = 0.0;
+            double stddevNs = 0.0;
+            double itemsPerSecond = 0.0;
+            double allocsPerIteration = 0.0;
+        };
+
+        struct BenchOptions
+        {
+            std::string filter;
+            double minTimeMs = 500.0;
+            uint32_t samples = 10;
+            std::string jsonPath;
+            std::string baselinePath;
+            double threshold = 10.0;
+            double allocBudget = -1.0;
+            bool verbose = false;
+        };
+
+        std::vector<BenchDefinition>& GetRegistry()
+        {
+            static std::vector<BenchDefinition> registry;
+            return registry;
+        }
+
+        double RunSample(const BenchDefinition& bench, const uint64_t iterations, uint64_t& itemsPerIteration,
+            uint64_t& allocations)
+        {
+            BenchState state(iterations, bench.arg);
+            bench.function(state);
+            itemsPerIteration = state.GetItemsPerIteration();
+            allocations = state.GetAllocations();
+            return static_cast<double>(state.GetElapsed().count()) / static_cast<double>(iterations);
+        }
+
+        BenchResult Run(const BenchDefinition& bench, const BenchOptions& options)
+        {
+            // Grow the iteration count until a sample is long enough to time reliably
+            double sampleNs = options.minTimeMs * 1e6 / options.samples;
+            uint64_t iterations = 1;
+            uint64_t itemsPerIteration = 1;
+            uint64_t allocations = 0;
+            while (true)
+            {
+                double nsPerIteration = RunSample(bench, iterations, itemsPerIteration, allocations);
+                double elapsed = nsPerIteration * static_cast<double>(iterations);
+                if (elapsed >= sampleNs || iterations >= (uint64_t(1) << 40))
+                {
+                    break;
+                }
+
+                double scale = elapsed > 0.0 ? sampleNs / elapsed * 1.2 : 10.0;
+                iterations = static_cast<uint64_t>(static_cast<double>(iterations) * std::clamp(scale, 2.0, 10.0));
+            }
+
+            std::vector<double> times(options.samples);
+            uint64_t totalAllocations = 0;
+            for (auto& time : times)
+            {
+                time = RunSample(bench, iterations, itemsPerIteration, allocations);
+                totalAllocations += allocations;
+            }
+            std::sort(times.begin(), times.end());
+
+            BenchResult result;
+            result.name = bench.name;
+            result.iterations = iterations;
+            result.samples = options.samples;
+            result.minNs = times.front();
+            result.maxNs = times.back();
+            result.medianNs = times.size() % 2 == 1
+                ? times[times.size() / 2]
+                : (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2.0;
+
+            for (double time : times)
+            {
+                result.meanNs += time;
+            }
+            result.meanNs /= static_cast<double>(times.size());
+            for (double time : times)
+            {
+                result.stddevNs += (time - result.meanNs) * (time - result.meanNs);
+            }
+            result.stddevNs = std::sqrt(result.stddevNs / static_cast<double>(times.size()));
+            result.itemsPerSecond = result.medianNs > 0.0
+                ? static_cast<double>(itemsPerIteration) * 1e9 / result.medianNs
+                : 0.0;
+            result.allocsPerIteration = static_cast<double>(totalAllocations)
+                / static_cast<double>(iterations * options.samples);
+            return result;
+        }
+
+        std::string FormatTime(const double ns)
+        {
+            char buffer[32];
+            if (ns < 1e3) std::snprintf(buffer, sizeof(buffer), "%.2f ns", ns);
+            else if (ns < 1e6) std::snprintf(buffer, sizeof(buffer), "%.2f us", ns / 1e3);
+            else std::snprintf(buffer, sizeof(buffer), "%.2f ms", ns / 1e6);
+            return buffer;
+        }
+
+        bool WriteJson(const std::string& path, const std::vector<BenchResult>& results)
+        {
+            std::ofstream file(path, std::ios::trunc);
+            if (!file)
+            {
+                return false;
+            }
+
+            #ifdef NDEBUG
+            const char* build = "release";
+            #else
+            const char* build = "debug";
+            #endif
+
+            // One benchmark per line keeps baselines easy to diff and to read back
+            file << "{\n  \"context\": {\"build\": \"" << build << "\"},\n  \"benchmarks\": [\n";
+            for (size_t i = 0; i < results.size(); ++i)
+            {
+                const BenchResult& result = results[i];
+                char line[640];
+                std::snprintf(line, sizeof(line),
+                    "    {\"name\": \"%s\", \"iterations\": %llu, \"samples\": %u, \"median_ns\": %.3f, \"mean_ns\": %.3f, "
+                    "\"min_ns\": %.3f, \"max_ns\": %.3f, \"stddev_ns\": %.3f, \"items_per_second\": %.1f, "
+                    "\"allocs_per_iteration\": %.3f}%s\n",
+                    result.name.c_str(), static_cast<unsigned long long>(result.iterations), result.samples,
+                    result.medianNs, result.meanNs, result.minNs, result.maxNs, result.stddevNs, result.itemsPerSecond,
+                    result.allocsPerIteration, i + 1 < results.size() ? "," : "");
+                file << line;
+            }
+            file << "  ]\n}\n";
+            return static_cast<bool>(file);
+        }
+
+        /* Reads the median of every benchmark in a file written by WriteJson */
+        bool ReadBaseline(const std::string& path, std::map<std::string, double>& baseline)
+        {
+            std::ifstream file(path);
+            if (!file)
+            {
+                return false;
+            }
+
+            std::string line;
+            while (std::getline(file, line))
+            {
+                constexpr std::string_view nameKey = "\"name\": \"";
+                constexpr std::string_view medianKey = "\"median_ns\": ";
+
+                size_t name = line.find(nameKey);
+                size_t median = line.find(medianKey);
+                if (name == std::string::npos || median == std::string::npos)
+                {
+                    continue;
+                }
+
+                name += nameKey.size();
+                size_t nameEnd = line.find('"', name);
+                baseline[line.substr(name, nameEnd - name)] = std::strtod(line.c_str() + median + medianKey.size(), nullptr);
+            }
+            return true;
+        }
+
+        bool ParseOptions(int argc, char** argv, BenchOptions& options)
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                std::string_view arg = argv[i];
+                bool hasValue = i + 1 < argc;
+                if (arg == "--filter" && hasValue) options.filter = argv[++i];
+                else if (arg == "--min-time" && hasValue) options.minTimeMs = std::max(std::atof(argv[++i]), 1.0);
+                else if (arg == "--samples" && hasValue) options.samples = std::max(std::atoi(argv[++i]), 1);
+                else if (arg == "--json" && hasValue) options.jsonPath = argv[++i];
+                else if (arg == "--baseline" && hasValue) options.baselinePath = argv[++i];
+                else if (arg == "--threshold" && hasValue) options.threshold = std::atof(argv[++i]);
+                else if (arg == "--alloc-budget" && hasValue) options.allocBudget = std::atof(argv[++i]);
+                else if (arg == "--verbose") options.verbose = true;
+                else
+                {
+                    std::fprintf(stderr, "Unknown or incomplete option %s\n", argv[i]);
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    bool RegisterBenchmark(const char* name, BenchFunction function, std::initializer_list<int64_t> args)
+    {
+        if (args.size() == 0)
+        {
+            GetRegistry().push_back({ name, function, 0 });
+            return true;
+        }
+
+        for (int64_t arg : args)
+        {
+            GetRegistry().push_back({ std::string(name) + "/" + std::to_string(arg), function, arg });
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace lumi::bench;
+
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        return 2;
+    }
+
+    // Engine log output would be timed along with the benchmarks and drown out the results
+    if (!options.verbose)
+    {
+        lumi::debugging::Logger::Instance().ClearSinks();
+    }
+
+    std::map<std::string, double> baseline;
+    if (!options.baselinePath.empty() && !ReadBaseline(options.baselinePath, baseline))
+    {
+        std::fprintf(stderr, "Failed to read baseline %s\n", options.baselinePath.c_str());
+        return 2;
+    }
+
+    std::printf("%-48s %12s %12s %9s %14s %10s %10s\n",
+        "Benchmark", "Median", "Min", "Stddev", "Items/s", "Allocs/it", "Baseline");
+
+    std::vector<BenchResult> results;
+    uint32_t regressions = 0;
+    uint32_t overBudget = 0;
+    for (const auto& bench : GetRegistry())
+    {
+        if (!options.filter.empty() && bench.name.find(options.filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        BenchResult result = Run(bench, options);
+        results.push_back(result);
+
+        std::string comparison = "-";
+        auto it = baseline.find(result.name);
+        if (it != baseline.end() && it->second > 0.0)
+        {
+            double change = (result.medianNs - it->second) / it->second * 100.0;
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%+.1f%%", change);
+            comparison = buffer;
+            if (change > options.threshold)
+            {
+                comparison += " !";
+                ++regressions;
+            }
+        }
+
+        // The hooks are linked into lumi_bench, but report nothing if a platform build leaves them out
+        char allocs[32] = "-";
+        if (lumi::debugging::AllocTracker::IsHooked())
+        {
+            bool exceeded = options.allocBudget >= 0.0 && result.allocsPerIteration > options.allocBudget;
+            std::snprintf(allocs, sizeof(allocs), "%.2f%s", result.allocsPerIteration, exceeded ? " !" : "");
+            overBudget += exceeded ? 1 : 0;
+        }
+
+        double stddevPercent = result.medianNs > 0.0 ? result.stddevNs / result.meanNs * 100.0 : 0.0;
+        std::printf("%-48s %12s %12s %8.1f%% %14.0f %10s %10s\n",
+            result.name.c_str(), FormatTime(result.medianNs).c_str(), FormatTime(result.minNs).c_str(),
+            stddevPercent, result.itemsPerSecond, allocs, comparison.c_str());
+        std::fflush(stdout);
+    }
+
+    if (!options.jsonPath.empty() && !WriteJson(options.jsonPath, results))
+    {
+        std::fprintf(stderr, "Failed to write %s\n", options.jsonPath.c_str());
+        return 2;
+    }
+
+    if (regressions > 0)
+    {
+        std::printf("%u benchmark(s) regressed by more than %.1f%%\n", regressions, options.threshold);
+    }
+    if (overBudget > 0)
+    {
+        std::printf("%u benchmark(s) made more than %.2f allocations per iteration\n", overBudget, options.allocBudget);
+    }
+    return regressions > 0 || overBudget > 0 ? 1 : 0;
+}
\ No newline at end of file
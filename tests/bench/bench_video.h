@@ -0,0 +1,41 @@
+#pragma once
+
+#include <sys/window_manager.h>
+
+namespace lumi::bench
+{
+    /**
+     * \brief Starts SDL's video service once for every benchmark that needs windows
+     * \note The dummy video driver is used unless SDL_VIDEO_DRIVER is set, so no display is needed
+     *
+     * \return true The video service is running
+     * \return false SDL failed to start
+     */
+    inline bool StartBenchVideo()
+    {
+        static const bool started = []
+        {
+            SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+            return sys::WindowManager::Init();
+        }();
+        return started;
+    }
+
+    inline sys::WindowProperties GetBenchWindowProperties()
+    {
+        sys::WindowProperties props = {};
+        props.title = "lumi_bench";
+        props.x = 0;
+        props.y = 0;
+        props.w = 640;
+        props.h = 480;
+        props.wMin = 320;
+        props.wMax = 1920;
+        props.hMin = 240;
+        props.hMax = 1080;
+        props.mode = sys::WindowMode::Windowed;
+        props.resizable = true;
+        props.bordered = true;
+        return props;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include <vector>
+#include <sys_c/frame_stats.h>
+#include <sys_c/window.h>
+#include <sys_c/window_manager.h>
+#include <sys/window_manager.h>
+#include "bench.h"
+#include "bench_video.h"
+
+namespace lumi::bench
+{
+    namespace
+    {
+        /* A window made through the C API, the video service is shared with the native benchmarks */
+        struct GlueWindowFixture
+        {
+            // window_manager_create also starts the video service, which the native benchmarks may have done already
+            sys::WindowManager native;
+            ::WindowManager* windowManager = reinterpret_cast<::WindowManager*>(&native);
+            ::Window* window = nullptr;
+
+            GlueWindowFixture()
+            {
+                if (!StartBenchVideo())
+                {
+                    return;
+                }
+
+                WindowProperties props = {};
+                std::snprintf(props.title, sizeof(props.title), "lumi_bench");
+                props.w = 640;
+                props.h = 480;
+                props.wMin = 320;
+                props.wMax = 1920;
+                props.hMin = 240;
+                props.hMax = 1080;
+                props.resizable = 1;
+                props.bordered = 1;
+                window = window_manager_create_window(windowManager, props);
+            }
+        };
+
+        void BM_GlueWindowClosing(BenchState& state)
+        {
+            GlueWindowFixture fixture;
+            if (!fixture.window)
+            {
+                return;
+            }
+
+            for (auto _ : state)
+            {
+                DoNotOptimize(window_closing(fixture.window));
+            }
+        }
+        LUMI_BENCHMARK(BM_GlueWindowClosing);
+
+        /* The same query without crossing the C API, to isolate the cost of the call */
+        void BM_NativeWindowClosing(BenchState& state)
+        {
+            GlueWindowFixture fixture;
+            if (!fixture.window)
+            {
+                return;
+            }
+
+            auto* window = reinterpret_cast<sys::Window*>(fixture.window);
+            for (auto _ : state)
+            {
+                DoNotOptimize(window->Closing());
+            }
+        }
+        LUMI_BENCHMARK(BM_NativeWindowClosing);
+
+        void BM_GlueWindowManagerUpdate(BenchState& state)
+        {
+            GlueWindowFixture fixture;
+            if (!fixture.window)
+            {
+                return;
+            }
+
+            for (auto _ : state)
+            {
+                window_manager_update(fixture.windowManager);
+            }
+        }
+        LUMI_BENCHMARK(BM_GlueWindowManagerUpdate);
+
+        /* Recording frame samples through the C API in batches of arg */
+        void BM_GlueFrameStatsRecord(BenchState& state)
+        {
+            FrameStats* stats = frame_stats_create(nullptr, 0);
+            std::vector<FrameStatsSample> samples(static_cast<size_t>(state.GetArg()), { 16.6f, 4.0f, 0.5f, 11.0f });
+
+            state.SetItemsPerIteration(samples.size());
+            for (auto _ : state)
+            {
+                frame_stats_record(stats, samples.data(), static_cast<uint32_t>(samples.size()));
+            }
+            frame_stats_destroy(stats);
+        }
+        LUMI_BENCHMARK(BM_GlueFrameStatsRecord, 1, 64);
+
+        void BM_GlueFrameStatsSnapshot(BenchState& state)
+        {
+            FrameStats* stats = frame_stats_create(nullptr, 0);
+            std::vector<FrameStatsSample> samples(1000, { 16.6f, 4.0f, 0.5f, 11.0f });
+            frame_stats_record(stats, samples.data(), static_cast<uint32_t>(samples.size()));
+
+            FrameStatsSnapshot snapshots[4];
+            for (auto _ : state)
+            {
+                DoNotOptimize(frame_stats_snapshot(stats, snapshots, 4));
+            }
+            frame_stats_destroy(stats);
+        }
+        LUMI_BENCHMARK(BM_GlueFrameStatsSnapshot);
+    }
+}
\ No newline at end of file
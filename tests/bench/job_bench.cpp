@@ -0,0 +1,110 @@
+#include <atomic>
+#include <vector>
+#include <core/job_system.h>
+#include "bench.h"
+
+namespace lumi::bench
+{
+    namespace
+    {
+        using core::JobCounter;
+        using core::JobSystem;
+
+        /* Runs the job system with arg workers for one benchmark */
+        struct JobFixture
+        {
+            explicit JobFixture(const BenchState& state)
+            {
+                JobSystem::Instance().Start(static_cast<uint32_t>(state.GetArg()));
+            }
+
+            ~JobFixture()
+            {
+                JobSystem::Instance().Stop();
+            }
+        };
+
+        /* Work sized like a small recording or culling job */
+        void SimulateWork(const size_t seed)
+        {
+            uint64_t value = seed;
+            for (uint32_t i = 0; i < 2000; ++i)
+            {
+                value = value * 6364136223846793005ull + i;
+                DoNotOptimize(value);
+            }
+        }
+
+        /* 1024 items split into chunks of 16, the argument is the number of worker threads */
+        void BM_JobParallelFor(BenchState& state)
+        {
+            JobFixture fixture(state);
+            constexpr size_t kItems = 1024;
+
+            state.SetItemsPerIteration(kItems);
+            for (auto _ : state)
+            {
+                JobSystem::Instance().ParallelFor(kItems, 16, [](const size_t begin, const size_t end)
+                {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        SimulateWork(i);
+                    }
+                });
+            }
+        }
+        LUMI_BENCHMARK(BM_JobParallelFor, 0, 1, 3, 7, 15);
+
+        /* Many tiny jobs, measures the cost of queueing, stealing and counting rather than the work */
+        void BM_JobRunWait(BenchState& state)
+        {
+            JobFixture fixture(state);
+            constexpr size_t kJobs = 256;
+            std::atomic<uint64_t> done = 0;
+
+            state.SetItemsPerIteration(kJobs);
+            for (auto _ : state)
+            {
+                JobCounter counter;
+                for (size_t i = 0; i < kJobs; ++i)
+                {
+                    JobSystem::Instance().Run([&done] { done.fetch_add(1, std::memory_order_relaxed); }, &counter);
+                }
+                JobSystem::Instance().Wait(counter);
+            }
+            DoNotOptimize(done.load());
+        }
+        LUMI_BENCHMARK(BM_JobRunWait, 0, 1, 3, 7, 15);
+
+        /* Waves of jobs where each wave starts after the one before it, like passes depending on each other */
+        void BM_JobDependencies(BenchState& state)
+        {
+            JobFixture fixture(state);
+            constexpr size_t kWaves = 8;
+            constexpr size_t kJobsPerWave = 32;
+            std::vector<JobCounter> waves(kWaves);
+
+            state.SetItemsPerIteration(kWaves * kJobsPerWave);
+            for (auto _ : state)
+            {
+                for (size_t wave = 0; wave < kWaves; ++wave)
+                {
+                    for (size_t i = 0; i < kJobsPerWave; ++i)
+                    {
+                        auto work = [i] { SimulateWork(i); };
+                        if (wave == 0)
+                        {
+                            JobSystem::Instance().Run(work, &waves[wave]);
+                        }
+                        else
+                        {
+                            JobSystem::Instance().RunAfter(waves[wave - 1], work, &waves[wave]);
+                        }
+                    }
+                }
+                JobSystem::Instance().Wait(waves.back());
+            }
+        }
+        LUMI_BENCHMARK(BM_JobDependencies, 0, 1, 3, 7, 15);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include <atomic>
+#include <memory>
+#include <debugging/logger.h>
+#include "bench.h"
+
+namespace lumi::bench
+{
+    namespace
+    {
+        using debugging::Logger;
+        using debugging::LogType;
+
+        /* Receives messages without doing any I/O, so only the logger itself is measured */
+        class NullLogSink : public debugging::ILogSink
+        {
+        public:
+            explicit NullLogSink(const bool needsText) : _needsText(needsText) {}
+
+            void Write(const debugging::LogMessage& message) override
+            {
+                _written.fetch_add(1, std::memory_order_relaxed);
+                DoNotOptimize(message.text.size());
+            }
+            void Flush() override {}
+            [[nodiscard]] bool NeedsText() const override { return _needsText; }
+        private:
+            bool _needsText;
+            std::atomic<uint64_t> _written = 0;
+        };
+
+        /* Swaps the logger's sinks and modes for a benchmark and puts the defaults back after */
+        struct LoggerFixture
+        {
+            LoggerFixture(const bool deferred, const bool needsText)
+            {
+                Logger::Instance().ClearSinks();
+                Logger::Instance().AddSink(std::make_shared<NullLogSink>(needsText));
+                Logger::Instance().SetDeferredFormatting(deferred);
+            }
+
+            ~LoggerFixture()
+            {
+                Logger::Instance().StopAsync();
+                Logger::Instance().SetDeferredFormatting(false);
+                Logger::Instance().SetCategoryLevel("core", LogType::Info);
+                Logger::Instance().ClearSinks();
+            }
+        };
+
+        // Benchmarks log warnings since release builds compile info messages out
+        void BM_LoggerFormatted(BenchState& state)
+        {
+            LoggerFixture fixture(false, true);
+            int frame = 0;
+            for (auto _ : state)
+            {
+                LUMI_LOG_WARN(debugging::LogCore, "Frame {} took {}ms on target {}", frame++, 16.6f, "main");
+            }
+        }
+        LUMI_BENCHMARK(BM_LoggerFormatted);
+
+        /* Deferred records formatted for a text sink on the logging thread */
+        void BM_LoggerDeferredText(BenchState& state)
+        {
+            LoggerFixture fixture(true, true);
+            int frame = 0;
+            for (auto _ : state)
+            {
+                LUMI_LOG_WARN(debugging::LogCore, "Frame {} took {}ms on target {}", frame++, 16.6f, "main");
+            }
+        }
+        LUMI_BENCHMARK(BM_LoggerDeferredText);
+
+        /* Deferred records that are never formatted because the only sink is binary */
+        void BM_LoggerDeferredBinary(BenchState& state)
+        {
+            LoggerFixture fixture(true, false);
+            int frame = 0;
+            for (auto _ : state)
+            {
+                LUMI_LOG_WARN(debugging::LogCore, "Frame {} took {}ms on target {}", frame++, 16.6f, "main");
+            }
+        }
+        LUMI_BENCHMARK(BM_LoggerDeferredBinary);
+
+        /* Producer cost with the background thread formatting and writing, arg is 0 for eager and 1 for deferred */
+        void BM_LoggerAsync(BenchState& state)
+        {
+            LoggerFixture fixture(state.GetArg() != 0, true);
+
+            debugging::AsyncLogConfig config;
+            config.memoryBudget = 16 * 1024 * 1024;
+            config.overflowPolicy = debugging::LogOverflowPolicy::Drop;
+            Logger::Instance().StartAsync(config);
+
+            int frame = 0;
+            for (auto _ : state)
+            {
+                LUMI_LOG_WARN(debugging::LogCore, "Frame {} took {}ms on target {}", frame++, 16.6f, "main");
+            }
+        }
+        LUMI_BENCHMARK(BM_LoggerAsync, 0, 1);
+
+        /* A call below the category's level, which should return before touching its arguments */
+        void BM_LoggerFiltered(BenchState& state)
+        {
+            LoggerFixture fixture(false, true);
+            Logger::Instance().SetCategoryLevel("core", LogType::Error);
+            int frame = 0;
+            for (auto _ : state)
+            {
+                LUMI_LOG_WARN(debugging::LogCore, "Frame {} took {}ms on target {}", frame++, 16.6f, "main");
+            }
+        }
+        LUMI_BENCHMARK(BM_LoggerFiltered);
+
+        /* Repeats of the same message suppressed by the call site's limiter */
+        void BM_LoggerRateLimited(BenchState& state)
+        {
+            LoggerFixture fixture(false, true);
+            for (auto _ : state)
+            {
+                LUMI_LOG_WARN_RATE_LIMITED(debugging::LogCore, std::chrono::seconds(10), "Target {} is out of date", 1);
+            }
+        }
+        LUMI_BENCHMARK(BM_LoggerRateLimited);
+    }
+}
\ No newline at end of file
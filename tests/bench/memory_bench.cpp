@@ -0,0 +1,83 @@
+#include <memory_resource>
+#include <vector>
+#include <core/frame_arena.h>
+#include "bench.h"
+
+namespace lumi::bench
+{
+    namespace
+    {
+        /* Per-draw transient data, about the size of a small constant block */
+        struct DrawData
+        {
+            float transform[16];
+            uint32_t material;
+        };
+
+        /* Lists of draw data as a frame would build them with the heap, the argument is the number of lists */
+        void BM_HeapTransientLists(BenchState& state)
+        {
+            const auto lists = static_cast<size_t>(state.GetArg());
+
+            state.SetItemsPerIteration(lists);
+            for (auto _ : state)
+            {
+                for (size_t i = 0; i < lists; ++i)
+                {
+                    std::vector<DrawData> draws(8 + i % 8);
+                    draws[0].material = static_cast<uint32_t>(i);
+                    DoNotOptimize(draws.data());
+                }
+            }
+        }
+        LUMI_BENCHMARK(BM_HeapTransientLists, 64, 1024);
+
+        /* The same lists from a frame arena reset every iteration, steady state shouldn't allocate */
+        void BM_ArenaTransientLists(BenchState& state)
+        {
+            const auto lists = static_cast<size_t>(state.GetArg());
+            core::FrameArena arenas;
+            arenas.SetFrameCount(2);
+            uint32_t frame = 0;
+
+            state.SetItemsPerIteration(lists);
+            for (auto _ : state)
+            {
+                frame = (frame + 1) % arenas.GetFrameCount();
+                arenas.BeginFrame(frame);
+                auto& arena = arenas.Get(frame);
+                for (size_t i = 0; i < lists; ++i)
+                {
+                    auto draws = arena.AllocateSpan<DrawData>(8 + i % 8);
+                    draws[0].material = static_cast<uint32_t>(i);
+                    DoNotOptimize(draws.data());
+                }
+            }
+        }
+        LUMI_BENCHMARK(BM_ArenaTransientLists, 64, 1024);
+
+        /* Growing standard containers through the arena's memory resource */
+        void BM_ArenaPmrVector(BenchState& state)
+        {
+            const auto lists = static_cast<size_t>(state.GetArg());
+            core::LinearArena arena;
+            core::ArenaResource resource(arena);
+
+            state.SetItemsPerIteration(lists);
+            for (auto _ : state)
+            {
+                arena.Reset();
+                for (size_t i = 0; i < lists; ++i)
+                {
+                    std::pmr::vector<uint32_t> indices(&resource);
+                    for (uint32_t j = 0; j < 16; ++j)
+                    {
+                        indices.push_back(j);
+                    }
+                    DoNotOptimize(indices.data());
+                }
+            }
+        }
+        LUMI_BENCHMARK(BM_ArenaPmrVector, 64, 1024);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,434 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include <core/job_system.h>
+#include <gfx/backends/null/null_device.h>
+#include <gfx/backends/null/null_render_target.h>
+#include <gfx/backends/null/render/null_render_context.h>
+#include <gfx/backends/null/resources/null_image_buffer.h>
+#include <gfx/render/recording_render_context.h>
+#include <gfx/render/render_graph.h>
+#include <gfx/render/transient_planner.h>
+#include <gfx/render/render_orchestrator.h>
+#include "bench.h"
+
+namespace lumi::bench
+{
+    namespace
+    {
+        namespace render = gfx::render;
+
+        constexpr uint32_t kTargetCount = 16;
+        constexpr uint32_t kTargetsPerPass = 4;
+
+        /* A null device with targets and an orchestrator holding passCount passes */
+        struct RenderFixture
+        {
+            gfx::null::NullDevice device;
+            std::vector<std::unique_ptr<gfx::null::NullRenderTarget>> targets;
+            gfx::null::render::NullRenderContext context{device};
+            render::RenderOrchestrator orchestrator;
+            std::vector<std::string> names;
+            std::vector<render::PassHandle> handles;
+
+            explicit RenderFixture(const int64_t passCount)
+            {
+                gfx::null::NullDeviceConfig config;
+                config.logValidationErrors = false;
+                device.SetConfig(config);
+                device.Init();
+
+                for (uint32_t i = 0; i < kTargetCount; ++i)
+                {
+                    auto target = std::make_unique<gfx::null::NullRenderTarget>(device, 1280, 720);
+                    target->Init(1);
+                    target->StartRendering(0);
+                    targets.push_back(std::move(target));
+                }
+
+                for (int64_t i = 0; i < passCount; ++i)
+                {
+                    render::RenderPass pass;
+                    for (uint32_t t = 0; t < kTargetsPerPass; ++t)
+                    {
+                        pass.targets.push_back(targets[(i + t) % kTargetCount].get());
+                    }
+                    pass.execute = [](render::IRenderContext& ctx, gfx::IRenderTarget* target)
+                    {
+                        render::RenderColorInfo color = {};
+                        color.image = target->GetColorBuffer(0).get();
+
+                        render::RenderInfo info;
+                        info.color = { color };
+                        ctx.BeginRecording(info);
+                        ctx.EndRecording(info);
+                    };
+
+                    names.push_back("pass_" + std::to_string(i));
+                    handles.push_back(orchestrator.NewPass(names.back(), std::move(pass)));
+                }
+            }
+        };
+
+        void BM_OrchestratorExecute(BenchState& state)
+        {
+            RenderFixture fixture(state.GetArg());
+            state.SetItemsPerIteration(static_cast<uint64_t>(state.GetArg()) * kTargetsPerPass);
+            for (auto _ : state)
+            {
+                fixture.orchestrator.Execute(fixture.context);
+            }
+        }
+        LUMI_BENCHMARK(BM_OrchestratorExecute, 10, 100, 500);
+
+        /* Passes that do nothing but count, so only calling into each pass is measured */
+        void BM_OrchestratorDispatch(BenchState& state)
+        {
+            RenderFixture fixture(0);
+            uint64_t calls = 0;
+            for (int64_t i = 0; i < state.GetArg(); ++i)
+            {
+                std::vector<gfx::IRenderTarget*> targets;
+                for (uint32_t t = 0; t < kTargetsPerPass; ++t)
+                {
+                    targets.push_back(fixture.targets[(i + t) % kTargetCount].get());
+                }
+                fixture.orchestrator.NewPass("pass_" + std::to_string(i), std::move(targets),
+                    [&calls](render::IRenderContext&, gfx::IRenderTarget*) { ++calls; });
+            }
+
+            state.SetItemsPerIteration(static_cast<uint64_t>(state.GetArg()) * kTargetsPerPass);
+            for (auto _ : state)
+            {
+                fixture.orchestrator.Execute(fixture.context);
+            }
+            DoNotOptimize(calls);
+        }
+        LUMI_BENCHMARK(BM_OrchestratorDispatch, 10, 100, 500);
+
+        void BM_OrchestratorGetPass(BenchState& state)
+        {
+            RenderFixture fixture(state.GetArg());
+            size_t next = 0;
+            for (auto _ : state)
+            {
+                DoNotOptimize(fixture.orchestrator.GetPass(fixture.handles[next]));
+                next = next + 1 == fixture.handles.size() ? 0 : next + 1;
+            }
+        }
+        LUMI_BENCHMARK(BM_OrchestratorGetPass, 10, 100, 500);
+
+        /* The name lookup kept for tools */
+        void BM_OrchestratorFindPass(BenchState& state)
+        {
+            RenderFixture fixture(state.GetArg());
+            size_t next = 0;
+            for (auto _ : state)
+            {
+                DoNotOptimize(fixture.orchestrator.FindPass(fixture.names[next]));
+                next = next + 1 == fixture.names.size() ? 0 : next + 1;
+            }
+        }
+        LUMI_BENCHMARK(BM_OrchestratorFindPass, 10, 100, 500);
+
+        /* The whole frame loop of one target on the null backend, without simulated GPU latency */
+        void BM_NullFrameLoop(BenchState& state)
+        {
+            RenderFixture fixture(state.GetArg());
+            gfx::null::NullRenderTarget& target = *fixture.targets[0];
+            target.EndRendering(0);
+            target.SubmitRendering(0);
+            for (auto _ : state)
+            {
+                target.StartRendering(0);
+                fixture.context.SetFrameNumber(0);
+                fixture.orchestrator.Execute(fixture.context);
+                target.EndRendering(0);
+                target.SubmitRendering(0);
+            }
+        }
+        LUMI_BENCHMARK(BM_NullFrameLoop, 10, 100);
+
+        /* A window dragged by a pixel every frame, arg 0 rebuilds on every change and arg 1 uses the default resize policy */
+        void BM_NullDragResize(BenchState& state)
+        {
+            RenderFixture fixture(10);
+            gfx::null::NullRenderTarget& target = *fixture.targets[0];
+            if (state.GetArg() == 0)
+            {
+                target.SetResizePolicy({ std::chrono::nanoseconds::zero(), std::chrono::nanoseconds::zero() });
+            }
+            target.EndRendering(0);
+            target.SubmitRendering(0);
+
+            int step = 0;
+            for (auto _ : state)
+            {
+                // Sweep between 1280x720 and 1536x976 and back, like a user dragging a corner
+                int offset = step < 256 ? step : 511 - step;
+                step = (step + 1) % 512;
+                target.SetRequestedSize(1280 + offset, 720 + offset);
+
+                target.StartRendering(0);
+                fixture.context.SetFrameNumber(0);
+                fixture.orchestrator.Execute(fixture.context);
+                target.EndRendering(0);
+                target.SubmitRendering(0);
+            }
+            DoNotOptimize(target.GetWidth());
+        }
+        LUMI_BENCHMARK(BM_NullDragResize, 0, 1);
+
+        /* Frames with 0.5ms of CPU work and 0.5ms of simulated GPU work, arg is the number of frames in flight */
+        void BM_NullPipelinedFrames(BenchState& state)
+        {
+            gfx::null::NullDeviceConfig config;
+            config.gpuLatency = std::chrono::microseconds(500);
+            config.logValidationErrors = false;
+            gfx::null::NullDevice device(config);
+            device.Init();
+
+            const auto framesInFlight = static_cast<uint32_t>(state.GetArg());
+            gfx::null::NullRenderTarget target(device, 1280, 720);
+            target.Init(framesInFlight);
+
+            uint32_t frameIndex = 0;
+            for (auto _ : state)
+            {
+                target.StartRendering(frameIndex);
+                auto recordEnd = std::chrono::steady_clock::now() + std::chrono::microseconds(500);
+                while (std::chrono::steady_clock::now() < recordEnd)
+                {
+                }
+                target.EndRendering(frameIndex);
+                target.SubmitRendering(frameIndex);
+                frameIndex = (frameIndex + 1) % framesInFlight;
+            }
+            DoNotOptimize(target.GetSync().GetSignaledValue());
+        }
+        LUMI_BENCHMARK(BM_NullPipelinedFrames, 1, 2, 3);
+
+        /* Records the passes into a command buffer instead of the backend, the arena is reset like a frame's would be */
+        void BM_CommandRecord(BenchState& state)
+        {
+            RenderFixture fixture(state.GetArg());
+            core::LinearArena arena;
+            render::CommandBuffer commands(arena);
+            render::RecordingRenderContext recorder(commands);
+
+            state.SetItemsPerIteration(static_cast<uint64_t>(state.GetArg()) * kTargetsPerPass);
+            for (auto _ : state)
+            {
+                commands.Clear();
+                arena.Reset();
+                fixture.orchestrator.Execute(recorder);
+            }
+            DoNotOptimize(commands.GetSize());
+        }
+        LUMI_BENCHMARK(BM_CommandRecord, 10, 100, 500);
+
+        /* Replays a recorded frame into the null backend, compare with BM_OrchestratorExecute */
+        void BM_CommandReplay(BenchState& state)
+        {
+            RenderFixture fixture(state.GetArg());
+            core::LinearArena arena;
+            render::CommandBuffer commands(arena);
+            render::RecordingRenderContext recorder(commands);
+            fixture.orchestrator.Execute(recorder);
+
+            state.SetItemsPerIteration(static_cast<uint64_t>(state.GetArg()) * kTargetsPerPass);
+            for (auto _ : state)
+            {
+                fixture.context.Execute(commands);
+            }
+        }
+        LUMI_BENCHMARK(BM_CommandReplay, 10, 100, 500);
+
+        /* Opening and closing timing scopes on the null backend, including resolving them when the frame starts again */
+        void BM_NullTimingScopes(BenchState& state)
+        {
+            RenderFixture fixture(0);
+            gfx::null::NullRenderTarget& target = *fixture.targets[0];
+            fixture.context.SetRenderTarget(target);
+            constexpr uint32_t kScopes = 128;
+
+            state.SetItemsPerIteration(kScopes);
+            for (auto _ : state)
+            {
+                target.StartRendering(0);
+                for (uint32_t i = 0; i < kScopes; ++i)
+                {
+                    fixture.context.BeginTiming("scope");
+                    fixture.context.EndTiming();
+                }
+                target.EndRendering(0);
+                target.SubmitRendering(0);
+            }
+            DoNotOptimize(target.GetTimings().GetResults().size());
+        }
+        LUMI_BENCHMARK(BM_NullTimingScopes);
+
+        /* Stands in for the CPU cost of recording a pass's draws, about a microsecond */
+        void SimulateRecording()
+        {
+            uint64_t value = 0;
+            for (uint32_t i = 0; i < 1000; ++i)
+            {
+                value = value * 6364136223846793005ull + i;
+                DoNotOptimize(value);
+            }
+        }
+
+        /* 64 passes over all 16 targets with recording work, the argument is the number of worker threads */
+        void BM_OrchestratorParallel(BenchState& state)
+        {
+            RenderFixture fixture(0);
+            for (int64_t i = 0; i < 64; ++i)
+            {
+                render::RenderPass pass;
+                for (auto& target : fixture.targets)
+                {
+                    pass.targets.push_back(target.get());
+                }
+                pass.execute = [](render::IRenderContext& ctx, gfx::IRenderTarget* target)
+                {
+                    render::RenderColorInfo color = {};
+                    color.image = target->GetColorBuffer(0).get();
+
+                    render::RenderInfo info;
+                    info.color = { color };
+                    ctx.BeginRecording(info);
+                    SimulateRecording();
+                    ctx.EndRecording(info);
+                };
+                fixture.orchestrator.NewPass("pass_" + std::to_string(i), std::move(pass));
+            }
+
+            fixture.orchestrator.SetParallelRecording([&fixture]
+            {
+                return std::make_unique<gfx::null::render::NullRenderContext>(fixture.device);
+            });
+
+            core::JobSystem::Instance().Start(static_cast<uint32_t>(state.GetArg()));
+            state.SetItemsPerIteration(64 * kTargetCount);
+            for (auto _ : state)
+            {
+                fixture.orchestrator.Execute(fixture.context);
+            }
+            core::JobSystem::Instance().Stop();
+        }
+        LUMI_BENCHMARK(BM_OrchestratorParallel, 0, 1, 3, 7, 15);
+
+        /* A chain of passes where each one reads the image written by the pass before it, plus one unused pass */
+        struct RenderGraphFixture
+        {
+            RenderFixture base{0};
+            std::vector<std::unique_ptr<gfx::null::resources::NullImageBuffer>> images;
+            render::RenderGraph graph;
+
+            explicit RenderGraphFixture(const int64_t passCount)
+            {
+                for (int64_t i = 0; i < passCount; ++i)
+                {
+                    auto image = std::make_unique<gfx::null::resources::NullImageBuffer>(base.device);
+                    image->SetDesc({ 1280, 720, gfx::resources::ImageFormat::RGBA8,
+                        gfx::resources::ImageUsage::Render | gfx::resources::ImageUsage::Shader });
+                    image->Create();
+                    images.push_back(std::move(image));
+                }
+                Build();
+            }
+
+            /* Adds the passes and images to the graph, the way a frame that rebuilds its graph would */
+            void Build()
+            {
+                gfx::IRenderTarget* target = base.targets[0].get();
+                render::RenderGraphImage backbuffer = graph.ImportImage("backbuffer",
+                    render::RenderGraph::ColorBuffer, gfx::resources::ImageState::Present);
+
+                render::RenderGraphImage previous;
+                for (size_t i = 0; i < images.size(); ++i)
+                {
+                    gfx::resources::IImageBuffer* buffer = images[i].get();
+                    bool last = i + 1 == images.size();
+                    render::RenderGraphImage output = last ? backbuffer : graph.ImportImage("image_" + std::to_string(i),
+                        [buffer](render::IRenderContext&, gfx::IRenderTarget*) { return buffer; });
+
+                    render::RenderGraphPass pass;
+                    pass.targets = { target };
+                    pass.writes = { { output, gfx::resources::ImageState::Color } };
+                    if (previous.IsValid())
+                    {
+                        pass.reads = { { previous, gfx::resources::ImageState::Shader } };
+                    }
+                    pass.execute = [](render::IRenderContext& ctx, gfx::IRenderTarget*) { DoNotOptimize(ctx); };
+                    graph.NewPass("pass_" + std::to_string(i), std::move(pass));
+                    previous = output;
+                }
+
+                render::RenderGraphPass unused;
+                unused.targets = { target };
+                unused.writes = { { graph.ImportImage("unused", render::RenderGraph::ColorBuffer),
+                    gfx::resources::ImageState::Color } };
+                graph.NewPass("unused", std::move(unused));
+            }
+        };
+
+        void BM_RenderGraphCompile(BenchState& state)
+        {
+            RenderGraphFixture fixture(state.GetArg());
+            state.SetItemsPerIteration(static_cast<uint64_t>(state.GetArg()));
+            for (auto _ : state)
+            {
+                DoNotOptimize(fixture.graph.Compile());
+            }
+        }
+        LUMI_BENCHMARK(BM_RenderGraphCompile, 10, 100, 500);
+
+        void BM_RenderGraphExecute(BenchState& state)
+        {
+            RenderGraphFixture fixture(state.GetArg());
+            state.SetItemsPerIteration(static_cast<uint64_t>(state.GetArg()));
+            fixture.graph.Compile();
+            for (auto _ : state)
+            {
+                fixture.graph.Execute(fixture.base.context);
+            }
+        }
+        LUMI_BENCHMARK(BM_RenderGraphExecute, 10, 100, 500);
+
+        /* Clears and rebuilds the graph every frame, the compiled graph is reused since nothing changes */
+        void BM_RenderGraphRebuild(BenchState& state)
+        {
+            RenderGraphFixture fixture(state.GetArg());
+            state.SetItemsPerIteration(static_cast<uint64_t>(state.GetArg()));
+            fixture.graph.Execute(fixture.base.context);
+            for (auto _ : state)
+            {
+                fixture.graph.Clear();
+                fixture.Build();
+                fixture.graph.Execute(fixture.base.context);
+            }
+            DoNotOptimize(fixture.graph.GetCacheHitCount());
+        }
+        LUMI_BENCHMARK(BM_RenderGraphRebuild, 10, 100, 500);
+
+        /* Post-processing style chains, each resource lives for three passes and sizes vary */
+        void BM_TransientPlan(BenchState& state)
+        {
+            std::vector<render::TransientResource> resources;
+            for (int64_t i = 0; i < state.GetArg(); ++i)
+            {
+                uint64_t size = (uint64_t(1) << (16 + i % 6));
+                resources.push_back({ size, 65536, static_cast<uint32_t>(i), static_cast<uint32_t>(i + 2) });
+            }
+
+            state.SetItemsPerIteration(static_cast<uint64_t>(state.GetArg()));
+            for (auto _ : state)
+            {
+                DoNotOptimize(render::PlanTransientResources(resources));
+            }
+        }
+        LUMI_BENCHMARK(BM_TransientPlan, 10, 100, 500);
+    }
+}
\ No newline at end of file
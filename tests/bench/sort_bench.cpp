@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <core/job_system.h>
+#include <core/radix_sort.h>
+#include <gfx/render/render_context.h>
+#include <gfx/render/submission_queue.h>
+#include "bench.h"
+
+namespace lumi::bench
+{
+    namespace
+    {
+        using core::JobSystem;
+        using core::SortEntry;
+
+        constexpr size_t kSortItems = 1'000'000;
+
+        /* Keys shaped like a frame's draws, a few passes and targets with many pipelines, materials and depths */
+        std::vector<SortEntry> MakeDrawKeys(const size_t count)
+        {
+            std::mt19937 random(42);
+            std::vector<SortEntry> entries(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                gfx::render::SubmissionKey key;
+                key.pass = random() % 8;
+                key.target = random() % 4;
+                key.pipeline = random() % 200;
+                key.material = random() % 5000;
+                key.depth = static_cast<float>(random()) / static_cast<float>(std::mt19937::max());
+                entries[i] = { key.Pack(), static_cast<uint32_t>(i) };
+            }
+            return entries;
+        }
+
+        /* Radix sorting 1M draw keys, the argument is the number of job workers */
+        void BM_RadixSort(BenchState& state)
+        {
+            JobSystem::Instance().Start(static_cast<uint32_t>(state.GetArg()));
+            const std::vector<SortEntry> keys = MakeDrawKeys(kSortItems);
+            std::vector<SortEntry> entries(kSortItems);
+            std::vector<SortEntry> scratch(kSortItems);
+
+            state.SetItemsPerIteration(kSortItems);
+            for (auto _ : state)
+            {
+                state.PauseTiming();
+                entries = keys;
+                state.ResumeTiming();
+
+                core::RadixSort(entries, scratch);
+            }
+            DoNotOptimize(entries.front());
+            JobSystem::Instance().Stop();
+        }
+        LUMI_BENCHMARK(BM_RadixSort, 0, 1, 3, 7);
+
+        /* The comparison sort the radix sort replaces, on the same keys */
+        void BM_StdSortKeys(BenchState& state)
+        {
+            const std::vector<SortEntry> keys = MakeDrawKeys(kSortItems);
+            std::vector<SortEntry> entries(kSortItems);
+
+            state.SetItemsPerIteration(kSortItems);
+            for (auto _ : state)
+            {
+                state.PauseTiming();
+                entries = keys;
+                state.ResumeTiming();
+
+                std::stable_sort(entries.begin(), entries.end(),
+                    [](const SortEntry& a, const SortEntry& b) { return a.key < b.key; });
+            }
+            DoNotOptimize(entries.front());
+        }
+        LUMI_BENCHMARK(BM_StdSortKeys);
+
+        /* Records nothing, so the queue's own submit, sort and replay costs are what's measured */
+        class CountingContext final : public gfx::render::IRenderContext
+        {
+        public:
+            void SetRenderTarget(gfx::IRenderTarget&) override {}
+            void BeginRecording(const gfx::render::RenderInfo&) override { ++recordings; }
+            void EndRecording(const gfx::render::RenderInfo&) override {}
+            void Transition(gfx::resources::IImageBuffer&, const gfx::resources::ImageState&) override {}
+            void Alias(gfx::resources::IImageBuffer&, const gfx::resources::ImageState&) override {}
+            void Execute(const gfx::render::CommandBuffer&) override {}
+            void BeginTiming(std::string_view) override {}
+            void EndTiming() override {}
+
+            uint64_t recordings = 0;
+        };
+
+        /* A frame of arg submissions in random key order, submitted, sorted and replayed */
+        void BM_SubmissionQueue(BenchState& state)
+        {
+            const auto count = static_cast<size_t>(state.GetArg());
+            const std::vector<SortEntry> keys = MakeDrawKeys(count);
+            gfx::render::SubmissionQueue queue;
+            CountingContext ctx;
+            queue.Reserve(count);
+
+            state.SetItemsPerIteration(count);
+            for (auto _ : state)
+            {
+                queue.Clear();
+                for (const auto& entry : keys)
+                {
+                    queue.Submit(entry.key, [](gfx::render::IRenderContext& context)
+                    {
+                        context.BeginRecording({});
+                    });
+                }
+                queue.Execute(ctx);
+            }
+            DoNotOptimize(ctx.recordings);
+        }
+        LUMI_BENCHMARK(BM_SubmissionQueue, 1000, 100000);
+    }
+}
\ No newline at end of file
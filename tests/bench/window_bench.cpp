@@ -0,0 +1,135 @@
+#include <vector>
+#include <sys/window_manager.h>
+#include "bench.h"
+#include "bench_video.h"
+
+namespace lumi::bench
+{
+    namespace
+    {
+        constexpr int kEventsPerWindow = 4;
+
+        /* Dispatches kEventsPerWindow events to each of arg windows */
+        void BM_WindowManagerUpdate(BenchState& state)
+        {
+            if (!StartBenchVideo())
+            {
+                return;
+            }
+
+            sys::WindowManager windowManager;
+            std::vector<sys::WinPtr> windows;
+            for (int64_t i = 0; i < state.GetArg(); ++i)
+            {
+                windows.push_back(windowManager.NewWindow(GetBenchWindowProperties()));
+            }
+
+            // Events the windows receive but don't act on, so only dispatch is measured
+            std::vector<SDL_Event> events;
+            for (const auto& window : windows)
+            {
+                for (int i = 0; i < kEventsPerWindow; ++i)
+                {
+                    SDL_Event event = {};
+                    event.type = SDL_EVENT_WINDOW_MOVED;
+                    event.window.windowID = window ? window->GetID() : 0;
+                    event.window.data1 = i;
+                    events.push_back(event);
+                }
+            }
+
+            state.SetItemsPerIteration(events.size());
+            for (auto _ : state)
+            {
+                state.PauseTiming();
+                for (auto& event : events)
+                {
+                    SDL_PushEvent(&event);
+                }
+                state.ResumeTiming();
+
+                windowManager.Update();
+            }
+
+            windows.clear();
+            windowManager.Cleanup();
+        }
+        LUMI_BENCHMARK(BM_WindowManagerUpdate, 1, 16, 64);
+
+        /* Size changes published to arg subscribers, what a resize costs before any render target rebuilds */
+        void BM_WindowSizeChanges(BenchState& state)
+        {
+            if (!StartBenchVideo())
+            {
+                return;
+            }
+
+            sys::WindowManager windowManager;
+            sys::WinPtr window = windowManager.NewWindow(GetBenchWindowProperties());
+            if (!window)
+            {
+                return;
+            }
+
+            uint64_t seen = 0;
+            std::vector<sys::WindowSubscription> subscriptions;
+            for (int64_t i = 0; i < state.GetArg(); ++i)
+            {
+                subscriptions.push_back(window->Subscribe([&seen](const sys::WindowChangeEvent& event) { seen = event.generation; }));
+            }
+
+            std::vector<SDL_Event> events;
+            for (int i = 0; i < kEventsPerWindow; ++i)
+            {
+                SDL_Event event = {};
+                event.type = SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED;
+                event.window.windowID = window->GetID();
+                event.window.data1 = 640 + i;
+                event.window.data2 = 480 + i;
+                events.push_back(event);
+            }
+
+            state.SetItemsPerIteration(events.size());
+            for (auto _ : state)
+            {
+                state.PauseTiming();
+                for (auto& event : events)
+                {
+                    SDL_PushEvent(&event);
+                }
+                state.ResumeTiming();
+
+                windowManager.Update();
+            }
+            DoNotOptimize(seen);
+
+            for (auto subscription : subscriptions)
+            {
+                window->Unsubscribe(subscription);
+            }
+            window.reset();
+            windowManager.Cleanup();
+        }
+        LUMI_BENCHMARK(BM_WindowSizeChanges, 1, 8);
+
+        /* Polling with nothing queued, the cost every frame pays when the user does nothing */
+        void BM_WindowManagerUpdateIdle(BenchState& state)
+        {
+            if (!StartBenchVideo())
+            {
+                return;
+            }
+
+            sys::WindowManager windowManager;
+            sys::WinPtr window = windowManager.NewWindow(GetBenchWindowProperties());
+            for (auto _ : state)
+            {
+                windowManager.Update();
+            }
+
+            window.reset();
+            windowManager.Cleanup();
+        }
+        LUMI_BENCHMARK(BM_WindowManagerUpdateIdle);
+    }
+}
\ No newline at end of file
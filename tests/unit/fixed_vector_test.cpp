@@ -0,0 +1,73 @@
+#include <array>
+#include <core/fixed_vector.h>
+#include <core/frame_arena.h>
+#include <gfx/render/command_buffer.h>
+#include <gfx/render/render_info.h>
+#include "log_capture.h"
+#include "test.h"
+
+namespace lumi::test
+{
+    LUMI_TEST(FixedVectorHoldsUpToCapacity)
+    {
+        LogCapture log;
+        core::FixedVector<int, 3> items = { 1, 2, 3 };
+        LUMI_CHECK_EQ(items.size(), 3u);
+        LUMI_CHECK_EQ(items[2], 3);
+
+        items.Pop();
+        LUMI_CHECK(items.Push(4));
+        LUMI_CHECK_EQ(items[2], 4);
+        LUMI_CHECK_EQ(items.AsSpan().size(), 3u);
+        LUMI_CHECK(log.GetMessages().empty());
+    }
+
+    LUMI_TEST(FixedVectorReportsDroppedPushes)
+    {
+        LogCapture log;
+        core::FixedVector<int, 2> items;
+        LUMI_CHECK(items.Push(1));
+        LUMI_CHECK(items.Push(2));
+        LUMI_CHECK(!items.Push(3));
+        LUMI_CHECK_EQ(items.size(), 2u);
+        LUMI_CHECK_EQ(items[1], 2);
+        LUMI_CHECK_EQ(log.Count("A fixed vector of 2 items was given 3"), 1u);
+    }
+
+    LUMI_TEST(FixedVectorReportsTruncatedInitializerLists)
+    {
+        LogCapture log;
+        core::FixedVector<int, 4> items = { 1, 2, 3, 4, 5, 6 };
+        LUMI_CHECK_EQ(items.size(), 4u);
+        LUMI_CHECK_EQ(items[3], 4);
+        LUMI_CHECK_EQ(log.Count("A fixed vector of 4 items was given 6"), 1u);
+
+        // One report per list, not one per dropped item
+        log.Clear();
+        items = { 7, 8, 9, 10, 11, 12, 13 };
+        LUMI_CHECK_EQ(items.size(), 4u);
+        LUMI_CHECK_EQ(items[0], 7);
+        LUMI_CHECK_EQ(log.Count("A fixed vector of 4 items was given 7"), 1u);
+    }
+
+    LUMI_TEST(CommandBufferReportsDroppedColorImages)
+    {
+        LogCapture log;
+        core::LinearArena arena;
+        gfx::render::CommandBuffer commands(arena);
+
+        std::array<gfx::resources::IImageBuffer*, gfx::render::kMaxColorAttachments + 2> color = {};
+        commands.BeginPass(color, nullptr);
+        LUMI_CHECK_EQ(log.Count("A pass began with"), 1u);
+
+        size_t bound = 0;
+        for (const auto& command : commands)
+        {
+            if (command.type == gfx::render::CommandType::BeginPass)
+            {
+                bound = static_cast<const gfx::render::BeginPassCommand&>(command).GetColor().size();
+            }
+        }
+        LUMI_CHECK_EQ(bound, gfx::render::kMaxColorAttachments);
+    }
+}
\ No newline at end of file
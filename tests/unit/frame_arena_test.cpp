@@ -0,0 +1,127 @@
+#include <core/frame_arena.h>
+#include <gfx/backends/null/null_device.h>
+#include <gfx/backends/null/null_render_target.h>
+#include <gfx/backends/null/render/null_render_context.h>
+#include <gfx/render/recording_render_context.h>
+#include <gfx/render/render_orchestrator.h>
+#include "test.h"
+
+namespace lumi::test
+{
+    namespace
+    {
+        namespace render = gfx::render;
+        using gfx::null::NullOp;
+
+        /* A null target with two frames in flight */
+        struct ArenaFixture
+        {
+            gfx::null::NullDevice device;
+            gfx::null::NullRenderTarget target{device, 64, 64};
+            gfx::null::render::NullRenderContext context{device};
+
+            ArenaFixture()
+            {
+                gfx::null::NullDeviceConfig config;
+                config.logValidationErrors = false;
+                device.SetConfig(config);
+                device.Init();
+                target.Init(2);
+            }
+
+            void EndFrame(const uint32_t index)
+            {
+                target.EndRendering(index);
+                target.SubmitRendering(index);
+            }
+        };
+    }
+
+    LUMI_TEST(FrameArenaResetsOnlyItsFrame)
+    {
+        core::FrameArena arenas;
+        arenas.SetFrameCount(2);
+        LUMI_REQUIRE(arenas.GetFrameCount() == 2u);
+
+        (void)arenas.Get(0).Allocate(100);
+        (void)arenas.Get(1).Allocate(200);
+        arenas.BeginFrame(0);
+        LUMI_CHECK_EQ(arenas.Get(0).GetUsed(), 0u);
+        LUMI_CHECK(arenas.Get(1).GetUsed() >= 200u);
+
+        // Out of range frames are ignored
+        arenas.BeginFrame(2);
+        LUMI_CHECK(arenas.Get(1).GetUsed() >= 200u);
+    }
+
+    LUMI_TEST(RenderTargetResetsFrameArenaWhenFrameStartsAgain)
+    {
+        ArenaFixture fixture;
+
+        fixture.target.StartRendering(0);
+        (void)fixture.target.GetFrameArena(0).Allocate(256);
+        fixture.EndFrame(0);
+
+        // Another frame in flight leaves the first frame's memory alone
+        fixture.target.StartRendering(1);
+        LUMI_CHECK(fixture.target.GetFrameArena(0).GetUsed() >= 256u);
+        fixture.EndFrame(1);
+
+        fixture.target.StartRendering(0);
+        LUMI_CHECK_EQ(fixture.target.GetFrameArena(0).GetUsed(), 0u);
+        fixture.EndFrame(0);
+    }
+
+    LUMI_TEST(PassesGetTheFrameArenaOfTheirTarget)
+    {
+        ArenaFixture fixture;
+        render::RenderOrchestrator orchestrator;
+        size_t scratchSize = 0;
+        orchestrator.NewPass("scratch", { &fixture.target }, [&scratchSize](render::IRenderContext& ctx,
+            gfx::IRenderTarget* target)
+        {
+            auto draws = ctx.GetFrameArena(*target).AllocateSpan<uint32_t>(32);
+            scratchSize = draws.size();
+        });
+
+        fixture.target.StartRendering(1);
+        fixture.context.SetFrameNumber(1);
+        orchestrator.Execute(fixture.context);
+        LUMI_CHECK_EQ(scratchSize, 32u);
+        LUMI_CHECK(fixture.target.GetFrameArena(1).GetUsed() >= 32 * sizeof(uint32_t));
+        LUMI_CHECK_EQ(fixture.target.GetFrameArena(0).GetUsed(), 0u);
+        fixture.EndFrame(1);
+    }
+
+    LUMI_TEST(RecordingContextRecordsIntoFrameArena)
+    {
+        ArenaFixture fixture;
+        fixture.target.StartRendering(0);
+
+        render::RecordingRenderContext recorder(fixture.target, 0);
+        LUMI_CHECK_EQ(recorder.GetFrameNumber(), 0u);
+        recorder.SetRenderTarget(fixture.target);
+        render::RenderColorInfo color = {};
+        color.image = fixture.target.GetColorBuffer(0).get();
+        render::RenderInfo info;
+        info.color = { color };
+        recorder.BeginRecording(info);
+        recorder.EndRecording(info);
+        LUMI_CHECK(!recorder.GetCommandBuffer().IsEmpty());
+        LUMI_CHECK(fixture.target.GetFrameArena(0).GetUsed() > 0u);
+
+        fixture.context.SetFrameNumber(0);
+        fixture.context.Execute(recorder.GetCommandBuffer());
+        LUMI_CHECK_EQ(fixture.device.GetCount(NullOp::RecordingsBegun), 1u);
+        LUMI_CHECK_EQ(fixture.device.GetCount(NullOp::InvalidRecordings), 0u);
+        fixture.EndFrame(0);
+
+        // The next use of the frame records into a fresh buffer, the old commands went with the arena's reset
+        fixture.target.StartRendering(1);
+        fixture.EndFrame(1);
+        fixture.target.StartRendering(0);
+        recorder.RecordFrame(fixture.target, 0);
+        LUMI_CHECK(recorder.GetCommandBuffer().IsEmpty());
+        fixture.EndFrame(0);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <core/job_system.h>
+
+namespace lumi::test
+{
+    /* Runs the job system while it's alive, with no workers it stays stopped and jobs run where they're added */
+    class JobSystemScope
+    {
+    public:
+        explicit JobSystemScope(const uint32_t workerCount)
+        {
+            if (workerCount > 0)
+            {
+                core::JobSystem::Instance().Start(workerCount);
+            }
+        }
+        ~JobSystemScope() { core::JobSystem::Instance().Stop(); }
+
+        JobSystemScope(const JobSystemScope&) = delete;
+        JobSystemScope& operator=(const JobSystemScope&) = delete;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,211 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <core/job_system.h>
+#include "job_system_scope.h"
+#include "test.h"
+
+namespace lumi::test
+{
+    namespace
+    {
+        using core::JobAffinity;
+        using core::JobCounter;
+        using core::JobSystem;
+
+        constexpr uint32_t kWorkerCounts[] = { 0, 3 };
+    }
+
+    LUMI_TEST(JobCounterWaitsForEveryJob)
+    {
+        for (uint32_t workers : kWorkerCounts)
+        {
+            JobSystemScope scope(workers);
+            JobSystem& jobs = JobSystem::Instance();
+
+            std::atomic<uint32_t> ran = 0;
+            JobCounter counter;
+            for (int i = 0; i < 1000; ++i)
+            {
+                jobs.Run([&ran] { ran.fetch_add(1, std::memory_order_relaxed); }, &counter);
+            }
+            jobs.Wait(counter);
+            LUMI_CHECK_EQ(ran.load(), 1000u);
+            LUMI_CHECK(counter.IsDone());
+            LUMI_CHECK_EQ(counter.GetPending(), 0u);
+
+            // A counter that nothing was run on is already done
+            JobCounter unused;
+            jobs.Wait(unused);
+            LUMI_CHECK(unused.IsDone());
+        }
+    }
+
+    LUMI_TEST(RunAfterWaitsForItsDependency)
+    {
+        for (uint32_t workers : kWorkerCounts)
+        {
+            JobSystemScope scope(workers);
+            JobSystem& jobs = JobSystem::Instance();
+
+            // Each stage sees every job of the stage before it finished
+            std::atomic<uint32_t> first = 0;
+            std::atomic<uint32_t> second = 0;
+            std::atomic<uint32_t> startedEarly = 0;
+            uint32_t secondSeenByLast = 0;
+            JobCounter firstCounter;
+            JobCounter secondCounter;
+            JobCounter lastCounter;
+
+            for (int i = 0; i < 64; ++i)
+            {
+                jobs.Run([&first]
+                {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                    first.fetch_add(1);
+                }, &firstCounter);
+            }
+            for (int i = 0; i < 16; ++i)
+            {
+                jobs.RunAfter(firstCounter, [&]
+                {
+                    startedEarly.fetch_add(first.load() == 64 ? 0 : 1);
+                    second.fetch_add(1);
+                }, &secondCounter);
+            }
+            jobs.RunAfter(secondCounter, [&] { secondSeenByLast = second.load(); }, &lastCounter);
+            jobs.Wait(lastCounter);
+
+            LUMI_CHECK_EQ(startedEarly.load(), 0u);
+            LUMI_CHECK_EQ(secondSeenByLast, 16u);
+
+            // A dependency that is already done doesn't hold the job back
+            bool ran = false;
+            JobCounter counter;
+            jobs.RunAfter(firstCounter, [&ran] { ran = true; }, &counter);
+            jobs.Wait(counter);
+            LUMI_CHECK(ran);
+        }
+    }
+
+    LUMI_TEST(MainThreadJobsOnlyRunOnMainThread)
+    {
+        JobSystemScope scope(3);
+        JobSystem& jobs = JobSystem::Instance();
+        LUMI_REQUIRE(JobSystem::IsMainThread());
+
+        // Queued from the main thread and from workers, only the main thread picks them up
+        std::atomic<uint32_t> ran = 0;
+        std::atomic<uint32_t> offMainThread = 0;
+        auto mainThreadJob = [&]
+        {
+            offMainThread.fetch_add(JobSystem::IsMainThread() ? 0 : 1);
+            ran.fetch_add(1);
+        };
+
+        JobCounter counter;
+        for (int i = 0; i < 32; ++i)
+        {
+            jobs.Run(mainThreadJob, &counter, JobAffinity::MainThread);
+            jobs.Run([&] { jobs.Run(mainThreadJob, &counter, JobAffinity::MainThread); }, &counter);
+        }
+
+        // Workers are idle but leave them queued
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        LUMI_CHECK_EQ(ran.load(), 0u);
+
+        jobs.Wait(counter);
+        LUMI_CHECK_EQ(ran.load(), 64u);
+        LUMI_CHECK_EQ(offMainThread.load(), 0u);
+
+        // RunMainThreadJobs runs them too, and does nothing off the main thread
+        JobCounter workerCounter;
+        jobs.Run(mainThreadJob, &counter, JobAffinity::MainThread);
+        jobs.Run([&] { jobs.RunMainThreadJobs(); }, &workerCounter);
+        jobs.Wait(workerCounter);
+        jobs.RunMainThreadJobs();
+        LUMI_CHECK(counter.IsDone());
+        LUMI_CHECK_EQ(ran.load(), 65u);
+        LUMI_CHECK_EQ(offMainThread.load(), 0u);
+    }
+
+    LUMI_TEST(ParallelForCoversEveryIndexOnce)
+    {
+        for (uint32_t workers : kWorkerCounts)
+        {
+            JobSystemScope scope(workers);
+            JobSystem& jobs = JobSystem::Instance();
+
+            for (size_t grainSize : { size_t(0), size_t(1), size_t(64), size_t(100000) })
+            {
+                constexpr size_t kCount = 10007;
+                auto visits = std::make_unique<std::atomic<uint32_t>[]>(kCount);
+                std::atomic<bool> outOfRange = false;
+                jobs.ParallelFor(kCount, grainSize, [&](const size_t begin, const size_t end)
+                {
+                    if (begin >= end || end > kCount)
+                    {
+                        outOfRange = true;
+                        return;
+                    }
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        visits[i].fetch_add(1, std::memory_order_relaxed);
+                    }
+                });
+
+                LUMI_CHECK(!outOfRange);
+                size_t once = 0;
+                for (size_t i = 0; i < kCount; ++i)
+                {
+                    once += visits[i].load() == 1 ? 1 : 0;
+                }
+                LUMI_CHECK_EQ(once, kCount);
+            }
+
+            bool called = false;
+            jobs.ParallelFor(0, 16, [&called](size_t, size_t) { called = true; });
+            LUMI_CHECK(!called);
+        }
+    }
+
+    LUMI_TEST(JobsRunWhenEverySlotIsInUse)
+    {
+        JobSystemScope scope(3);
+        JobSystem& jobs = JobSystem::Instance();
+
+        // The held jobs keep the main thread's slots in use, so the rest are allocated and pushed to the shared queue
+        constexpr uint32_t kJobCount = JobSystem::kJobsPerThread + 1000;
+        std::atomic<bool> release = false;
+        std::atomic<uint32_t> ran = 0;
+        JobCounter counter;
+        for (uint32_t i = 0; i < kJobCount; ++i)
+        {
+            jobs.Run([&]
+            {
+                while (!release.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+                ran.fetch_add(1, std::memory_order_relaxed);
+            }, &counter);
+        }
+        LUMI_CHECK_EQ(counter.GetPending(), kJobCount);
+
+        release = true;
+        jobs.Wait(counter);
+        LUMI_CHECK_EQ(ran.load(), kJobCount);
+
+        // The slots are free again once their jobs finished
+        JobCounter after;
+        for (uint32_t i = 0; i < JobSystem::kJobsPerThread; ++i)
+        {
+            jobs.Run([&ran] { ran.fetch_add(1, std::memory_order_relaxed); }, &after);
+        }
+        jobs.Wait(after);
+        LUMI_CHECK_EQ(ran.load(), kJobCount + JobSystem::kJobsPerThread);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <debugging/logger.h>
+
+namespace lumi::test
+{
+    /* Keeps the text of every message written while it's alive */
+    class LogCapture
+    {
+    public:
+        LogCapture() : _sink(std::make_shared<Sink>()) { debugging::Logger::Instance().AddSink(_sink); }
+        ~LogCapture() { debugging::Logger::Instance().RemoveSink(_sink); }
+
+        LogCapture(const LogCapture&) = delete;
+        LogCapture& operator=(const LogCapture&) = delete;
+
+        [[nodiscard]] const std::vector<std::string>& GetMessages() const { return _sink->messages; }
+
+        /* Counts the messages containing text */
+        [[nodiscard]] size_t Count(const std::string_view text) const
+        {
+            size_t count = 0;
+            for (const auto& message : _sink->messages)
+            {
+                count += message.find(text) != std::string::npos ? 1 : 0;
+            }
+            return count;
+        }
+
+        void Clear() { _sink->messages.clear(); }
+    private:
+        struct Sink final : debugging::ILogSink
+        {
+            std::vector<std::string> messages;
+
+            void Write(const debugging::LogMessage& message) override { messages.emplace_back(message.text); }
+            void Flush() override {}
+        };
+
+        std::shared_ptr<Sink> _sink;
+    };
+}
\ No newline at end of file
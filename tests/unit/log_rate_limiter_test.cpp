@@ -0,0 +1,166 @@
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <debugging/logger.h>
+#include "log_capture.h"
+#include "test.h"
+
+namespace lumi::test
+{
+    namespace
+    {
+        using debugging::Logger;
+        using std::chrono::milliseconds;
+
+        /* Every test logs from its own call site, so limiter state doesn't carry over between them */
+        void LogEvicted(const int value)
+        {
+            LUMI_LOG_WARN_RATE_LIMITED(debugging::LogCore, std::chrono::seconds(10), "Evicted test value {}", value);
+        }
+
+        void LogFlushed(const int value)
+        {
+            LUMI_LOG_WARN_RATE_LIMITED(debugging::LogCore, std::chrono::seconds(10), "Flushed test value {}", value);
+        }
+
+        void LogAsync(const int value)
+        {
+            LUMI_LOG_WARN_RATE_LIMITED(debugging::LogCore, std::chrono::seconds(10), "Async test value {}", value);
+        }
+
+        void LogOnThread(const int value)
+        {
+            LUMI_LOG_WARN_RATE_LIMITED(debugging::LogCore, std::chrono::seconds(10), "Thread test value {}", value);
+        }
+
+        void LogRepeated(const int value)
+        {
+            LUMI_LOG_WARN_RATE_LIMITED(debugging::LogCore, milliseconds(20), "Repeated test value {}", value);
+        }
+
+        /* Reads the milliseconds out of a "... in the last Nms" summary, -1 if it has none */
+        int64_t GetSummaryMilliseconds(const std::string& message)
+        {
+            size_t at = message.rfind("in the last ");
+            if (at == std::string::npos)
+            {
+                return -1;
+            }
+            return std::strtoll(message.c_str() + at + 12, nullptr, 10);
+        }
+
+        const std::string* FindSummary(const LogCapture& log)
+        {
+            for (const auto& message : log.GetMessages())
+            {
+                if (message.starts_with("Suppressed"))
+                {
+                    return &message;
+                }
+            }
+            return nullptr;
+        }
+    }
+
+    LUMI_TEST(RateLimiterSuppressesRepeats)
+    {
+        LogCapture log;
+        LogRepeated(1);
+        LogRepeated(1);
+        LogRepeated(1);
+        LogRepeated(2);
+        LUMI_CHECK_EQ(log.Count("Repeated test value 1"), 1u);
+        LUMI_CHECK_EQ(log.Count("Repeated test value 2"), 1u);
+
+        // The next write after the interval reports the repeats over the time they were counted
+        std::this_thread::sleep_for(milliseconds(25));
+        LogRepeated(1);
+        LUMI_CHECK_EQ(log.Count("Repeated test value 1"), 2u);
+        const std::string* summary = FindSummary(log);
+        LUMI_REQUIRE(summary != nullptr);
+        LUMI_CHECK(summary->starts_with("Suppressed 2 repeats of \"Repeated test value {}\""));
+        LUMI_CHECK(GetSummaryMilliseconds(*summary) >= 25);
+    }
+
+    LUMI_TEST(RateLimiterReportsEvictedRepeats)
+    {
+        LogCapture log;
+        LogEvicted(0);
+        LogEvicted(0);
+        LogEvicted(0);
+
+        // The limiter remembers four messages, the fifth one replaces the least recently written
+        LogEvicted(1);
+        LogEvicted(2);
+        LogEvicted(3);
+        LUMI_CHECK(FindSummary(log) == nullptr);
+        LogEvicted(4);
+        const std::string* summary = FindSummary(log);
+        LUMI_REQUIRE(summary != nullptr);
+        LUMI_CHECK(summary->starts_with("Suppressed 2 repeats of \"Evicted test value {}\""));
+
+        // The count was reported already, flushing doesn't repeat it
+        log.Clear();
+        Logger::Instance().Flush();
+        LUMI_CHECK(FindSummary(log) == nullptr);
+    }
+
+    LUMI_TEST(RateLimiterReportsPendingRepeatsOnFlush)
+    {
+        LogCapture log;
+        LogFlushed(0);
+        std::this_thread::sleep_for(milliseconds(30));
+        LogFlushed(0);
+        LUMI_CHECK(FindSummary(log) == nullptr);
+
+        // The summary covers the time since the message was written, not the 10s interval
+        Logger::Instance().Flush();
+        const std::string* summary = FindSummary(log);
+        LUMI_REQUIRE(summary != nullptr);
+        LUMI_CHECK(summary->starts_with("Suppressed 1 repeats of \"Flushed test value {}\""));
+        int64_t elapsed = GetSummaryMilliseconds(*summary);
+        LUMI_CHECK(elapsed >= 30);
+        LUMI_CHECK(elapsed < 10000);
+
+        // Repeats after the flush are counted again from the flush
+        log.Clear();
+        LogFlushed(0);
+        LogFlushed(0);
+        Logger::Instance().Flush();
+        summary = FindSummary(log);
+        LUMI_REQUIRE(summary != nullptr);
+        LUMI_CHECK(summary->starts_with("Suppressed 2 repeats"));
+        LUMI_CHECK(GetSummaryMilliseconds(*summary) < 30);
+    }
+
+    LUMI_TEST(RateLimiterReportsPendingRepeatsOnStopAsync)
+    {
+        LogCapture log;
+        Logger::Instance().StartAsync();
+        LogAsync(0);
+        LogAsync(0);
+        LogAsync(0);
+        Logger::Instance().StopAsync();
+
+        LUMI_CHECK_EQ(log.Count("Async test value 0"), 1u);
+        const std::string* summary = FindSummary(log);
+        LUMI_REQUIRE(summary != nullptr);
+        LUMI_CHECK(summary->starts_with("Suppressed 2 repeats of \"Async test value {}\""));
+    }
+
+    LUMI_TEST(RateLimiterReportsPendingRepeatsOnThreadExit)
+    {
+        LogCapture log;
+        std::thread thread([]
+        {
+            LogOnThread(0);
+            LogOnThread(0);
+        });
+        thread.join();
+
+        const std::string* summary = FindSummary(log);
+        LUMI_REQUIRE(summary != nullptr);
+        LUMI_CHECK(summary->starts_with("Suppressed 1 repeats of \"Thread test value {}\""));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include <debugging/logger.h>
+#include "log_capture.h"
+#include "test.h"
+
+namespace lumi::test
+{
+    namespace
+    {
+        using debugging::Logger;
+        using debugging::LogType;
+
+        /* Sets the core category's level for a scope */
+        struct ScopedCoreLevel
+        {
+            LogType previous = debugging::LogCore::instance.GetLevel();
+
+            explicit ScopedCoreLevel(const LogType level) { debugging::LogCore::instance.SetLevel(level); }
+            ~ScopedCoreLevel() { debugging::LogCore::instance.SetLevel(previous); }
+        };
+
+        int CountedArgument(int& evaluations)
+        {
+            return ++evaluations;
+        }
+    }
+
+    LUMI_TEST(LoggerSkipsFilteredSeverities)
+    {
+        LogCapture log;
+        ScopedCoreLevel level(LogType::Error);
+
+        Logger::Instance().LogInfo("Filtered info {}", 1);
+        Logger::Instance().LogWarn("Filtered warn {}", 2);
+        Logger::Instance().LogError("Kept error {}", 3);
+        LUMI_CHECK_EQ(log.GetMessages().size(), 1u);
+        LUMI_CHECK_EQ(log.Count("Kept error 3"), 1u);
+    }
+
+    LUMI_TEST(LoggerMacrosSkipFilteredArguments)
+    {
+        LogCapture log;
+        ScopedCoreLevel level(LogType::Error);
+
+        // Below the category's level the arguments aren't even evaluated
+        int evaluations = 0;
+        LUMI_LOG_WARN(debugging::LogCore, "Filtered warn {}", CountedArgument(evaluations));
+        LUMI_LOG_WARN_RATE_LIMITED(debugging::LogCore, std::chrono::seconds(1), "Filtered warn {}",
+            CountedArgument(evaluations));
+        LUMI_CHECK_EQ(evaluations, 0);
+        LUMI_CHECK(log.GetMessages().empty());
+
+        LUMI_LOG_ERROR(debugging::LogCore, "Kept error {}", CountedArgument(evaluations));
+        LUMI_CHECK_EQ(evaluations, 1);
+        LUMI_CHECK_EQ(log.Count("Kept error 1"), 1u);
+    }
+}
\ No newline at end of file
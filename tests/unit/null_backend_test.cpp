@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <chrono>
+#include <gfx/backends/null/null_device.h>
+#include <gfx/backends/null/null_render_target.h>
+#include <gfx/backends/null/render/null_render_context.h>
+#include <gfx/backends/null/resources/null_image_buffer.h>
+#include <gfx/backends/null/resources/null_sync.h>
+#include "test.h"
+
+namespace lumi::test
+{
+    namespace
+    {
+        namespace render = gfx::render;
+        using gfx::null::NullOp;
+        using gfx::resources::ImageFormat;
+        using gfx::resources::ImageState;
+        using gfx::resources::ImageUsage;
+        using std::chrono::milliseconds;
+
+        gfx::null::NullDeviceConfig QuietConfig(const std::chrono::nanoseconds gpuLatency = {})
+        {
+            gfx::null::NullDeviceConfig config;
+            config.gpuLatency = gpuLatency;
+            config.logValidationErrors = false;
+            return config;
+        }
+
+        /* Records one pass rendering to the target's color and depth images */
+        void RecordFrame(gfx::null::NullRenderTarget& target, gfx::null::render::NullRenderContext& context,
+            const uint32_t index)
+        {
+            target.StartRendering(index);
+            context.SetFrameNumber(index);
+            context.SetRenderTarget(target);
+
+            render::RenderColorInfo color = {};
+            color.image = target.GetColorBuffer(index).get();
+            render::RenderDepthInfo depth = {};
+            depth.image = target.GetDepthBuffer(index).get();
+
+            render::RenderInfo info;
+            info.color = { color };
+            info.depth = &depth;
+            context.BeginRecording(info);
+            context.EndRecording(info);
+
+            target.EndRendering(index);
+            target.SubmitRendering(index);
+        }
+    }
+
+    LUMI_TEST(NullBackendCountsFrameOperations)
+    {
+        gfx::null::NullDevice device(QuietConfig());
+        device.Init();
+        gfx::null::NullRenderTarget target(device, 640, 480);
+        gfx::null::render::NullRenderContext context(device);
+        LUMI_REQUIRE(target.Init(1));
+        LUMI_CHECK_EQ(device.GetCount(NullOp::ImagesCreated), 2u);
+
+        device.ResetCounts();
+        RecordFrame(target, context, 0);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::FramesStarted), 1u);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::FramesEnded), 1u);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::FramesSubmitted), 1u);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::RenderTargetsSet), 1u);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::RecordingsBegun), 1u);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::RecordingsEnded), 1u);
+        // Color into Color and Present, depth into DepthStencil
+        LUMI_CHECK_EQ(device.GetCount(NullOp::Transitions), 3u);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::InvalidTransitions), 0u);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::InvalidRecordings), 0u);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::GpuWaits), 0u);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::Resizes), 0u);
+
+        // Depth stays in DepthStencil, only color goes back and forth from the second frame on
+        RecordFrame(target, context, 0);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::FramesSubmitted), 2u);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::Transitions), 5u);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::InvalidTransitions), 0u);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::InvalidRecordings), 0u);
+
+        target.Cleanup();
+        LUMI_CHECK_EQ(device.GetCount(NullOp::ImagesDestroyed), 2u);
+    }
+
+    LUMI_TEST(NullBackendRejectsInvalidTransitions)
+    {
+        gfx::null::NullDevice device(QuietConfig());
+        device.Init();
+
+        gfx::null::resources::NullImageBuffer image(device);
+        image.SetDesc({ 64, 64, ImageFormat::RGBA8, ImageUsage::Render });
+
+        // Not created yet
+        image.Transition(ImageState::Color);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::InvalidTransitions), 1u);
+        LUMI_CHECK_EQ(image.GetState(), ImageState::Undefined);
+
+        LUMI_REQUIRE(image.Create());
+        image.Transition(ImageState::Color);
+        LUMI_CHECK_EQ(image.GetState(), ImageState::Color);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::Transitions), 1u);
+
+        // States the usage doesn't allow, and Undefined, are rejected and leave the state alone
+        image.Transition(ImageState::DepthStencil);
+        image.Transition(ImageState::Shader);
+        image.Transition(ImageState::UAV);
+        image.Transition(ImageState::Undefined);
+        image.Alias(ImageState::Shader);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::InvalidTransitions), 6u);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::Transitions), 1u);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::Aliases), 0u);
+        LUMI_CHECK_EQ(image.GetState(), ImageState::Color);
+
+        // Transitioning into the current state is free
+        image.Transition(ImageState::Color);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::Transitions), 1u);
+
+        image.Destroy();
+        image.Transition(ImageState::Present);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::InvalidTransitions), 7u);
+
+        LUMI_CHECK(gfx::null::resources::NullImageBuffer::IsTransitionValid(ImageUsage::Render | ImageUsage::Shader,
+            ImageState::Shader));
+        LUMI_CHECK(!gfx::null::resources::NullImageBuffer::IsTransitionValid(ImageUsage::Render, ImageState::Undefined));
+    }
+
+    LUMI_TEST(NullBackendRejectsInvalidRecordings)
+    {
+        gfx::null::NullDevice device(QuietConfig());
+        device.Init();
+        gfx::null::NullRenderTarget target(device, 64, 64);
+        gfx::null::render::NullRenderContext context(device);
+        LUMI_REQUIRE(target.Init(1));
+        target.StartRendering(0);
+        context.SetRenderTarget(target);
+
+        // The color image has to be in Color to be rendered to
+        target.GetColorBuffer(0)->Transition(ImageState::Present);
+        render::RenderColorInfo color = {};
+        color.image = target.GetColorBuffer(0).get();
+        render::RenderInfo info;
+        info.color = { color };
+        context.BeginRecording(info);
+        context.EndRecording(info);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::InvalidRecordings), 1u);
+
+        context.EndRecording(info);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::InvalidRecordings), 2u);
+
+        // Submitting without ending the frame leaves color out of Present
+        target.GetColorBuffer(0)->Transition(ImageState::Color);
+        uint64_t invalidBefore = device.GetCount(NullOp::InvalidTransitions);
+        target.SubmitRendering(0);
+        LUMI_CHECK_EQ(device.GetCount(NullOp::InvalidTransitions), invalidBefore + 1);
+    }
+
+    LUMI_TEST(NullSyncTimeline)
+    {
+        gfx::null::NullDevice device(QuietConfig(milliseconds(20)));
+        device.Init();
+        gfx::null::resources::NullSync sync(device);
+
+        LUMI_CHECK(sync.Wait(0));
+        LUMI_CHECK_EQ(sync.GetSignaledValue(), 0u);
+
+        uint64_t first = sync.Signal();
+        uint64_t second = sync.Signal();
+        LUMI_CHECK_EQ(first, 1u);
+        LUMI_CHECK_EQ(second, 2u);
+        LUMI_CHECK(!sync.IsComplete(first));
+
+        // Nothing signals a value past the last one, waiting on it fails instead of hanging
+        LUMI_CHECK(!sync.Wait(3, milliseconds(1)));
+        LUMI_CHECK(!sync.Wait(second, milliseconds(1)));
+
+        LUMI_CHECK(sync.Wait(first));
+        LUMI_CHECK(sync.IsComplete(first));
+        LUMI_CHECK(sync.WaitIdle());
+        LUMI_CHECK_EQ(sync.GetCompletedValue(), second);
+        LUMI_CHECK(device.GetCount(NullOp::GpuWaits) >= 2u);
+    }
+
+    LUMI_TEST(NullFramesOverlapUpToMaxInFlight)
+    {
+        // The simulated GPU is far slower than recording, so frames pile up until the latency cap holds them back
+        for (uint32_t maxInFlight = 1; maxInFlight <= 3; ++maxInFlight)
+        {
+            gfx::null::NullDevice device(QuietConfig(milliseconds(30)));
+            device.Init();
+            gfx::null::NullRenderTarget target(device, 64, 64);
+            gfx::null::render::NullRenderContext context(device);
+            LUMI_REQUIRE(target.Init(maxInFlight));
+            gfx::resources::ISync& sync = target.GetSync();
+
+            constexpr uint32_t kFrames = 6;
+            uint64_t mostInFlight = 0;
+            for (uint32_t frame = 0; frame < kFrames; ++frame)
+            {
+                RecordFrame(target, context, frame % maxInFlight);
+                uint64_t inFlight = sync.GetSignaledValue() - sync.GetCompletedValue();
+                mostInFlight = std::max(mostInFlight, inFlight);
+                LUMI_CHECK(inFlight <= maxInFlight);
+            }
+            LUMI_CHECK_EQ(mostInFlight, uint64_t(maxInFlight));
+
+            // Every frame after the first maxInFlight had to wait for the one that used its index before
+            LUMI_CHECK(device.GetCount(NullOp::GpuWaits) >= 1u);
+            LUMI_CHECK(device.GetCount(NullOp::GpuWaits) <= kFrames - maxInFlight);
+            LUMI_CHECK_EQ(device.GetCount(NullOp::InvalidTransitions), 0u);
+
+            target.Cleanup();
+            LUMI_CHECK(sync.IsComplete(sync.GetSignaledValue()));
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <core/radix_sort.h>
+#include "job_system_scope.h"
+#include "log_capture.h"
+#include "test.h"
+
+namespace lumi::test
+{
+    namespace
+    {
+        using core::SortEntry;
+
+        /* Big enough that the sort splits into a chunk per thread when the job system runs with 3 workers */
+        constexpr size_t kParallelCount = 4 * 32 * 1024 + 7;
+        constexpr uint32_t kWorkerCounts[] = { 0, 3 };
+
+        std::vector<SortEntry> MakeEntries(const size_t count, const uint64_t mask, const uint64_t constant)
+        {
+            std::mt19937_64 random(count);
+            std::vector<SortEntry> entries(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                entries[i] = { (random() & mask) | constant, static_cast<uint32_t>(i) };
+            }
+            return entries;
+        }
+
+        /* Sorts with the radix sort and std::stable_sort, both have to agree on every key and index */
+        bool SortsLikeStableSort(std::vector<SortEntry> entries)
+        {
+            std::vector<SortEntry> expected = entries;
+            std::stable_sort(expected.begin(), expected.end(),
+                [](const SortEntry& a, const SortEntry& b) { return a.key < b.key; });
+
+            std::vector<SortEntry> scratch(entries.size());
+            core::RadixSort(entries, scratch);
+            return std::equal(entries.begin(), entries.end(), expected.begin(), expected.end(),
+                [](const SortEntry& a, const SortEntry& b) { return a.key == b.key && a.index == b.index; });
+        }
+    }
+
+    LUMI_TEST(RadixSortMatchesStableSort)
+    {
+        for (uint32_t workers : kWorkerCounts)
+        {
+            JobSystemScope jobs(workers);
+            for (size_t count : { size_t(0), size_t(1), size_t(2), size_t(1000), kParallelCount })
+            {
+                LUMI_CHECK(SortsLikeStableSort(MakeEntries(count, ~0ull, 0)));
+            }
+        }
+    }
+
+    LUMI_TEST(RadixSortKeepsDuplicateKeysInOrder)
+    {
+        for (uint32_t workers : kWorkerCounts)
+        {
+            JobSystemScope jobs(workers);
+            // 64 different keys spread over every digit, so each key repeats thousands of times
+            std::vector<SortEntry> entries = MakeEntries(kParallelCount, 0, 0);
+            std::mt19937_64 random(7);
+            for (auto& entry : entries)
+            {
+                entry.key = (random() % 64) * 0x0102040810204081ull;
+            }
+            LUMI_CHECK(SortsLikeStableSort(entries));
+        }
+    }
+
+    LUMI_TEST(RadixSortSkipsConstantDigits)
+    {
+        for (uint32_t workers : kWorkerCounts)
+        {
+            JobSystemScope jobs(workers);
+            // One digit that varies sorts in a single pass and ends up in scratch, two sort back into the entries
+            LUMI_CHECK(SortsLikeStableSort(MakeEntries(kParallelCount, 0x7ffull << 22, 0xabc0000000000000ull)));
+            LUMI_CHECK(SortsLikeStableSort(MakeEntries(kParallelCount, 0x7ffull << 11 | 0x7ffull << 44, 1)));
+            // A digit where only some keys differ still has to be sorted
+            LUMI_CHECK(SortsLikeStableSort(MakeEntries(kParallelCount, 1ull << 63, 42)));
+
+            // No digit varies, nothing moves
+            std::vector<SortEntry> entries = MakeEntries(kParallelCount, 0, 0x123456789ull);
+            std::vector<SortEntry> scratch(entries.size());
+            core::RadixSort(entries, scratch);
+            LUMI_CHECK(std::all_of(entries.begin(), entries.end(), [&](const SortEntry& entry)
+            {
+                return entry.index == static_cast<uint32_t>(&entry - entries.data());
+            }));
+        }
+    }
+
+    LUMI_TEST(RadixSortNeedsEnoughScratch)
+    {
+        LogCapture log;
+        std::vector<SortEntry> entries = { { 3, 0 }, { 1, 1 }, { 2, 2 } };
+        std::vector<SortEntry> scratch(2);
+        core::RadixSort(entries, scratch);
+        LUMI_CHECK_EQ(entries[0].key, 3u);
+        LUMI_CHECK_EQ(entries[2].key, 2u);
+        LUMI_CHECK_EQ(log.Count("Radix sort of 3 entries was given scratch space for only 2"), 1u);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,388 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include <gfx/backends/null/null_device.h>
+#include <gfx/backends/null/null_render_target.h>
+#include <gfx/backends/null/render/null_render_context.h>
+#include <gfx/backends/null/resources/null_transient_allocator.h>
+#include <gfx/render/recording_render_context.h>
+#include <gfx/render/render_graph.h>
+#include "log_capture.h"
+#include "test.h"
+
+namespace lumi::test
+{
+    namespace
+    {
+        namespace render = gfx::render;
+        using gfx::null::NullOp;
+        using gfx::resources::ImageDesc;
+        using gfx::resources::ImageFormat;
+        using gfx::resources::ImageState;
+        using gfx::resources::ImageUsage;
+
+        /* A null device and target with a transient allocator, rendering frame 0 */
+        struct GraphFixture
+        {
+            gfx::null::NullDevice device;
+            gfx::null::NullRenderTarget target{device, 256, 256};
+            gfx::null::render::NullRenderContext context{device};
+            gfx::null::resources::NullTransientAllocator allocator{device};
+            render::RenderGraph graph;
+
+            GraphFixture()
+            {
+                gfx::null::NullDeviceConfig config;
+                config.logValidationErrors = false;
+                device.SetConfig(config);
+                device.Init();
+                target.Init(1);
+                target.StartRendering(0);
+                context.SetRenderTarget(target);
+                graph.SetTransientAllocator(&allocator);
+            }
+
+            static ImageDesc ColorDesc(const uint32_t size)
+            {
+                return { size, size, ImageFormat::RGBA8, ImageUsage::Render | ImageUsage::Shader };
+            }
+
+            /* Two transient images feeding the backbuffer, the way a frame that rebuilds its graph would add them */
+            void BuildChain()
+            {
+                render::RenderGraphImage backbuffer = graph.ImportImage("backbuffer", render::RenderGraph::ColorBuffer,
+                    ImageState::Present);
+                render::RenderGraphImage first = graph.CreateImage("first", ColorDesc(256));
+                render::RenderGraphImage second = graph.CreateImage("second", ColorDesc(256));
+                AddPass("first", first, ImageState::Color);
+                AddPass("second", second, ImageState::Color, first);
+                AddPass("resolve", backbuffer, ImageState::Color, second);
+            }
+
+            /* A pass for the target that writes output and optionally reads input */
+            void AddPass(const std::string& name, const render::RenderGraphImage output, const ImageState outputState,
+                const render::RenderGraphImage input = {})
+            {
+                render::RenderGraphPass pass;
+                pass.targets = { &target };
+                pass.writes = { { output, outputState } };
+                if (input.IsValid())
+                {
+                    pass.reads = { { input, ImageState::Shader } };
+                }
+                graph.NewPass(name, std::move(pass));
+            }
+        };
+    }
+
+    LUMI_TEST(RenderGraphTransientImagesOnNullAllocator)
+    {
+        GraphFixture fixture;
+        render::RenderGraph& graph = fixture.graph;
+
+        render::RenderGraphImage backbuffer = graph.ImportImage("backbuffer", render::RenderGraph::ColorBuffer,
+            ImageState::Present);
+        render::RenderGraphImage first = graph.CreateImage("first", GraphFixture::ColorDesc(256));
+        render::RenderGraphImage second = graph.CreateImage("second", GraphFixture::ColorDesc(128));
+        render::RenderGraphImage culled = graph.CreateImage("culled", GraphFixture::ColorDesc(64));
+
+        fixture.AddPass("first", first, ImageState::Color);
+        fixture.AddPass("second", second, ImageState::Color, first);
+        fixture.AddPass("resolve", backbuffer, ImageState::Color, second);
+        fixture.AddPass("unused", culled, ImageState::Color);
+
+        LUMI_REQUIRE(graph.Compile());
+        LUMI_CHECK_EQ(graph.GetCompiledPassCount(), 3u);
+
+        gfx::resources::IImageBuffer* firstImage = graph.GetTransientImage(first);
+        gfx::resources::IImageBuffer* secondImage = graph.GetTransientImage(second);
+        LUMI_REQUIRE(firstImage && secondImage);
+        LUMI_CHECK(firstImage != secondImage);
+        LUMI_CHECK_EQ(firstImage->GetWidth(), 256u);
+        LUMI_CHECK_EQ(secondImage->GetWidth(), 128u);
+
+        // Culled, imported and unknown handles have no transient image behind them
+        LUMI_CHECK(graph.GetTransientImage(culled) == nullptr);
+        LUMI_CHECK(graph.GetTransientImage(backbuffer) == nullptr);
+        LUMI_CHECK(graph.GetTransientImage({}) == nullptr);
+        LUMI_CHECK(graph.GetTransientImage({ 100 }) == nullptr);
+
+        // Both are alive in the second pass, so they can't share memory
+        const render::TransientPlan& plan = graph.GetTransientPlan();
+        LUMI_REQUIRE(plan.offsets.size() == 2);
+        LUMI_CHECK(plan.offsets[0] != plan.offsets[1]);
+        LUMI_CHECK_EQ(plan.heapSize, plan.unaliasedSize);
+        LUMI_CHECK_EQ(fixture.allocator.GetHeapSize(), plan.heapSize);
+        LUMI_CHECK_EQ(fixture.device.GetCount(NullOp::HeapsReserved), 1u);
+
+        graph.Execute(fixture.context);
+        LUMI_CHECK_EQ(firstImage->GetState(), ImageState::Shader);
+        LUMI_CHECK_EQ(secondImage->GetState(), ImageState::Shader);
+        LUMI_CHECK_EQ(fixture.device.GetCount(NullOp::InvalidTransitions), 0u);
+    }
+
+    LUMI_TEST(RenderGraphTransientImagesShareMemory)
+    {
+        GraphFixture fixture;
+        render::RenderGraph& graph = fixture.graph;
+
+        // A chain where each image is only alive for the pass that writes it and the one reading it
+        render::RenderGraphImage backbuffer = graph.ImportImage("backbuffer", render::RenderGraph::ColorBuffer,
+            ImageState::Present);
+        render::RenderGraphImage a = graph.CreateImage("a", GraphFixture::ColorDesc(256));
+        render::RenderGraphImage b = graph.CreateImage("b", GraphFixture::ColorDesc(256));
+        render::RenderGraphImage c = graph.CreateImage("c", GraphFixture::ColorDesc(256));
+        fixture.AddPass("a", a, ImageState::Color);
+        fixture.AddPass("b", b, ImageState::Color, a);
+        fixture.AddPass("c", c, ImageState::Color, b);
+        fixture.AddPass("resolve", backbuffer, ImageState::Color, c);
+
+        LUMI_REQUIRE(graph.Compile());
+        const render::TransientPlan& plan = graph.GetTransientPlan();
+        LUMI_REQUIRE(plan.offsets.size() == 3);
+        LUMI_CHECK_EQ(plan.offsets[0], plan.offsets[2]);
+        LUMI_CHECK(plan.heapSize < plan.unaliasedSize);
+        LUMI_CHECK_EQ(plan.heapSize, plan.peakLiveSize);
+        LUMI_CHECK(graph.GetTransientImage(a) != graph.GetTransientImage(c));
+    }
+
+    LUMI_TEST(RenderGraphTransientImagesNeedAllocator)
+    {
+        GraphFixture fixture;
+        render::RenderGraph& graph = fixture.graph;
+        graph.SetTransientAllocator(nullptr);
+
+        render::RenderGraphImage backbuffer = graph.ImportImage("backbuffer", render::RenderGraph::ColorBuffer,
+            ImageState::Present);
+        render::RenderGraphImage image = graph.CreateImage("image", GraphFixture::ColorDesc(256));
+        fixture.AddPass("image", image, ImageState::Color);
+        fixture.AddPass("resolve", backbuffer, ImageState::Color, image);
+
+        LUMI_CHECK(!graph.Compile());
+        LUMI_CHECK(graph.GetTransientImage(image) == nullptr);
+    }
+    LUMI_TEST(RenderGraphFailedCompileWaitsForChange)
+    {
+        LogCapture log;
+        GraphFixture fixture;
+        render::RenderGraph& graph = fixture.graph;
+        graph.SetTransientAllocator(nullptr);
+
+        // Rebuilt every frame the way it failed, it compiles and reports once
+        for (int frame = 0; frame < 3; ++frame)
+        {
+            graph.Clear();
+            render::RenderGraphImage backbuffer = graph.ImportImage("backbuffer", render::RenderGraph::ColorBuffer,
+                ImageState::Present);
+            render::RenderGraphImage image = graph.CreateImage("unallocated", GraphFixture::ColorDesc(256));
+            fixture.AddPass("unallocated", image, ImageState::Color);
+            fixture.AddPass("resolve", backbuffer, ImageState::Color, image);
+            fixture.AddPass("resolve", backbuffer, ImageState::Color, image);
+            graph.Execute(fixture.context);
+        }
+        LUMI_CHECK_EQ(graph.GetCompileCount(), 1u);
+        LUMI_CHECK_EQ(graph.GetCompiledPassCount(), 0u);
+        LUMI_CHECK_EQ(log.Count("Graph image unallocated is transient but no transient allocator was set"), 1u);
+        LUMI_CHECK_EQ(log.Count("Attempted to add a graph pass called resolve"), 1u);
+
+        // Setting an allocator is a change, the same structure compiles again and now succeeds
+        graph.SetTransientAllocator(&fixture.allocator);
+        graph.Execute(fixture.context);
+        LUMI_CHECK_EQ(graph.GetCompileCount(), 2u);
+        LUMI_CHECK_EQ(graph.GetCompiledPassCount(), 2u);
+        LUMI_CHECK(graph.GetTransientImage({ 1 }) != nullptr);
+    }
+
+    LUMI_TEST(RenderGraphAliasesTransientImagesEveryFrame)
+    {
+        GraphFixture fixture;
+        render::RenderGraph& graph = fixture.graph;
+
+        render::RenderGraphImage backbuffer = graph.ImportImage("backbuffer", render::RenderGraph::ColorBuffer,
+            ImageState::Present);
+        render::RenderGraphImage a = graph.CreateImage("a", GraphFixture::ColorDesc(256));
+        render::RenderGraphImage b = graph.CreateImage("b", GraphFixture::ColorDesc(256));
+        fixture.AddPass("a", a, ImageState::Color);
+        fixture.AddPass("b", b, ImageState::Color, a);
+        fixture.AddPass("resolve", backbuffer, ImageState::Color, b);
+
+        // Only ever used as a render target, so it starts every frame in the state the last one left it in
+        render::RenderGraphImage scratch = graph.CreateImage("scratch", GraphFixture::ColorDesc(64));
+        render::RenderGraphPass pass;
+        pass.targets = { &fixture.target };
+        pass.writes = { { scratch, ImageState::Color } };
+        pass.sideEffects = true;
+        graph.NewPass("scratch", std::move(pass));
+
+        graph.Execute(fixture.context);
+        LUMI_CHECK_EQ(fixture.device.GetCount(NullOp::Aliases), 3u);
+        LUMI_REQUIRE(graph.GetTransientImage(scratch));
+        LUMI_CHECK_EQ(graph.GetTransientImage(scratch)->GetState(), ImageState::Color);
+
+        // The memory was shared since the last frame, so every image is aliased again, even one already in its state
+        graph.Execute(fixture.context);
+        LUMI_CHECK_EQ(fixture.device.GetCount(NullOp::Aliases), 6u);
+        LUMI_CHECK_EQ(fixture.device.GetCount(NullOp::InvalidTransitions), 0u);
+        LUMI_CHECK_EQ(fixture.device.GetCount(NullOp::InvalidRecordings), 0u);
+    }
+
+    LUMI_TEST(RenderGraphAliasesThroughRecordedCommands)
+    {
+        GraphFixture fixture;
+        render::RenderGraph& graph = fixture.graph;
+
+        render::RenderGraphImage backbuffer = graph.ImportImage("backbuffer", render::RenderGraph::ColorBuffer,
+            ImageState::Present);
+        render::RenderGraphImage image = graph.CreateImage("image", GraphFixture::ColorDesc(256));
+        fixture.AddPass("image", image, ImageState::Color);
+        fixture.AddPass("resolve", backbuffer, ImageState::Color, image);
+
+        render::RecordingRenderContext recorder(fixture.target, 0);
+        const render::CommandBuffer& commands = recorder.GetCommandBuffer();
+        graph.Execute(recorder);
+        LUMI_CHECK_EQ(fixture.device.GetCount(NullOp::Aliases), 0u);
+
+        size_t aliases = 0;
+        for (const render::CommandHeader& command : commands)
+        {
+            aliases += command.type == render::CommandType::Alias ? 1 : 0;
+        }
+        LUMI_CHECK_EQ(aliases, 1u);
+
+        fixture.context.Execute(commands);
+        LUMI_CHECK_EQ(fixture.device.GetCount(NullOp::Aliases), 1u);
+        LUMI_REQUIRE(graph.GetTransientImage(image));
+        LUMI_CHECK_EQ(graph.GetTransientImage(image)->GetState(), ImageState::Shader);
+    }
+    LUMI_TEST(RenderGraphRebuildReusesTransientImages)
+    {
+        GraphFixture fixture;
+        render::RenderGraph& graph = fixture.graph;
+        fixture.BuildChain();
+        graph.Execute(fixture.context);
+        gfx::resources::IImageBuffer* first = graph.GetTransientImage({ 1 });
+        gfx::resources::IImageBuffer* second = graph.GetTransientImage({ 2 });
+        LUMI_REQUIRE(first && second);
+
+        graph.Clear();
+        fixture.BuildChain();
+        graph.Execute(fixture.context);
+        LUMI_CHECK_EQ(graph.GetCompileCount(), 1u);
+        LUMI_CHECK_EQ(graph.GetCacheHitCount(), 1u);
+        LUMI_CHECK(graph.GetTransientImage({ 1 }) == first);
+        LUMI_CHECK(graph.GetTransientImage({ 2 }) == second);
+    }
+
+    LUMI_TEST(RenderGraphClearTwiceKeepsTransientImages)
+    {
+        GraphFixture fixture;
+        render::RenderGraph& graph = fixture.graph;
+        fixture.BuildChain();
+        graph.Execute(fixture.context);
+        gfx::resources::IImageBuffer* first = graph.GetTransientImage({ 1 });
+
+        // The second clear has no images left, it must not drop the ones the first clear kept
+        graph.Clear();
+        graph.Clear();
+        fixture.BuildChain();
+        graph.Execute(fixture.context);
+        LUMI_CHECK_EQ(graph.GetCompileCount(), 1u);
+        LUMI_CHECK_EQ(graph.GetCacheHitCount(), 1u);
+        LUMI_CHECK(graph.GetTransientImage({ 1 }) == first);
+        LUMI_CHECK(graph.GetTransientImage({ 2 }) != nullptr);
+        LUMI_CHECK_EQ(fixture.device.GetCount(NullOp::InvalidRecordings), 0u);
+    }
+
+    LUMI_TEST(RenderGraphClearAfterRebuildKeepsTransientImages)
+    {
+        GraphFixture fixture;
+        render::RenderGraph& graph = fixture.graph;
+        fixture.BuildChain();
+        graph.Execute(fixture.context);
+        gfx::resources::IImageBuffer* first = graph.GetTransientImage({ 1 });
+
+        // Rebuilt but never executed, so the rebuilt images don't hold the retained buffers yet
+        graph.Clear();
+        fixture.BuildChain();
+        graph.Clear();
+        fixture.BuildChain();
+        graph.Execute(fixture.context);
+        LUMI_CHECK_EQ(graph.GetCompileCount(), 1u);
+        LUMI_CHECK_EQ(graph.GetCacheHitCount(), 1u);
+        LUMI_CHECK(graph.GetTransientImage({ 1 }) == first);
+        LUMI_CHECK(graph.GetTransientImage({ 2 }) != nullptr);
+    }
+
+    LUMI_TEST(RenderGraphChangedStructureCompilesAgain)
+    {
+        GraphFixture fixture;
+        render::RenderGraph& graph = fixture.graph;
+        fixture.BuildChain();
+        graph.Execute(fixture.context);
+
+        // Same passes, but the second image is read by the resolve in a different state
+        graph.Clear();
+        render::RenderGraphImage backbuffer = graph.ImportImage("backbuffer", render::RenderGraph::ColorBuffer,
+            ImageState::Present);
+        render::RenderGraphImage first = graph.CreateImage("first", GraphFixture::ColorDesc(256));
+        render::RenderGraphImage second = graph.CreateImage("second", GraphFixture::ColorDesc(128));
+        fixture.AddPass("first", first, ImageState::Color);
+        fixture.AddPass("second", second, ImageState::Color, first);
+        fixture.AddPass("resolve", backbuffer, ImageState::Color, second);
+        graph.Execute(fixture.context);
+
+        LUMI_CHECK_EQ(graph.GetCompileCount(), 2u);
+        LUMI_CHECK_EQ(graph.GetCacheHitCount(), 0u);
+        LUMI_REQUIRE(graph.GetTransientImage(second));
+        LUMI_CHECK_EQ(graph.GetTransientImage(second)->GetWidth(), 128u);
+    }
+
+    LUMI_TEST(RenderGraphOrdersPingPongChain)
+    {
+        GraphFixture fixture;
+        render::RenderGraph& graph = fixture.graph;
+
+        // Post-processing that reads one image and overwrites the other, then goes back to the first one
+        render::RenderGraphImage backbuffer = graph.ImportImage("backbuffer", render::RenderGraph::ColorBuffer,
+            ImageState::Present);
+        render::RenderGraphImage x = graph.CreateImage("x", GraphFixture::ColorDesc(256));
+        render::RenderGraphImage y = graph.CreateImage("y", GraphFixture::ColorDesc(256));
+        fixture.AddPass("p0", x, ImageState::Color);
+        fixture.AddPass("p1", y, ImageState::Color, x);
+        fixture.AddPass("p2", x, ImageState::Color, y);
+        fixture.AddPass("final", backbuffer, ImageState::Color, x);
+
+        LUMI_REQUIRE(graph.Compile());
+        std::vector<std::string> expected = { "p0", "p1", "p2", "final" };
+        LUMI_CHECK(graph.GetCompiledOrder() == expected);
+
+        // x goes Color, Shader, Color, Shader, every change planned between the passes
+        graph.Execute(fixture.context);
+        LUMI_CHECK_EQ(fixture.device.GetCount(NullOp::InvalidTransitions), 0u);
+        LUMI_CHECK_EQ(fixture.device.GetCount(NullOp::InvalidRecordings), 0u);
+        LUMI_REQUIRE(graph.GetTransientImage(x));
+        LUMI_CHECK_EQ(graph.GetTransientImage(x)->GetState(), ImageState::Shader);
+    }
+
+    LUMI_TEST(RenderGraphReadBeforeWriteSeesEarlierContents)
+    {
+        GraphFixture fixture;
+        render::RenderGraph& graph = fixture.graph;
+
+        // history is read before this frame overwrites it, so the read runs first instead of forming a cycle
+        render::RenderGraphImage backbuffer = graph.ImportImage("backbuffer", render::RenderGraph::ColorBuffer,
+            ImageState::Present);
+        render::RenderGraphImage history = graph.ImportImage("history", render::RenderGraph::DepthBuffer,
+            ImageState::DepthStencil);
+        render::RenderGraphPass resolve;
+        resolve.targets = { &fixture.target };
+        resolve.reads = { { history, ImageState::Shader } };
+        resolve.writes = { { backbuffer, ImageState::Color } };
+        graph.NewPass("resolve", std::move(resolve));
+        fixture.AddPass("history", history, ImageState::DepthStencil);
+
+        LUMI_REQUIRE(graph.Compile());
+        std::vector<std::string> expected = { "resolve", "history" };
+        LUMI_CHECK(graph.GetCompiledOrder() == expected);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include <gfx/render/render_orchestrator.h>
+#include "test.h"
+
+namespace lumi::test
+{
+    namespace
+    {
+        namespace render = gfx::render;
+
+        render::PassHandle AddPass(render::RenderOrchestrator& orchestrator, const std::string_view name)
+        {
+            return orchestrator.NewPass(name, {}, [](gfx::render::IRenderContext&, gfx::IRenderTarget*) {});
+        }
+    }
+
+    LUMI_TEST(OrchestratorResolvesPassHandles)
+    {
+        render::RenderOrchestrator orchestrator;
+        render::PassHandle main = AddPass(orchestrator, "main");
+        render::PassHandle post = AddPass(orchestrator, "post");
+        LUMI_REQUIRE(main.IsValid() && post.IsValid());
+
+        LUMI_CHECK(orchestrator.GetPass(main) != nullptr);
+        LUMI_CHECK_EQ(orchestrator.GetPassName(post), std::string_view("post"));
+        LUMI_CHECK_EQ(orchestrator.FindPass("post").index, post.index);
+        LUMI_CHECK(orchestrator.GetPass(orchestrator.FindPass("post")) != nullptr);
+
+        // A second pass with the same name isn't added
+        LUMI_CHECK(!AddPass(orchestrator, "main").IsValid());
+        LUMI_CHECK(orchestrator.GetPass({}) == nullptr);
+        LUMI_CHECK(orchestrator.GetPassName({}).empty());
+        LUMI_CHECK(!orchestrator.FindPass("shadows").IsValid());
+    }
+
+    LUMI_TEST(OrchestratorRejectsHandlesFromBeforeClear)
+    {
+        render::RenderOrchestrator orchestrator;
+        render::PassHandle stale = AddPass(orchestrator, "main");
+        orchestrator.Clear();
+        LUMI_CHECK(orchestrator.GetPass(stale) == nullptr);
+        LUMI_CHECK(orchestrator.GetPassName(stale).empty());
+
+        // The new pass gets the same interned id, the old handle still must not reach it
+        render::PassHandle shadows = AddPass(orchestrator, "shadows");
+        LUMI_REQUIRE(shadows.IsValid());
+        LUMI_CHECK_EQ(shadows.index, stale.index);
+        LUMI_CHECK(orchestrator.GetPass(stale) == nullptr);
+        LUMI_CHECK(orchestrator.GetPassName(stale).empty());
+        LUMI_CHECK(orchestrator.GetPass(shadows) != nullptr);
+        LUMI_CHECK_EQ(orchestrator.GetPassName(shadows), std::string_view("shadows"));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include <chrono>
+#include <gfx/backends/null/null_device.h>
+#include <gfx/backends/null/null_render_target.h>
+#include <gfx/resize_policy.h>
+#include "test.h"
+
+namespace lumi::test
+{
+    namespace
+    {
+        using gfx::null::NullOp;
+        using Clock = gfx::ResizePolicy::Clock;
+        using std::chrono::milliseconds;
+
+        /* An 800x600 null target whose resize policy runs on a pinned clock, starting at 0ms */
+        struct ResizeFixture
+        {
+            gfx::null::NullDevice device;
+            gfx::null::NullRenderTarget target{device, 800, 600};
+            Clock::time_point start = Clock::now();
+
+            ResizeFixture()
+            {
+                gfx::null::NullDeviceConfig config;
+                config.logValidationErrors = false;
+                device.SetConfig(config);
+                device.Init();
+
+                gfx::ResizePolicyConfig policy;
+                policy.minRebuildInterval = milliseconds(100);
+                policy.settleTime = milliseconds(250);
+                target.SetResizePolicy(policy);
+                target.PinTime(start);
+                target.Init(1);
+            }
+
+            /* Renders a frame at ms after the start */
+            void Frame(const int64_t ms)
+            {
+                target.PinTime(start + milliseconds(ms));
+                target.StartRendering(0);
+                target.EndRendering(0);
+                target.SubmitRendering(0);
+            }
+
+            [[nodiscard]] uint64_t GetResizes() const { return device.GetCount(NullOp::Resizes); }
+            [[nodiscard]] uint32_t GetBufferWidth() { return target.GetColorBuffer(0)->GetWidth(); }
+            [[nodiscard]] uint32_t GetBufferHeight() { return target.GetColorBuffer(0)->GetHeight(); }
+        };
+    }
+
+    LUMI_TEST(ResizePolicyCoalescesRequests)
+    {
+        ResizeFixture fixture;
+
+        // The target was just built, so growing waits for minRebuildInterval and only the last size is built
+        fixture.target.SetRequestedSize(900, 700);
+        fixture.Frame(10);
+        fixture.target.SetRequestedSize(1000, 800);
+        fixture.Frame(50);
+        fixture.target.SetRequestedSize(1100, 900);
+        fixture.target.SetRequestedSize(1200, 1000);
+        fixture.Frame(90);
+        LUMI_CHECK_EQ(fixture.GetResizes(), 0u);
+        LUMI_CHECK(fixture.target.GetResizePolicy().IsPending());
+
+        // Frames render into the old buffers meanwhile
+        LUMI_CHECK_EQ(fixture.target.GetWidth(), 800);
+        LUMI_CHECK_EQ(fixture.target.GetHeight(), 600);
+
+        fixture.Frame(100);
+        LUMI_CHECK_EQ(fixture.GetResizes(), 1u);
+        LUMI_CHECK_EQ(fixture.GetBufferWidth(), 1200u);
+        LUMI_CHECK_EQ(fixture.GetBufferHeight(), 1000u);
+        LUMI_CHECK_EQ(fixture.target.GetWidth(), 1200);
+        LUMI_CHECK(!fixture.target.GetResizePolicy().IsPending());
+
+        fixture.Frame(500);
+        LUMI_CHECK_EQ(fixture.GetResizes(), 1u);
+    }
+
+    LUMI_TEST(ResizePolicyGatesRebuildsByMinInterval)
+    {
+        ResizeFixture fixture;
+        fixture.target.SetRequestedSize(1000, 800);
+        fixture.Frame(100);
+        LUMI_REQUIRE(fixture.GetResizes() == 1u);
+
+        // The next growth is held back until 100ms after the rebuild it follows
+        fixture.target.SetRequestedSize(1100, 900);
+        fixture.Frame(150);
+        fixture.Frame(199);
+        LUMI_CHECK_EQ(fixture.GetResizes(), 1u);
+        fixture.Frame(200);
+        LUMI_CHECK_EQ(fixture.GetResizes(), 2u);
+        LUMI_CHECK_EQ(fixture.GetBufferWidth(), 1100u);
+    }
+
+    LUMI_TEST(ResizePolicyShrinkWaitsToSettle)
+    {
+        ResizeFixture fixture;
+
+        // Shrinking fits in the buffers, so it renders into their corner until the size stops changing
+        fixture.target.SetRequestedSize(640, 480);
+        fixture.Frame(200);
+        LUMI_CHECK_EQ(fixture.GetResizes(), 0u);
+        LUMI_CHECK_EQ(fixture.target.GetWidth(), 640);
+        LUMI_CHECK_EQ(fixture.target.GetHeight(), 480);
+        LUMI_CHECK_EQ(fixture.GetBufferWidth(), 800u);
+
+        // Another request restarts the wait
+        fixture.target.SetRequestedSize(600, 400);
+        fixture.Frame(300);
+        fixture.Frame(449);
+        fixture.Frame(549);
+        LUMI_CHECK_EQ(fixture.GetResizes(), 0u);
+        LUMI_CHECK_EQ(fixture.target.GetWidth(), 600);
+
+        fixture.Frame(550);
+        LUMI_CHECK_EQ(fixture.GetResizes(), 1u);
+        LUMI_CHECK_EQ(fixture.GetBufferWidth(), 600u);
+        LUMI_CHECK_EQ(fixture.GetBufferHeight(), 400u);
+    }
+
+    LUMI_TEST(ResizePolicyGrowsPastBuffersImmediately)
+    {
+        ResizeFixture fixture;
+        fixture.Frame(1000);
+
+        // Once minRebuildInterval passed, outgrowing the buffers doesn't wait to settle
+        fixture.target.SetRequestedSize(801, 600);
+        fixture.Frame(1000);
+        LUMI_CHECK_EQ(fixture.GetResizes(), 1u);
+        LUMI_CHECK_EQ(fixture.GetBufferWidth(), 801u);
+
+        // Growing in one direction while shrinking in the other doesn't fit either
+        fixture.target.SetRequestedSize(700, 900);
+        fixture.Frame(1100);
+        LUMI_CHECK_EQ(fixture.GetResizes(), 2u);
+        LUMI_CHECK_EQ(fixture.GetBufferWidth(), 700u);
+        LUMI_CHECK_EQ(fixture.GetBufferHeight(), 900u);
+    }
+
+    LUMI_TEST(ResizePolicyIgnoresEmptySizes)
+    {
+        ResizeFixture fixture;
+
+        // A minimized window reports an empty size, the buffers are kept for when it's restored
+        fixture.target.SetRequestedSize(0, 0);
+        fixture.Frame(1000);
+        fixture.target.SetRequestedSize(800, 0);
+        fixture.Frame(2000);
+        LUMI_CHECK_EQ(fixture.GetResizes(), 0u);
+        LUMI_CHECK(!fixture.target.GetResizePolicy().IsPending());
+        LUMI_CHECK_EQ(fixture.target.GetWidth(), 800);
+        LUMI_CHECK_EQ(fixture.target.GetHeight(), 600);
+
+        fixture.target.SetRequestedSize(800, 600);
+        fixture.Frame(3000);
+        LUMI_CHECK_EQ(fixture.GetResizes(), 0u);
+    }
+
+    LUMI_TEST(ResizePolicyForcesRebuildOnFormatChange)
+    {
+        ResizeFixture fixture;
+
+        // A format change needs new buffers even at the same size, and doesn't wait for minRebuildInterval
+        fixture.target.SetFormatChanged();
+        fixture.Frame(10);
+        LUMI_CHECK_EQ(fixture.GetResizes(), 1u);
+        LUMI_CHECK_EQ(fixture.GetBufferWidth(), 800u);
+        LUMI_CHECK(!fixture.target.GetResizePolicy().IsPending());
+
+        // It takes the pending size along, a shrink still settling is built right away
+        fixture.target.SetRequestedSize(640, 480);
+        fixture.Frame(200);
+        LUMI_CHECK_EQ(fixture.GetResizes(), 1u);
+        fixture.target.SetFormatChanged();
+        fixture.Frame(210);
+        LUMI_CHECK_EQ(fixture.GetResizes(), 2u);
+        LUMI_CHECK_EQ(fixture.GetBufferWidth(), 640u);
+
+        fixture.Frame(220);
+        LUMI_CHECK_EQ(fixture.GetResizes(), 2u);
+    }
+
+    LUMI_TEST(ResizePolicyDecisionsFromInjectedTime)
+    {
+        // The policy on its own, without a target rebuilding in between
+        gfx::ResizePolicy policy;
+        policy.SetConfig({ milliseconds(100), milliseconds(250) });
+        Clock::time_point start{};
+        policy.Request(800, 600, start);
+        policy.Reset(800, 600, start);
+        LUMI_CHECK(!policy.IsPending());
+
+        policy.Request(400, 300, start + milliseconds(10));
+        LUMI_CHECK(policy.IsPending());
+        LUMI_CHECK(!policy.ShouldRebuild(start + milliseconds(259)));
+        LUMI_CHECK(policy.ShouldRebuild(start + milliseconds(260)));
+
+        // Requesting the buffers' size again cancels the pending shrink
+        policy.Request(800, 600, start + milliseconds(300));
+        LUMI_CHECK(!policy.IsPending());
+        LUMI_CHECK(!policy.ShouldRebuild(start + milliseconds(1000)));
+
+        policy.Force();
+        LUMI_CHECK(policy.ShouldRebuild(start + milliseconds(300)));
+        policy.Reset(800, 600, start + milliseconds(300));
+        LUMI_CHECK(!policy.ShouldRebuild(start + milliseconds(300)));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <gfx/backends/null/null_device.h>
+#include <gfx/backends/null/render/null_render_context.h>
+#include <gfx/render/submission_queue.h>
+#include "job_system_scope.h"
+#include "test.h"
+
+namespace lumi::test
+{
+    namespace
+    {
+        namespace render = gfx::render;
+
+        /* A queue whose submissions write their id to executed when they run */
+        struct QueueFixture
+        {
+            gfx::null::NullDevice device;
+            gfx::null::render::NullRenderContext context{device};
+            render::SubmissionQueue queue;
+            std::vector<uint32_t> executed;
+
+            QueueFixture() { device.Init(); }
+
+            void Submit(const uint64_t key, const uint32_t id)
+            {
+                queue.Submit(key, [this, id](render::IRenderContext&) { executed.push_back(id); });
+            }
+        };
+
+        /* Ids in the order a stable sort of keys puts them, ids being the submission order */
+        std::vector<uint32_t> StableOrder(const std::vector<uint64_t>& keys)
+        {
+            std::vector<uint32_t> ids(keys.size());
+            for (uint32_t i = 0; i < ids.size(); ++i)
+            {
+                ids[i] = i;
+            }
+            std::stable_sort(ids.begin(), ids.end(), [&](const uint32_t a, const uint32_t b) { return keys[a] < keys[b]; });
+            return ids;
+        }
+    }
+
+    LUMI_TEST(SubmissionQueueExecutesInKeyOrder)
+    {
+        QueueFixture fixture;
+        render::SubmissionKey shadow{ .pass = 0, .pipeline = 3, .depth = 0.5f };
+        render::SubmissionKey nearOpaque{ .pass = 1, .pipeline = 1, .depth = 0.1f };
+        render::SubmissionKey farOpaque{ .pass = 1, .pipeline = 1, .depth = 0.9f };
+        render::SubmissionKey otherPipeline{ .pass = 1, .pipeline = 2, .depth = 0.0f };
+
+        fixture.Submit(otherPipeline.Pack(), 0);
+        fixture.Submit(farOpaque.Pack(), 1);
+        fixture.Submit(nearOpaque.Pack(), 2);
+        fixture.Submit(shadow.Pack(), 3);
+        // Equal keys run in the order they were submitted
+        fixture.Submit(nearOpaque.Pack(), 4);
+        fixture.Submit(shadow.Pack(), 5);
+        fixture.queue.Execute(fixture.context);
+
+        LUMI_CHECK(fixture.executed == std::vector<uint32_t>({ 3, 5, 2, 4, 1, 0 }));
+
+        // The queue keeps its submissions until cleared, running them again keeps the order
+        fixture.executed.clear();
+        fixture.queue.Execute(fixture.context);
+        LUMI_CHECK(fixture.executed == std::vector<uint32_t>({ 3, 5, 2, 4, 1, 0 }));
+
+        fixture.executed.clear();
+        fixture.queue.Clear();
+        fixture.Submit(farOpaque.Pack(), 6);
+        fixture.Submit(shadow.Pack(), 7);
+        fixture.queue.Execute(fixture.context);
+        LUMI_CHECK(fixture.executed == std::vector<uint32_t>({ 7, 6 }));
+    }
+
+    LUMI_TEST(SubmissionQueueKeepsSubmissionOrderForEqualKeys)
+    {
+        for (uint32_t workers : { 0u, 3u })
+        {
+            JobSystemScope jobs(workers);
+            QueueFixture fixture;
+
+            // Enough submissions for a parallel sort, few enough keys that every key repeats
+            std::mt19937 random(workers);
+            std::vector<uint64_t> keys(200 * 1024);
+            for (auto& key : keys)
+            {
+                render::SubmissionKey submission;
+                submission.pass = static_cast<uint32_t>(random() % 4);
+                submission.material = static_cast<uint32_t>(random() % 100);
+                key = submission.Pack();
+            }
+            fixture.queue.Reserve(keys.size());
+            for (uint32_t i = 0; i < keys.size(); ++i)
+            {
+                fixture.Submit(keys[i], i);
+            }
+            fixture.queue.Execute(fixture.context);
+
+            LUMI_CHECK_EQ(fixture.executed.size(), keys.size());
+            LUMI_CHECK(fixture.executed == StableOrder(keys));
+        }
+    }
+}
\ No newline at end of file
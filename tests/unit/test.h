@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace lumi::test
+{
+    using TestFunction = void(*)();
+
+    /**
+     * \brief Adds a test to the suite
+     * \note Use LUMI_TEST instead of calling this
+     */
+    bool RegisterTest(const char* name, TestFunction function);
+
+    /* Fails the running test, it keeps running so one run reports every failed check */
+    void ReportFailure(const char* file, int line, const std::string& message);
+
+    /* Prints a checked value, values that can't be printed show as "?" */
+    template<typename T>
+    std::string ToString(const T& value)
+    {
+        std::ostringstream stream;
+        if constexpr (std::is_enum_v<T>)
+        {
+            stream << static_cast<int64_t>(value);
+        }
+        else if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>)
+        {
+            stream << static_cast<const void*>(value);
+        }
+        else if constexpr (requires(std::ostream& out) { out << value; })
+        {
+            stream << value;
+        }
+        else
+        {
+            stream << "?";
+        }
+        return stream.str();
+    }
+
+    template<typename A, typename B>
+    bool CheckEqual(const A& actual, const B& expected, const char* actualText, const char* expectedText,
+        const char* file, const int line)
+    {
+        if (actual == expected)
+        {
+            return true;
+        }
+        ReportFailure(file, line, std::string(actualText) + " == " + expectedText + ", got " + ToString(actual)
+            + " and " + ToString(expected));
+        return false;
+    }
+}
+
+#define LUMI_TEST_CONCAT_INNER(a, b) a##b
+#define LUMI_TEST_CONCAT(a, b) LUMI_TEST_CONCAT_INNER(a, b)
+
+/* Declares and registers a test, the body follows like a function's */
+#define LUMI_TEST(name) \
+    static void name(); \
+    static const bool LUMI_TEST_CONCAT(lumiTestRegistered, __LINE__) = ::lumi::test::RegisterTest(#name, name); \
+    static void name()
+
+/* Fails the test if the condition is false */
+#define LUMI_CHECK(condition) \
+    ((condition) ? true : (::lumi::test::ReportFailure(__FILE__, __LINE__, #condition), false))
+
+/* Fails the test if the values differ, printing both */
+#define LUMI_CHECK_EQ(actual, expected) \
+    ::lumi::test::CheckEqual((actual), (expected), #actual, #expected, __FILE__, __LINE__)
+
+/* Fails the test and returns from it if the condition is false, for checks the rest of the test relies on */
+#define LUMI_REQUIRE(condition) \
+    do { if (!LUMI_CHECK(condition)) return; } while (false)
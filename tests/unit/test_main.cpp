@@ -0,0 +1,94 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <debugging/logger.h>
+#include "test.h"
+
+/**
+ * lumi_tests [options]
+ *   --filter <text>      Only run tests whose name contains text
+ *   --verbose            Keeps the engine's console log output
+ * Exits with 1 when a test failed.
+ */
+
+namespace lumi::test
+{
+    namespace
+    {
+        struct TestDefinition
+        {
+            std::string name;
+            TestFunction function;
+        };
+
+        std::vector<TestDefinition>& GetRegistry()
+        {
+            static std::vector<TestDefinition> registry;
+            return registry;
+        }
+
+        uint32_t failures = 0;
+    }
+
+    bool RegisterTest(const char* name, const TestFunction function)
+    {
+        GetRegistry().push_back({ name, function });
+        return true;
+    }
+
+    void ReportFailure(const char* file, const int line, const std::string& message)
+    {
+        std::printf("  %s:%d: check failed: %s\n", file, line, message.c_str());
+        ++failures;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace lumi::test;
+
+    std::string filter;
+    bool verbose = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) filter = argv[++i];
+        else if (arg == "--verbose") verbose = true;
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+            return 2;
+        }
+    }
+
+    // Tests hit error paths on purpose, their log output would bury the results
+    if (!verbose)
+    {
+        lumi::debugging::Logger::Instance().ClearSinks();
+    }
+
+    uint32_t run = 0;
+    uint32_t failed = 0;
+    for (const auto& test : GetRegistry())
+    {
+        if (!filter.empty() && test.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        uint32_t failuresBefore = failures;
+        auto start = std::chrono::steady_clock::now();
+        test.function();
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        bool passed = failures == failuresBefore;
+        std::printf("[%s] %s (%.1f ms)\n", passed ? "  OK  " : " FAIL ", test.name.c_str(), elapsed);
+        std::fflush(stdout);
+        ++run;
+        failed += passed ? 0 : 1;
+    }
+
+    std::printf("%u test(s) run, %u failed\n", run, failed);
+    return failed > 0 ? 1 : 0;
+}
\ No newline at end of file
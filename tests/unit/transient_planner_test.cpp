@@ -0,0 +1,145 @@
+#include <vector>
+#include <gfx/render/transient_planner.h>
+#include "test.h"
+
+namespace lumi::test
+{
+    namespace
+    {
+        using gfx::render::PlanTransientResources;
+        using gfx::render::TransientPlan;
+        using gfx::render::TransientResource;
+
+        /* Whether two resources alive during the same pass share any memory */
+        bool HasLiveOverlap(const std::vector<TransientResource>& resources, const TransientPlan& plan)
+        {
+            for (size_t a = 0; a < resources.size(); ++a)
+            {
+                for (size_t b = a + 1; b < resources.size(); ++b)
+                {
+                    bool alive = resources[a].firstPass <= resources[b].lastPass
+                        && resources[b].firstPass <= resources[a].lastPass;
+                    bool shared = plan.offsets[a] < plan.offsets[b] + resources[b].size
+                        && plan.offsets[b] < plan.offsets[a] + resources[a].size;
+                    if (alive && shared)
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+    }
+
+    LUMI_TEST(TransientPlanEmpty)
+    {
+        TransientPlan plan = PlanTransientResources({});
+        LUMI_CHECK(plan.offsets.empty());
+        LUMI_CHECK_EQ(plan.heapSize, 0u);
+        LUMI_CHECK_EQ(plan.unaliasedSize, 0u);
+        LUMI_CHECK_EQ(plan.peakLiveSize, 0u);
+    }
+
+    LUMI_TEST(TransientPlanOverlappingLifetimesKeptApart)
+    {
+        std::vector<TransientResource> resources = {
+            { 100, 1, 0, 2 },
+            { 200, 1, 1, 3 },
+            { 50, 1, 2, 2 },
+        };
+        TransientPlan plan = PlanTransientResources(resources);
+
+        LUMI_REQUIRE(plan.offsets.size() == resources.size());
+        LUMI_CHECK(!HasLiveOverlap(resources, plan));
+        // All three are alive in pass 2, nothing can be shared
+        LUMI_CHECK_EQ(plan.heapSize, 350u);
+        LUMI_CHECK_EQ(plan.unaliasedSize, 350u);
+        LUMI_CHECK_EQ(plan.peakLiveSize, 350u);
+    }
+
+    LUMI_TEST(TransientPlanDisjointLifetimesReuseMemory)
+    {
+        std::vector<TransientResource> resources = {
+            { 256, 1, 0, 1 },
+            { 256, 1, 2, 3 },
+            { 128, 1, 4, 4 },
+        };
+        TransientPlan plan = PlanTransientResources(resources);
+
+        LUMI_REQUIRE(plan.offsets.size() == resources.size());
+        LUMI_CHECK_EQ(plan.offsets[0], 0u);
+        LUMI_CHECK_EQ(plan.offsets[1], 0u);
+        LUMI_CHECK_EQ(plan.offsets[2], 0u);
+        LUMI_CHECK_EQ(plan.heapSize, 256u);
+        LUMI_CHECK_EQ(plan.unaliasedSize, 640u);
+        LUMI_CHECK_EQ(plan.peakLiveSize, 256u);
+    }
+
+    LUMI_TEST(TransientPlanFillsGapsBetweenLiveResources)
+    {
+        // The small resource fits in the memory the first big one freed while the second big one is still alive
+        std::vector<TransientResource> resources = {
+            { 400, 1, 0, 0 },
+            { 300, 1, 0, 2 },
+            { 100, 1, 1, 2 },
+        };
+        TransientPlan plan = PlanTransientResources(resources);
+
+        LUMI_REQUIRE(plan.offsets.size() == resources.size());
+        LUMI_CHECK(!HasLiveOverlap(resources, plan));
+        LUMI_CHECK_EQ(plan.offsets[2], 0u);
+        LUMI_CHECK_EQ(plan.heapSize, 700u);
+        LUMI_CHECK_EQ(plan.unaliasedSize, 800u);
+        LUMI_CHECK_EQ(plan.peakLiveSize, 700u);
+    }
+
+    LUMI_TEST(TransientPlanHonoursAlignment)
+    {
+        constexpr uint64_t kAlignment = 64 * 1024;
+        std::vector<TransientResource> resources = {
+            { 3 * kAlignment, kAlignment, 0, 1 },
+            { 100, kAlignment, 0, 1 },
+            { 100, 256, 1, 1 },
+            { 10, 0, 0, 1 },
+        };
+        TransientPlan plan = PlanTransientResources(resources);
+
+        LUMI_REQUIRE(plan.offsets.size() == resources.size());
+        LUMI_CHECK(!HasLiveOverlap(resources, plan));
+        for (size_t i = 0; i < resources.size(); ++i)
+        {
+            uint64_t alignment = resources[i].alignment > 0 ? resources[i].alignment : 1;
+            LUMI_CHECK_EQ(plan.offsets[i] % alignment, 0u);
+        }
+        // Each resource starts at the next offset its own alignment allows, the unaligned one fits in the gap that leaves
+        LUMI_CHECK_EQ(plan.offsets[1], 3 * kAlignment);
+        LUMI_CHECK_EQ(plan.offsets[2], 3 * kAlignment + 256);
+        LUMI_CHECK_EQ(plan.offsets[3], 3 * kAlignment + 100);
+        LUMI_CHECK_EQ(plan.heapSize, 3 * kAlignment + 356);
+    }
+
+    LUMI_TEST(TransientPlanPeakIsLowerBound)
+    {
+        // A mix where largest-first can't always hit the peak, the heap may be bigger but never smaller
+        std::vector<TransientResource> resources;
+        for (uint32_t i = 0; i < 32; ++i)
+        {
+            uint32_t first = (i * 7) % 10;
+            resources.push_back({ uint64_t(1 + (i * 37) % 11) * 1024, 1024, first, first + i % 4 });
+        }
+        TransientPlan plan = PlanTransientResources(resources);
+
+        LUMI_REQUIRE(plan.offsets.size() == resources.size());
+        LUMI_CHECK(!HasLiveOverlap(resources, plan));
+        LUMI_CHECK(plan.peakLiveSize <= plan.heapSize);
+        LUMI_CHECK(plan.heapSize <= plan.unaliasedSize);
+
+        uint64_t unaliased = 0;
+        for (const auto& resource : resources)
+        {
+            unaliased += resource.size;
+            LUMI_CHECK(plan.heapSize >= resource.size);
+        }
+        LUMI_CHECK_EQ(plan.unaliasedSize, unaliased);
+    }
+}
\ No newline at end of file